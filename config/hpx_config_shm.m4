@@ -0,0 +1,39 @@
+# -*- autoconf -*---------------------------------------------------------------
+# HPX_CONFIG_SHM
+#
+# Variables
+#  have_shm
+#  have_pwc_shm
+#
+# Appends
+#  HPX_APPS_LDADD
+#  HPX_PC_PRIVATE_LIBS
+#
+# Defines
+#  HAVE_SHM
+#  HAVE_PWC_SHM
+# ------------------------------------------------------------------------------
+AC_DEFUN([HPX_CONFIG_SHM], [
+ AC_ARG_ENABLE([shm],
+   [AS_HELP_STRING([--enable-shm], [Enable the single-node shared-memory network @<:@default=no@:>@])],
+   [], [enable_shm=no])
+
+ AS_IF([test "x$enable_shm" != xno],
+   [AC_SEARCH_LIBS([shm_open], [rt],
+     [AS_IF([test "x$ac_cv_search_shm_open" != "xnone required"],
+        [HPX_APPS_LDADD="$HPX_APPS_LDADD $ac_cv_search_shm_open"
+         HPX_PC_PRIVATE_LIBS="$HPX_PC_PRIVATE_LIBS $ac_cv_search_shm_open"])
+      AC_DEFINE([HAVE_SHM], [1], [We have the shared-memory network])
+      have_shm=yes],
+     [AC_MSG_ERROR([--enable-shm requires shm_open])])])
+
+ AC_ARG_ENABLE([pwc-shm],
+   [AS_HELP_STRING([--enable-pwc-shm], [Build the PWC network over an emulated shared-memory transport instead of Photon @<:@default=no@:>@])],
+   [], [enable_pwc_shm=no])
+
+ AS_IF([test "x$enable_pwc_shm" != xno],
+   [AS_IF([test "x$have_shm" != xyes],
+      [AC_MSG_ERROR([--enable-pwc-shm requires --enable-shm])])
+    AC_DEFINE([HAVE_PWC_SHM], [1], [The PWC network uses the shared-memory transport])
+    have_pwc_shm=yes])
+])
@@ -23,6 +23,7 @@ AC_DEFUN([HPX_DO_AC_CONFIG_FILES], [
    libhpx/network/Makefile
    libhpx/network/isir/Makefile
    libhpx/network/pwc/Makefile
+   libhpx/network/shm/Makefile
    libhpx/system/Makefile
    libhpx/system/linux/Makefile
    libhpx/system/darwin/Makefile
@@ -8,6 +8,8 @@ AC_DEFUN([HPX_DO_SUMMARY], [
  # Compute some friendly strings
  AS_IF([test "x$have_mpi" == xyes], [networks="MPI"])
  AS_IF([test "x$have_photon" == xyes], [networks="Photon $networks"])
+ AS_IF([test "x$have_shm" == xyes], [networks="SHM $networks"])
+ AS_IF([test "x$have_pwc_shm" == xyes], [networks="PWC-SHM $networks"])
  
  AS_IF([test "x$have_jemalloc" == xyes], [allocator="jemalloc"])
  AS_IF([test "x$have_tbbmalloc" == xyes], [allocator="tbbmalloc"])
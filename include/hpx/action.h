@@ -87,6 +87,8 @@ typedef enum {
 #define HPX_COALESCED 0x10
 // Action is a compressed action
 #define HPX_COMPRESSED 0x20
+// Action is scheduled ahead of normal work
+#define HPX_PRIORITY   0x40
 //@}
 
 /// Register an HPX action of a given @p type.
@@ -173,6 +173,9 @@ struct typecheck_action_args<Type, HPX_COALESCED, Alist>
 template <hpx_action_type_t Type, typename Alist>
 struct typecheck_action_args<Type, HPX_COMPRESSED, Alist>
     : typecheck_action_args<Type, HPX_ATTR_NONE, Alist> {};
+template <hpx_action_type_t Type, typename Alist>
+struct typecheck_action_args<Type, HPX_PRIORITY, Alist>
+    : typecheck_action_args<Type, HPX_ATTR_NONE, Alist> {};
 
 } // namespace detail
 } // namspace hpx
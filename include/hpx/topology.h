@@ -49,6 +49,30 @@ int hpx_get_num_ranks(void)
 int hpx_get_num_threads(void)
   HPX_PUBLIC;
 
+/// Limit the number of heavy-weight threads that run HPX threads.
+///
+/// The remaining threads are stopped, and the work in their queues is
+/// forwarded to the running threads. With --hpx-sched-elastic this is an upper
+/// bound on the number of threads that the runtime will run, otherwise it is
+/// the exact number. The limit is applied asynchronously and persists across
+/// run epochs.
+///
+/// @param            n The number of threads, clamped to
+///                     [1, hpx_get_num_threads()].
+///
+/// @returns            The limit that was set, or -1 if the runtime is not
+///                     fully active yet.
+int hpx_set_num_active_threads(int n)
+  HPX_PUBLIC;
+
+/// Get the number of heavy-weight threads that are currently running HPX
+/// threads.
+///
+/// @returns            The number of running system threads at the current
+///                     locality, or -1 if the runtime is not fully active yet.
+int hpx_get_num_active_threads(void)
+  HPX_PUBLIC;
+
 /// Check if HPX is inside of a run epoch.
 ///
 /// Useful to check if particular code is inside a hpx_run.
@@ -25,8 +25,8 @@
 
 namespace libhpx {
 
-class Network : public virtual StringOps, public CollectiveOps, public LCOOps,
-                public MemoryOps, public ParcelOps {
+class Network : public virtual StringOps, public CollectiveOps,
+                public virtual LCOOps, public MemoryOps, public ParcelOps {
  public:
   virtual ~Network();
 
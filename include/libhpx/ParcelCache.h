@@ -0,0 +1,121 @@
+// ==================================================================-*- C++ -*-
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifndef LIBHPX_PARCEL_CACHE_H
+#define LIBHPX_PARCEL_CACHE_H
+
+#include "libhpx/config.h"
+#include <atomic>
+#include <cstddef>
+
+namespace libhpx {
+namespace network {
+
+/// A per-worker, size-classed cache for parcel allocations.
+///
+/// Parcel allocation and deletion is on the critical path of every spawn, and
+/// the common case is a small parcel that is deleted by the worker that
+/// allocated it. The parcel cache reserves one contiguous region of registered
+/// memory and carves it into fixed-size chunks. Each chunk is owned by a single
+/// worker and holds blocks of a single cacheline-rounded size class.
+///
+/// Allocation and deletion by the owning worker are unsynchronized freelist
+/// operations. Blocks deleted by any other thread are pushed onto the owner's
+/// lock-free remote free list, which the owner reclaims in bulk when its local
+/// freelist for a size class runs dry.
+///
+/// The cache does not handle requests from non-worker threads, requests that
+/// are larger than the largest size class, or requests that arrive after the
+/// region has been exhausted. Allocate() returns nullptr for these and the
+/// caller should fall back to the registered allocator. Deallocate() can tell
+/// cached blocks from other blocks by their address.
+class ParcelCache {
+ public:
+  /// Reserve the cache region and initialize the per-worker caches.
+  ///
+  /// This must be called before the workers start, and is a no-op if the
+  /// configured cache size is 0.
+  ///
+  /// @param        cfg The runtime configuration.
+  static void Init(const config_t* cfg);
+
+  /// Release the cache region.
+  ///
+  /// This must be called before the network is deleted, because releasing the
+  /// region may reach the network's registration hooks. Blocks from the cache
+  /// that are deleted after this are dropped.
+  static void Fini();
+
+  /// Allocate a parcel-sized block from the current worker's cache.
+  ///
+  /// @param      bytes The number of bytes required.
+  ///
+  /// @returns          A cacheline-aligned block of at least @p bytes, or
+  ///                   nullptr if the request can't be satisfied from the
+  ///                   cache.
+  static void* Allocate(size_t bytes);
+
+  /// Return a block to its owner's cache.
+  ///
+  /// @param      block The block to free.
+  ///
+  /// @returns          true if @p block was allocated from the cache, false
+  ///                   otherwise.
+  static bool Deallocate(void* block);
+
+ private:
+  static constexpr int    N_CLASSES = 16;
+  static constexpr size_t CHUNK_BYTES = size_t(1) << 16;
+
+  /// The freelist node that overlays a free block.
+  struct Block {
+    Block* next;
+  };
+
+  /// The header that occupies the first cacheline of each chunk.
+  struct Chunk {
+    int owner;                                  //!< the owning worker
+    int sizeClass;                              //!< the chunk's size class
+  };
+
+  /// The per-worker cache.
+  struct Cache {
+    Block* free[N_CLASSES];                     //!< local freelists
+    alignas(HPX_CACHELINE_SIZE)
+    std::atomic<Block*> remote;                 //!< blocks freed remotely
+  };
+
+  static int SizeClass(size_t bytes) {
+    return (bytes + HPX_CACHELINE_SIZE - 1) / HPX_CACHELINE_SIZE - 1;
+  }
+
+  static Chunk* ChunkOf(void* block) {
+    auto offset = static_cast<char*>(block) - Base_;
+    return reinterpret_cast<Chunk*>(Base_ + (offset & ~(CHUNK_BYTES - 1)));
+  }
+
+  /// Refill a local freelist, first from the remote free list and then by
+  /// carving a new chunk out of the region.
+  static Block* Refill(Cache& cache, int owner, int sizeClass);
+
+  static char*                Base_;            //!< start of the region
+  static char*                 End_;            //!< end of the region
+  static std::atomic<char*>   Next_;            //!< the next unused chunk
+  static Cache*             Caches_;            //!< the per-worker caches
+  static int               NCaches_;            //!< the number of caches
+};
+
+} // namespace network
+} // namespace libhpx
+
+#endif // LIBHPX_PARCEL_CACHE_H
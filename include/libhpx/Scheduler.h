@@ -35,6 +35,14 @@ namespace libhpx {
 /// table, though all of the functionality that is required to make this work is
 /// not implemented.
 class Scheduler : public libhpx::util::Aligned<HPX_CACHELINE_SIZE> {
+  /// The elastic policy grows when there are more than this many queued
+  /// parcels per running worker.
+  static constexpr int ELASTIC_GROW_DEPTH = 4;
+
+  /// The elastic policy shrinks when more than this percentage of steals fail
+  /// and nothing is queued.
+  static constexpr int ELASTIC_SHRINK_PERCENT = 90;
+
  public:
   enum State {
     SHUTDOWN,
@@ -112,6 +120,40 @@ class Scheduler : public libhpx::util::Aligned<HPX_CACHELINE_SIZE> {
     nActive_ -= 1;
   }
 
+  /// Try to account for a worker that wants to park.
+  ///
+  /// The last running worker is never allowed to park, because parked workers
+  /// don't poll the network and nothing else would wake them when parcels
+  /// arrive. This doesn't apply when a dedicated progress thread polls the
+  /// network and delivers parcels through the workers' mailboxes.
+  ///
+  /// @returns          true if the worker may park, false otherwise.
+  bool addParked() {
+    int parked = nParked_.fetch_add(1, std::memory_order_seq_cst) + 1;
+    if (parked + pollers_ <= getNTarget()) {
+      return true;
+    }
+    nParked_ -= 1;
+    return false;
+  }
+
+  void subParked() {
+    nParked_ -= 1;
+  }
+
+  /// Wake parked workers to help with newly available work.
+  ///
+  /// This wakes up to the configured wake fan-out of parked workers, starting
+  /// with the worker after @p id. It is a single load when no workers are
+  /// parked.
+  ///
+  /// @param         id The id of the worker that produced the work.
+  void unpark(int id) {
+    if (nParked_.load(std::memory_order_acquire)) {
+      unparkSlow(id);
+    }
+  }
+
   int getCode() const {
     return code_.load(std::memory_order_relaxed);
   }
@@ -132,6 +174,29 @@ class Scheduler : public libhpx::util::Aligned<HPX_CACHELINE_SIZE> {
     return nWorkers_;
   }
 
+  /// Get the number of workers that should be running lightweight threads.
+  ///
+  /// Workers [0, getNTarget()) are running, the rest are stopped and will
+  /// forward any work that they receive to the running workers.
+  int getNTarget() const {
+    return nTarget_.load(std::memory_order_acquire);
+  }
+
+  /// Limit the number of workers that run lightweight threads.
+  ///
+  /// The limit is clamped to [1, getNWorkers()]. Without the elastic policy
+  /// exactly @p n workers run, otherwise it is an upper bound. The change is
+  /// applied asynchronously by the thread that is waiting in start().
+  ///
+  /// @param          n The maximum number of running workers.
+  ///
+  /// @returns          The limit that was set.
+  int setLimit(int n);
+
+  int getLimit() const {
+    return nLimit_.load(std::memory_order_relaxed);
+  }
+
   std::vector<libhpx::Worker*>& getWorkers() {
     return workers_;
   }
@@ -141,6 +206,16 @@ class Scheduler : public libhpx::util::Aligned<HPX_CACHELINE_SIZE> {
     return workers_[i];
   }
 
+  /// Spawn a parcel from a thread that is not a scheduler worker.
+  ///
+  /// Parcels with affinity go to their worker, the rest are distributed
+  /// round-robin over the running workers' mailboxes. This is used by threads
+  /// like the dedicated network progress thread that receive parcels but can't
+  /// run them.
+  ///
+  /// @param          p The parcel to spawn.
+  void spawn(hpx_parcel_t* p);
+
   static int SetOutputHandler(const void* value, size_t bytes);
   static int StopHandler();
   static int TerminateSPMDHandler();
@@ -170,15 +245,37 @@ class Scheduler : public libhpx::util::Aligned<HPX_CACHELINE_SIZE> {
   /// Exit a spmd epoch.
   void exitSPMD(size_t size, const void* out);
 
+  /// The out-of-line part of unpark().
+  void unparkSlow(int id);
+
+  /// Compute the number of running workers for the elastic policy.
+  ///
+  /// This samples the queue depth and steal statistics of the running
+  /// workers, and grows or shrinks the target by one worker at a time.
+  ///
+  /// @param      limit The current upper bound on the number of workers.
+  ///
+  /// @returns          The new target number of workers.
+  int elasticTarget(int limit);
+
+  /// Start or stop workers so that exactly @p n of them are running.
+  void resize(int n);
+
   std::mutex                      lock_;     //!< lock for running condition
   std::condition_variable      stopped_;     //!< the running condition
   std::atomic<State>             state_;     //!< the run state
   std::atomic<int>           nextTlsId_;     //!< lightweight thread ids
   std::atomic<int>                code_;     //!< the exit code
   std::atomic<int>             nActive_;     //!< active number of workers
+  std::atomic<int>             nParked_;     //!< parked number of workers
   std::atomic<unsigned>      spmdCount_;     //!< barrier count for spmd
   const int                   nWorkers_;     //!< total number of workers
-  int                          nTarget_;     //!< target number of workers
+  std::atomic<int>             nTarget_;     //!< target number of workers
+  std::atomic<int>              nLimit_;     //!< user limit on nTarget_
+  std::atomic<unsigned>         nextRR_;     //!< next worker for spawn()
+  const int                 wakeFanout_;     //!< parked workers to wake
+  const int                    pollers_;     //!< workers that stay awake
+  const bool                   elastic_;     //!< use the elastic policy
   int                            epoch_;     //!< current scheduler epoch
   int                             spmd_;     //!< 1 if the current epoch is spmd
   std::chrono::nanoseconds      nsWait_;     //!< nanoseconds to wait in start()
@@ -35,17 +35,22 @@
 #define libhpx_hwloc_get_nbobjs_by_type hwloc_get_nbobjs_by_type
 #define libhpx_hwloc_get_next_obj_by_type hwloc_get_next_obj_by_type
 #define libhpx_hwloc_get_ancestor_obj_by_type hwloc_get_ancestor_obj_by_type
+#define libhpx_hwloc_set_area_membind hwloc_set_area_membind
 #define LIBHPX_HWLOC_CPUBIND_THREAD HWLOC_CPUBIND_THREAD
 #define LIBHPX_HWLOC_OBJ_PU HWLOC_OBJ_PU
 #define LIBHPX_HWLOC_OBJ_CORE HWLOC_OBJ_CORE
 #define LIBHPX_HWLOC_OBJ_NUMANODE HWLOC_OBJ_NODE
 #define LIBHPX_HWLOC_CPUBIND_PROCESS HWLOC_CPUBIND_PROCESS
+#define LIBHPX_HWLOC_MEMBIND_BIND HWLOC_MEMBIND_BIND
+#define LIBHPX_HWLOC_MEMBIND_INTERLEAVE HWLOC_MEMBIND_INTERLEAVE
 #else
 #define LIBHPX_HWLOC_CPUBIND_THREAD LIBHPX_hwloc_CPUBIND_THREAD
 #define LIBHPX_HWLOC_OBJ_PU LIBHPX_hwloc_OBJ_PU
 #define LIBHPX_HWLOC_OBJ_CORE LIBHPX_hwloc_OBJ_CORE
 #define LIBHPX_HWLOC_OBJ_NUMANODE LIBHPX_hwloc_OBJ_NUMANODE
 #define LIBHPX_HWLOC_CPUBIND_PROCESS LIBHPX_hwloc_CPUBIND_PROCESS
+#define LIBHPX_HWLOC_MEMBIND_BIND LIBHPX_hwloc_MEMBIND_BIND
+#define LIBHPX_HWLOC_MEMBIND_INTERLEAVE LIBHPX_hwloc_MEMBIND_INTERLEAVE
 #endif
 
 // the number of bits for each part of the packed value
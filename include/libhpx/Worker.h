@@ -15,9 +15,10 @@
 #define LIBHPX_WORKER_H
 
 #include "libhpx/Network.h"
+#include "libhpx/parcel.h"
 #include "libhpx/util/Aligned.h"
 #include "libhpx/util/ChaseLevDeque.h"
-#include "libhpx/util/TwoLockQueue.h"
+#include "libhpx/util/MPSCStack.h"
 #include "hpx/hpx.h"
 #include <thread>
 #include <atomic>
@@ -42,7 +43,8 @@ class Thread;
 
 class Worker : public libhpx::util::Aligned<HPX_CACHELINE_SIZE>
 {
-  static constexpr int MAGIC_STEAL_HALF_THRESHOLD = 6;
+  static constexpr unsigned STEAL_BATCH_LIMIT = 32;
+  static constexpr int IDLE_BACKOFF_LOG_LIMIT = 6;
 
   enum State {
     SHUTDOWN,
@@ -53,7 +55,7 @@ class Worker : public libhpx::util::Aligned<HPX_CACHELINE_SIZE>
 
  public:
   using Continuation = std::function<void(hpx_parcel_t*)>;
-  using Mailbox = libhpx::util::TwoLockQueue<hpx_parcel_t*>;
+  using Mailbox = libhpx::util::MPSCStack<hpx_parcel_t*>;
   using Deque = libhpx::util::ChaseLevDeque<hpx_parcel_t*>;
 
   /// Event handlers.
@@ -158,10 +160,20 @@ class Worker : public libhpx::util::Aligned<HPX_CACHELINE_SIZE>
     return id_;
   }
 
+  int getNumaNode() const {
+    return numaNode_;
+  }
+
   hpx_parcel_t* getCurrentParcel() const {
     return current_;
   }
 
+  /// Check if the current thread is allowed to block.
+  ///
+  /// The system thread, stackless tasks, and interrupts don't have their own
+  /// stack to suspend, and a thread that holds an LCO lock must not suspend.
+  bool canBlock() const;
+
   /// Stop processing lightweight threads.
   ///
   /// This will cause the worker to drop into its sleep() loop the next time a
@@ -169,6 +181,7 @@ class Worker : public libhpx::util::Aligned<HPX_CACHELINE_SIZE>
   void stop() {
     std::lock_guard<std::mutex> _(lock_);
     state_ = STOP;
+    running_.notify_all();
   }
 
   /// Start processing lightweight threads.
@@ -187,8 +200,48 @@ class Worker : public libhpx::util::Aligned<HPX_CACHELINE_SIZE>
     running_.notify_all();
   }
 
+  /// Send mail to this worker.
+  ///
+  /// This is safe to call from any thread. The parcel @p p may be the head of
+  /// a chain of parcels linked through their next pointers.
+  ///
+  /// @param          p The parcel (or chain of parcels) to send.
   void pushMail(hpx_parcel_t* p) {
-    inbox_.enqueue(p);
+    inbox_.push(p);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    unpark();
+  }
+
+  /// Wake the worker if it is parked.
+  ///
+  /// This is cheap when the worker is not parked. Callers that publish work for
+  /// this worker must issue a seq_cst fence between publishing the work and
+  /// calling unpark() so that they can't miss a concurrent park() operation.
+  ///
+  /// @returns          true if the worker was parked, false otherwise.
+  bool unpark() {
+    if (!parked_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    std::lock_guard<std::mutex> _(lock_);
+    running_.notify_all();
+    return true;
+  }
+
+  /// Get the number of parcels waiting in this worker's queues.
+  ///
+  /// This is racy and is only used as a load estimate.
+  uint64_t getQueueDepth() const {
+    return queues_[workId_].size() + priority_.size();
+  }
+
+  /// Accumulate and reset this worker's steal statistics.
+  ///
+  /// @param[out] steals Incremented by the number of steal attempts.
+  /// @param[out] failed Incremented by the number of failed steal attempts.
+  void takeStealCounts(uint64_t& steals, uint64_t& failed) {
+    steals += steals_.exchange(0, std::memory_order_relaxed);
+    failed += failedSteals_.exchange(0, std::memory_order_relaxed);
   }
 
   void pushYield(hpx_parcel_t* p) {
@@ -211,13 +264,27 @@ class Worker : public libhpx::util::Aligned<HPX_CACHELINE_SIZE>
     schedule(f);
   }
 
-  /// Asynchronous entry point for the steal-half operation.
+  /// Get the worker that a parcel's target has affinity with.
   ///
-  /// @todo This is public because we register it with the LIBHPX_ACTION
-  ///       macro. We should increase its protection if possible.
+  /// This skips the affinity lookup entirely when no address has affinity,
+  /// and otherwise caches a positive result in the parcel so that a thread
+  /// that is resumed many times only performs the lookup once. A negative
+  /// result is not cached, so affinity that is set while a thread is running
+  /// is honored when it resumes.
   ///
-  /// @param        src The source of the steal request.
-  static int StealHalfHandler(Worker* src);
+  /// @param          p The parcel to check.
+  ///
+  /// @returns          The worker id, or -1 if the target has no affinity.
+  static int GetAffinity(hpx_parcel_t* p);
+
+  /// Send a parcel to a specific worker.
+  ///
+  /// This seeds the affinity that GetAffinity() caches, so the parcel is
+  /// delivered to @p worker without consulting the GAS.
+  ///
+  /// @param          p The parcel to direct.
+  /// @param     worker The worker id.
+  static void SetAffinity(hpx_parcel_t* p, int worker);
 
  private:
   /// This node structure is used to freelist threads.
@@ -257,22 +324,54 @@ class Worker : public libhpx::util::Aligned<HPX_CACHELINE_SIZE>
 
   hpx_parcel_t* handleSteal();
 
+  /// Handle an iteration of the schedule loop that didn't find any work.
+  ///
+  /// This spins with exponential backoff for up to the configured spin budget
+  /// and then parks the worker.
+  ///
+  /// @param      spins The number of consecutive idle iterations so far.
+  ///
+  /// @returns          The updated number of consecutive idle iterations.
+  int handleIdle(int spins);
+
+  /// Park the worker until it is woken or the park period expires.
+  ///
+  /// A parked worker is woken by pushMail(), by new local work being spawned on
+  /// another worker (see Scheduler::unpark()), and by state changes. The park
+  /// period bounds the time that an idle locality goes without polling the
+  /// network. One worker always stays awake to poll the network, so parcels
+  /// that arrive while the rest of the locality is parked are picked up
+  /// promptly and spread to the parked workers through pushLIFO().
+  void park();
+
   /// Pop the next available parcel from our lifo work queue.
   hpx_parcel_t* popLIFO();
 
+  /// Pop the next available parcel from our priority queue.
+  hpx_parcel_t* popPriority();
+
   /// Push a parcel into the lifo queue.
+  ///
+  /// Parcels for HPX_PRIORITY actions are pushed into the priority queue
+  /// instead.
   void pushLIFO(hpx_parcel_t *p);
 
+  /// Select the local queue that a parcel should be pushed into.
+  Deque& queueFor(const hpx_parcel_t* p);
+
   /// All of the steal functionality.
   ///
+  /// The policies take the number of running workers, @p n, which the caller
+  /// reads once because it can change concurrently.
+  ///
   /// @todo We should extract stealing policies into a policy class that is
   ///       initialized based on the runtime configuration.
   /// @{
   hpx_parcel_t* stealFrom(Worker* victim);
-  hpx_parcel_t* stealHalf();
-  hpx_parcel_t* stealRandom();
-  hpx_parcel_t* stealRandomNode();
-  hpx_parcel_t* stealHierarchical();
+  hpx_parcel_t* stealRandom(int n);
+  hpx_parcel_t* stealRandomNode(int n);
+  hpx_parcel_t* stealHierarchical(int n);
+  int randomVictim(int node, int n);
   /// @}
 
   /// The main entry point for the worker thread.
@@ -290,6 +389,12 @@ class Worker : public libhpx::util::Aligned<HPX_CACHELINE_SIZE>
   /// longer SCHED_STOP.
   void sleep();
 
+  /// Forward all of our queued work to the running workers.
+  ///
+  /// This is used when the worker has been stopped while the scheduler is
+  /// still running, so that the work doesn't get stranded.
+  void drain();
+
   /// Try to bind a stack to the parcel.
   ///
   /// This uses the worker's stack caching infrastructure to find a stack, or
@@ -376,6 +481,47 @@ class Worker : public libhpx::util::Aligned<HPX_CACHELINE_SIZE>
     transfer(p, f);
   }
 
+  /// Check to see if a parcel can be run without binding a stack.
+  ///
+  /// HPX_TASK actions are not permitted to block, so a task that hasn't already
+  /// been bound to a stack (e.g., by a work-first spawn) can run to completion
+  /// directly on the worker's system stack.
+  ///
+  /// @param          p The parcel to check.
+  ///
+  /// @returns          true if @p p can be run with executeTask().
+  static bool IsStackless(const hpx_parcel_t* p);
+
+  /// Run a parcel from the schedule loop.
+  ///
+  /// This runs stackless tasks inline with executeTask(), and transfers to
+  /// everything else. It must be called from the system stack.
+  ///
+  /// @param          p The parcel to run.
+  /// @param          f The checkpoint continuation for the transfer.
+  void dispatch(hpx_parcel_t* p, Continuation& f);
+
+  /// Transfer to a parcel from a lightweight thread.
+  ///
+  /// Stackless tasks need the system stack, so rather than binding a stack to
+  /// them we put them back at the top of the work queue and transfer to the
+  /// system thread, which will pick them up in its next pass through run().
+  ///
+  /// @param          p The parcel to transfer to.
+  /// @param          f The checkpoint continuation for the transfer.
+  void handoff(hpx_parcel_t* p, Continuation& f);
+
+  /// Run a task to completion on the system stack.
+  ///
+  /// This avoids the stack allocation, context switch, and stack cache
+  /// traffic associated with a lightweight thread. The task gets a Thread
+  /// header on the system stack so that continuation and tls operations work
+  /// as usual, but it does not have a stack of its own and any attempt to
+  /// block is an error.
+  ///
+  /// @param          p The task parcel to execute.
+  void executeTask(hpx_parcel_t* p);
+
   /// The main entry point for worker threads.
   ///
   /// Just used through the pthread interface during create to bounce to the
@@ -417,13 +563,18 @@ class Worker : public libhpx::util::Aligned<HPX_CACHELINE_SIZE>
  private:
   hpx_parcel_t            *system_;             //!< this worker's native parcel
   hpx_parcel_t           *current_;             //!< current thread
+  hpx_parcel_t              *task_;             //!< task on the system stack
   FreelistNode           *threads_;             //!< freelisted threads
   alignas(HPX_CACHELINE_SIZE)
   std::mutex                 lock_;             //!< state lock
   std::condition_variable running_;             //!< local condition for sleep
   std::atomic<State>        state_;             //!< what state are we in
   std::atomic<int>         workId_;             //!< which queue are we using
+  std::atomic<bool>        parked_;             //!< true while in park()
+  std::atomic<uint64_t>    steals_;             //!< steal attempts
+  std::atomic<uint64_t> failedSteals_;          //!< failed steal attempts
   Deque                    queues_[2];          //!< work and yield queues
+  Deque                  priority_;             //!< priority work queue
   Mailbox                   inbox_;             //!< mail sent to me
   std::thread              thread_;             //!< this worker's native thread
 
@@ -426,7 +426,8 @@ static const char* const HPX_ACTION_ATTR_TO_STRING[] = {
   "INTERNAL",
   "VECTORED",
   "COALESCED",
-  "COMPRESSED"
+  "COMPRESSED",
+  "PRIORITY"
 };
 
 static inline bool action_is_pinned(hpx_action_t id) {
@@ -465,6 +466,12 @@ static inline bool action_is_compressed(hpx_action_t id) {
   return (action->attr & HPX_COMPRESSED);
 }
 
+static inline bool action_is_priority(hpx_action_t id) {
+  CHECK_ACTION(id);
+  const action_t *action = &actions[id];
+  return (action->attr & HPX_PRIORITY);
+}
+
 static const char* const HPX_ACTION_TYPE_TO_STRING[] = {
   "DEFAULT",
   "TASK",
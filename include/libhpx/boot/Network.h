@@ -37,7 +37,7 @@ class Network {
   virtual void allgather(const void* src, void* dest, int n) const = 0;
   virtual void alltoall(void* dest, const void* src, int n, int stride) const = 0;
 
-  static Network* Create(libhpx_boot_t type);
+  static Network* Create(const config_t* cfg);
 
  protected:
   Network();
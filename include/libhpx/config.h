@@ -71,6 +71,7 @@ typedef enum {
   HPX_NETWORK_SMP,
   HPX_NETWORK_PWC,
   HPX_NETWORK_ISIR,
+  HPX_NETWORK_SHM,
   HPX_NETWORK_MAX
 } libhpx_network_t;
 
@@ -79,6 +80,7 @@ static const char * const HPX_NETWORK_TO_STRING[] = {
   "SMP",
   "PWC",
   "ISIR",
+  "SHM",
   "INVALID_ID"
 };
 
@@ -88,6 +90,7 @@ typedef enum {
   HPX_BOOT_SMP,              //!< Use the SMP bootstrapper.
   HPX_BOOT_MPI,              //!< Use mpirun to bootstrap HPX.
   HPX_BOOT_PMI,              //!< Use the PMI bootstrapper.
+  HPX_BOOT_FORK,             //!< Fork local processes to bootstrap HPX.
   HPX_BOOT_MAX
 } libhpx_boot_t;
 
@@ -96,6 +99,7 @@ static const char* const HPX_BOOT_TO_STRING[] = {
   "SMP",
   "MPI",
   "PMI",
+  "FORK",
   "INVALID_ID"
 };
 
@@ -240,6 +244,23 @@ static const char * const HPX_GAS_AFFINITY_TO_STRING[] = {
   "INVALID_ID"
 };
 
+//! Configuration options for the global heap NUMA placement policy
+typedef enum {
+  HPX_GAS_NUMA_NONE = 0,
+  HPX_GAS_NUMA_INTERLEAVE,
+  HPX_GAS_NUMA_LOCAL,
+  HPX_GAS_NUMA_BLOCK,
+  HPX_GAS_NUMA_MAX
+} libhpx_gas_numa_t;
+
+static const char * const HPX_GAS_NUMA_TO_STRING[] = {
+  "NONE",
+  "INTERLEAVE",
+  "LOCAL",
+  "BLOCK",
+  "INVALID_ID"
+};
+
 /// The HPX configuration type.
 ///
 /// This configuration is used to control some of the runtime
@@ -15,6 +15,7 @@
 #define LIBHPX_GAS_AFFINITY_H
 
 #include "hpx/hpx.h"
+#include <atomic>
 #include <cuckoohash_map.hh>
 #include <city_hasher.hh>
 
@@ -28,8 +29,21 @@ class Affinity {
   virtual void clearAffinity(hpx_addr_t gva) = 0;
   virtual int getAffinity(hpx_addr_t gva) const = 0;
 
+  /// Check to see if any address has affinity.
+  ///
+  /// This is a non-virtual negative check that lets the scheduler skip the
+  /// getAffinity() lookup in the common case where nothing has affinity.
+  bool hasAffinity() const {
+    return (count_.load(std::memory_order_acquire) != 0);
+  }
+
  protected:
+  Affinity() : count_(0) {
+  }
+
   virtual ~Affinity();
+
+  std::atomic<long> count_;                     //!< # of addresses with affinity
 };
 
 namespace affinity {
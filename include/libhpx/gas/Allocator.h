@@ -47,6 +47,18 @@ class Allocator {
 
   virtual hpx_addr_t calloc_user(size_t n, size_t bsize, uint32_t boundary,
                                  hpx_gas_dist_t dist, uint32_t attr) = 0;
+
+ protected:
+  /// Zero a range of newly allocated local memory for a calloc.
+  ///
+  /// Large ranges are split into page-aligned slices that are zeroed by all of
+  /// the running workers, each of which first-touches its own slice. This
+  /// waits for the slices to complete, so callers that can't block (tasks,
+  /// interrupts, and non-HPX threads) zero the range inline instead.
+  ///
+  /// @param        lva The base of the range.
+  /// @param      bytes The number of bytes to zero.
+  static void Zero(void* lva, size_t bytes);
 };
 }
 }
@@ -37,6 +37,7 @@ static const parcel_state_t        PARCEL_RETAINED = UINT16_C(0x1 << 2);
 static const parcel_state_t          PARCEL_NESTED = UINT16_C(0x1 << 3);
 static const parcel_state_t PARCEL_BLOCK_ALLOCATED = UINT16_C(0x1 << 4);
 static const parcel_state_t          PARCEL_PINNED = UINT16_C(0x1 << 5);
+static const parcel_state_t       PARCEL_COALESCED = UINT16_C(0x1 << 6);
 
 void parcel_pin(hpx_parcel_t *p);
 void parcel_nest(hpx_parcel_t *p);
@@ -63,6 +64,10 @@ static inline uint16_t parcel_pinned(parcel_state_t state) {
   return state & PARCEL_PINNED;
 }
 
+static inline uint16_t parcel_coalesced(parcel_state_t state) {
+  return state & PARCEL_COALESCED;
+}
+
 /// The hpx_parcel structure is what the user-level interacts with.
 ///
 struct hpx_parcel {
@@ -73,7 +78,7 @@ struct hpx_parcel {
   uint32_t            src;         //!< The src rank for the parcel.
   uint32_t           size;         //!< The data size in bytes.
   parcel_state_t    state;         //!< The parcel's state bits.
-  uint16_t         offset;         //!< Reserved for future use.
+  uint16_t       affinity;         //!< The cached affinity decision.
   hpx_action_t     action;         //!< The target action identifier.
   hpx_action_t   c_action;         //!< The continuation action identifier.
   hpx_addr_t       target;         //!< The target address for parcel_send().
@@ -175,6 +180,35 @@ static inline uint32_t parcel_size(const hpx_parcel_t *p) {
   return sizeof(*p) + p->size;
 }
 
+/// The size and alignment of the headers in a coalesced payload.
+///
+/// A coalesced payload starts with a header that the receiver uses as a
+/// reference count, followed by a record for each coalesced parcel. Each record
+/// is a header, which the receiver uses to point back at the enclosing parcel,
+/// followed by the serialized parcel and padded to the header alignment.
+static const uint32_t PARCEL_COALESCED_HEADER = 16;
+
+/// The number of bytes that a parcel uses in a coalesced payload.
+static inline uint32_t parcel_coalesced_size(const hpx_parcel_t *p) {
+  uint32_t n = PARCEL_COALESCED_HEADER + parcel_size(p);
+  return (n + PARCEL_COALESCED_HEADER - 1) & ~(PARCEL_COALESCED_HEADER - 1);
+}
+
+/// Copy a serialized parcel into a coalesced payload.
+///
+/// @param      payload The coalesced payload.
+/// @param       offset The offset of the parcel's record in the payload.
+/// @param            p The parcel to copy.
+void parcel_coalesce(void *payload, uint32_t offset, const hpx_parcel_t *p);
+
+/// Launch the parcels in a coalesced payload in place.
+///
+/// The coalesced parcels are nested in @p parent, which is reference counted
+/// and is only deleted once it and all of the coalesced parcels are deleted.
+///
+/// @param       parent The serialized parcel with the coalesced payload.
+void parcel_launch_coalesced(hpx_parcel_t *parent);
+
 static inline uint32_t parcel_payload_size(const hpx_parcel_t *p) {
   return p->size;
 }
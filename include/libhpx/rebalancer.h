@@ -30,12 +30,16 @@ void rebalancer_finalize(void);
 void rebalancer_add_entry(int src, int dst, hpx_addr_t block, size_t size);
 int rebalancer_start(hpx_addr_t async, hpx_addr_t psync, hpx_addr_t msync);
 
+// Get the localities that accessed a block in the last rebalancing epoch
+int rebalancer_get_accessors(hpx_addr_t block, uint32_t *ranks, int n);
+
 #else
 
 #define rebalancer_init()
 #define rebalancer_finalize()
 #define rebalancer_add_entry(...)
 #define rebalancer_start(...)
+#define rebalancer_get_accessors(...) 0
 
 #endif
 
@@ -31,6 +31,25 @@ const char *system_get_program_name(void);
 /// globally specified thread affinity @p policy.
 int system_set_worker_affinity(int id, libhpx_thread_affinity_t policy);
 
+/// Bind the calling thread to the hardware thread @p cpu.
+///
+/// This is used for the dedicated network progress thread. A negative @p cpu
+/// leaves the thread unbound.
+int system_set_progress_affinity(int cpu);
+
+/// Apply a NUMA placement @p policy to a range of the global heap.
+///
+/// This must be called before the pages in the range have been touched. The
+/// BLOCK policy places each chunk on a node determined by its @p offset in the
+/// heap, and the LOCAL policy places the range on the calling worker's node.
+///
+/// @param         addr The base of the range.
+/// @param        bytes The number of bytes in the range.
+/// @param       offset The heap offset that corresponds to @p addr.
+/// @param       policy The placement policy.
+int system_set_gas_membind(void *addr, size_t bytes, uint64_t offset,
+                           libhpx_gas_numa_t policy);
+
 /// Get the number of available cores we can run on.
 int system_get_available_cores(void);
 
@@ -29,6 +29,16 @@ namespace util {
 /// serially, along with a steal operation that may be called concurrently with
 /// either push or pop.
 ///
+/// The deque grows when it fills up and shrinks back to its initial capacity
+/// once it has drained several times in a row, or immediately if it has grown
+/// far beyond its initial capacity, so that a worker oscillating around a
+/// power of two doesn't reallocate on every burst. Buffers that are replaced
+/// are retired, and are reclaimed by the owner once it observes that no thief
+/// is in the middle of a steal operation. Thieves announce themselves with a
+/// counter on its own cacheline, so this only costs the thief an extra atomic
+/// increment and decrement when the deque is not empty, and doesn't slow down
+/// the CAS on top_.
+///
 /// http://dl.acm.org/citation.cfm?id=1073974
 template <typename T>
 class ChaseLevDeque;
@@ -44,13 +54,25 @@ class ChaseLevDeque<T*> : public Aligned<HPX_CACHELINE_SIZE>
   static constexpr auto RELEASE = std::memory_order_release;
   static constexpr auto SEQ_CST = std::memory_order_seq_cst;
 
+  /// The number of consecutive drains before a grown deque shrinks.
+  static constexpr unsigned SHRINK_DRAINS = 8;
+
+  /// A deque that is more than this many times its initial capacity shrinks
+  /// on the first drain.
+  static constexpr unsigned SHRINK_FACTOR = 4;
+
  public:
   ChaseLevDeque(unsigned capacity)
       : bottom_(1),
         topBound_(1),
         capacity_(ceil2(capacity)),
-        buffer_(new(capacity_) Buffer(nullptr, capacity_)),
-        top_(1) {
+        minCapacity_(capacity_),
+        drains_(0),
+        drainTop_(1),
+        buffer_(new(capacity_) Buffer(capacity_)),
+        retired_(nullptr),
+        top_(1),
+        stealers_(0) {
   }
 
   ChaseLevDeque() : ChaseLevDeque(32u) {
@@ -58,6 +80,10 @@ class ChaseLevDeque<T*> : public Aligned<HPX_CACHELINE_SIZE>
 
   ~ChaseLevDeque() {
     delete buffer_.load();
+    while (Buffer* buffer = retired_) {
+      retired_ = buffer->next;
+      delete buffer;
+    }
   }
 
   /// Get an approximate size for the deque.
@@ -78,6 +104,9 @@ class ChaseLevDeque<T*> : public Aligned<HPX_CACHELINE_SIZE>
     // if the queue was empty, then we overshot (canonicalize empty)
     if (bottom < topBound_) {
       bottom_.store(topBound_, RELEASE);
+      if (capacity_ != minCapacity_ || retired_) {
+        drained(topBound_);
+      }
       return nullptr;
     }
 
@@ -115,14 +144,60 @@ class ChaseLevDeque<T*> : public Aligned<HPX_CACHELINE_SIZE>
     // NB: it doesn't matter if the buffer grows a number of times between these
     //     two operations, because _buffer_get(top) will always return the same
     //     value---this is a result of the magic and beauty of this
-    //     algorithm. If we want to shrink the buffer then we'll have to pay
-    //     more attention.
-    T* value = buffer_.load(ACQUIRE)->get(top);
+    //     algorithm. The same is true when the buffer shrinks, because the
+    //     owner only shrinks an empty deque, but then we have to make sure
+    //     that the buffer we read isn't reclaimed out from under us.
+    stealers_.fetch_add(1, SEQ_CST);
+    T* value = buffer_.load(SEQ_CST)->get(top);
+    stealers_.fetch_sub(1, RELEASE);
 
     // if we update the top, return the stolen value, otherwise retry
     return (tryIncTop(top)) ? value : nullptr;
   }
 
+  /// Steal up to @p n items from the top of the deque.
+  ///
+  /// This claims the oldest items in the deque, in order, and stops early if
+  /// the deque appears to be empty or if it loses a race for top_.
+  ///
+  /// NB: The items are claimed with one CAS on top_ each rather than a single
+  ///     CAS for the whole range. pop() only synchronizes with thieves when it
+  ///     is taking the last item, so a thief that claimed a range based on a
+  ///     stale read of bottom_ could collide with an owner that has popped
+  ///     into that range in the meantime. Re-reading bottom_ before each claim
+  ///     closes that window. The thief owns the top_ cacheline after the first
+  ///     CAS, so the subsequent CASes are cheap when they aren't contended.
+  ///
+  /// @param        out An array of at least @p n elements to steal into.
+  /// @param          n The maximum number of items to steal.
+  ///
+  /// @returns          The number of items stolen into @p out.
+  unsigned stealBatch(T** out, unsigned n) {
+    auto top = top_.load(ACQUIRE);
+    if (bottom_.load(ACQUIRE) <= top) {
+      return 0;
+    }
+
+    stealers_.fetch_add(1, SEQ_CST);
+    unsigned i = 0;
+    for (; i < n; ++i) {
+      std::atomic_thread_fence(SEQ_CST);
+      if (bottom_.load(ACQUIRE) <= top) {
+        break;
+      }
+
+      // See steal() for why we read the value before the CAS.
+      T* value = buffer_.load(SEQ_CST)->get(top);
+      if (!top_.compare_exchange_strong(top, top + 1, RELEASE, RELAXED)) {
+        break;
+      }
+      out[i] = value;
+      ++top;
+    }
+    stealers_.fetch_sub(1, RELEASE);
+    return i;
+  }
+
   /// Push an item into the deque.
   size_t push(T* value) {
     // read bottom and buffer, using Chase-Lev 2.3 for top upper bound
@@ -134,7 +209,7 @@ class ChaseLevDeque<T*> : public Aligned<HPX_CACHELINE_SIZE>
     if (bottom - topBound_ >= capacity_) {
       topBound_ = top_.load(ACQUIRE);
       if (bottom - topBound_ >= capacity_) {
-        grow(bottom, topBound_);
+        resize(2 * capacity_, bottom, topBound_);
       }
     }
 
@@ -146,15 +221,10 @@ class ChaseLevDeque<T*> : public Aligned<HPX_CACHELINE_SIZE>
  private:
   class Buffer {
    public:
-    Buffer(Buffer* parent, unsigned capacity)
-        : parent_(parent), mask_(capacity - 1) {
+    Buffer(unsigned capacity) : next(nullptr), mask_(capacity - 1) {
       assert(ceil2(capacity) == capacity);
     }
 
-    ~Buffer() {
-      delete parent_;
-    }
-
     static void* operator new(size_t bytes, uint32_t capacity) {
       return new char[bytes + capacity * sizeof(T*)];
     }
@@ -171,20 +241,61 @@ class ChaseLevDeque<T*> : public Aligned<HPX_CACHELINE_SIZE>
       return buffer_[i & mask_];
     }
 
+    Buffer*          next;                  //!< the retired list link
+
    private:
-    Buffer* const parent_;
     const Index     mask_;
     T*            buffer_[];
   };
 
-  [[ gnu::noinline ]] void grow(const Index bottom, const Index top) {
-    capacity_ = capacity_ * 2;
+  /// Replace the buffer with one of a different capacity.
+  ///
+  /// The old buffer is retired rather than deleted because concurrent thieves
+  /// may still be reading it.
+  [[ gnu::noinline ]] void resize(unsigned capacity, const Index bottom,
+                                  const Index top) {
+    assert(bottom - top <= capacity);
+    if (capacity_ < capacity) {
+      drains_ = 0;
+    }
+    capacity_ = capacity;
     Buffer* old = buffer_.load(RELAXED);
-    Buffer* buffer = new(capacity_) Buffer(old, capacity_);
+    Buffer* buffer = new(capacity_) Buffer(capacity_);
     for (auto i = top, e = bottom; i < e; ++i) {
       buffer->set(i, old->get(i));
     }
-    buffer_.store(buffer, RELEASE);
+    buffer_.store(buffer, SEQ_CST);
+    old->next = retired_;
+    retired_ = old;
+  }
+
+  /// Called by pop() when it finds that the deque is empty.
+  ///
+  /// This shrinks the deque back to its initial capacity, subject to the
+  /// hysteresis described above, and tries to reclaim the retired buffers.
+  [[ gnu::noinline ]] void drained(const Index top) {
+    // Repeated pop()s from an idle owner see the same top, and only count as a
+    // single drain.
+    if (capacity_ != minCapacity_ && top != drainTop_) {
+      drainTop_ = top;
+      if (SHRINK_FACTOR * minCapacity_ < capacity_ ||
+          SHRINK_DRAINS <= ++drains_) {
+        resize(minCapacity_, top, top);
+        drains_ = 0;
+      }
+    }
+
+    // Any thief that loads the buffer after this point will see the current
+    // buffer, so if there are no thieves active now then no one can be
+    // reading the retired buffers.
+    if (stealers_.load(SEQ_CST) != 0) {
+      return;
+    }
+
+    while (Buffer* buffer = retired_) {
+      retired_ = buffer->next;
+      delete buffer;
+    }
   }
 
   bool tryIncTop(Index top) {
@@ -194,10 +305,17 @@ class ChaseLevDeque<T*> : public Aligned<HPX_CACHELINE_SIZE>
   std::atomic<Index>   bottom_;
   Index              topBound_;
   unsigned           capacity_;
+  const unsigned  minCapacity_;
+  unsigned             drains_;
+  Index              drainTop_;
   std::atomic<Buffer*> buffer_;
+  Buffer*             retired_;
 
   alignas(HPX_CACHELINE_SIZE)
   std::atomic<Index>      top_;
+
+  alignas(HPX_CACHELINE_SIZE)
+  std::atomic<unsigned> stealers_;
 };
 
 } // namespace util
@@ -0,0 +1,93 @@
+// ==================================================================-*- C++ -*-
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifndef LIBHPX_UTIL_MPSC_STACK_H
+#define LIBHPX_UTIL_MPSC_STACK_H
+
+#include "libhpx/util/Aligned.h"             // template Align
+#include "hpx/hpx.h"                         // HPX_CACHELINE_SIZE
+#include <atomic>
+
+namespace libhpx {
+namespace util {
+template <typename T>
+class MPSCStack;
+
+/// An intrusive, lock-free, multiple-producer single-consumer stack.
+///
+/// Elements are linked through their `next` pointer, so pushing doesn't
+/// allocate. Producers can push entire chains of elements with a single CAS,
+/// and the consumer takes everything that has been pushed with a single
+/// exchange. Because the consumer never removes individual elements the stack
+/// is not subject to the ABA problem.
+///
+/// Elements are not ordered across push operations, so this is only
+/// appropriate where the consumer doesn't care about ordering.
+template <typename T>
+class MPSCStack<T*> : public Aligned<HPX_CACHELINE_SIZE>
+{
+ public:
+  MPSCStack() : top_(nullptr) {
+  }
+
+  /// Push a chain of elements.
+  ///
+  /// @param       head The first element in a chain linked through next.
+  void push(T* head) {
+    T* tail = head;
+    while (tail->next) {
+      tail = tail->next;
+    }
+    push(head, tail);
+  }
+
+  /// Push a chain of elements when the tail is already known.
+  ///
+  /// @param       head The first element in the chain.
+  /// @param       tail The last element in the chain.
+  void push(T* head, T* tail) {
+    T* top = top_.load(std::memory_order_relaxed);
+    do {
+      tail->next = top;
+    } while (!top_.compare_exchange_weak(top, head, std::memory_order_release,
+                                         std::memory_order_relaxed));
+  }
+
+  /// Take all of the elements in the stack.
+  ///
+  /// This is only safe to call from the consumer.
+  ///
+  /// @returns          The chain of elements, or nullptr if the stack is empty.
+  T* popAll() {
+    if (!top_.load(std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return top_.exchange(nullptr, std::memory_order_acquire);
+  }
+
+  /// Check to see if the stack is empty.
+  ///
+  /// This is racy with respect to concurrent push operations and should only
+  /// be used as a hint.
+  bool empty() const {
+    return (top_.load(std::memory_order_acquire) == nullptr);
+  }
+
+ private:
+  std::atomic<T*> top_;
+};
+
+} // namespace util
+} // namespace libhpx
+
+#endif // LIBHPX_UTIL_MPSC_STACK_H
@@ -0,0 +1,186 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "Networks.h"
+#include "libhpx/debug.h"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+
+#ifndef MAP_ANONYMOUS
+# define MAP_ANONYMOUS MAP_ANON
+#endif
+
+namespace {
+using libhpx::boot::Fork;
+}
+
+Fork::Fork(int ranks)
+    : Network(),
+      shared_(nullptr),
+      pids_(nullptr),
+      bytes_(0),
+      sense_(0)
+{
+  nRanks_ = std::max(ranks, 1);
+  rank_ = 0;
+
+  // The scratch buffer follows the pid array, cacheline aligned.
+  size_t header = sizeof(Shared) + nRanks_ * sizeof(pid_t);
+  header = (header + HPX_CACHELINE_SIZE - 1) & ~(HPX_CACHELINE_SIZE - 1);
+  bytes_ = header + SCRATCH_BYTES;
+  void* base = mmap(nullptr, bytes_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (base == MAP_FAILED) {
+    throw log_error("could not map %zu bytes for the fork bootstrap (%d)\n",
+                    bytes_, errno);
+  }
+  shared_ = new(base) Shared();
+  shared_->count = 0;
+  shared_->sense = 0;
+  pids_ = reinterpret_cast<pid_t*>(shared_ + 1);
+  pids_[0] = getpid();
+
+  // Don't let the children replay output that we've buffered.
+  fflush(nullptr);
+
+  for (int i = 1; i < nRanks_; ++i) {
+    pid_t pid = fork();
+    if (pid < 0) {
+      log_error("could not fork locality %d (%d)\n", i, errno);
+      abort();
+    }
+
+    if (pid == 0) {
+      rank_ = i;
+#ifdef __linux__
+      // Don't outlive rank 0 if it dies without cleaning up.
+      prctl(PR_SET_PDEATHSIG, SIGKILL);
+#endif
+      break;
+    }
+
+    pids_[i] = pid;
+  }
+
+  pids_[rank_] = getpid();
+  barrier();
+}
+
+Fork::~Fork()
+{
+  if (rank_ == 0) {
+    for (int i = 1; i < nRanks_; ++i) {
+      int status;
+      if (waitpid(pids_[i], &status, 0) < 0) {
+        log_error("could not wait for locality %d (%d)\n", i, errno);
+      }
+      else if (!WIFEXITED(status) || WEXITSTATUS(status)) {
+        log_error("locality %d exited abnormally (%d)\n", i, status);
+      }
+    }
+  }
+  munmap(shared_, bytes_);
+}
+
+char*
+Fork::scratch() const
+{
+  return reinterpret_cast<char*>(shared_) + bytes_ - SCRATCH_BYTES;
+}
+
+void
+Fork::abort() const
+{
+  for (int i = 0; i < nRanks_; ++i) {
+    if (i != rank_ && pids_[i] > 0) {
+      kill(pids_[i], SIGKILL);
+    }
+  }
+  std::abort();
+  unreachable();
+}
+
+void
+Fork::barrier() const
+{
+  // A sense-reversing barrier, the last process to arrive resets the count
+  // and releases everyone else.
+  sense_ = 1 - sense_;
+  if (shared_->count.fetch_add(1, std::memory_order_acq_rel) + 1 == nRanks_) {
+    shared_->count.store(0, std::memory_order_relaxed);
+    shared_->sense.store(sense_, std::memory_order_release);
+    return;
+  }
+
+  while (shared_->sense.load(std::memory_order_acquire) != sense_) {
+    sched_yield();
+  }
+}
+
+void
+Fork::allgather(const void* src, void* dest, int n) const
+{
+  // Exchange as much of each contribution as fits in the scratch buffer in
+  // each round.
+  int chunk = int(SCRATCH_BYTES / nRanks_);
+  for (int offset = 0; offset < n; offset += chunk) {
+    int bytes = std::min(chunk, n - offset);
+    const char* from = static_cast<const char*>(src) + offset;
+    std::memcpy(scratch() + rank_ * chunk, from, bytes);
+    barrier();
+    for (int i = 0; i < nRanks_; ++i) {
+      char* to = static_cast<char*>(dest) + i * n + offset;
+      std::memcpy(to, scratch() + i * chunk, bytes);
+    }
+    barrier();
+  }
+}
+
+void
+Fork::alltoall(void* dest, const void* src, int n, int stride) const
+{
+  // Each rank takes a turn publishing the blocks that it is sending, and
+  // everyone copies out their own block.
+  int chunk = int(SCRATCH_BYTES / nRanks_);
+  for (int offset = 0; offset < n; offset += chunk) {
+    int bytes = std::min(chunk, n - offset);
+    for (int i = 0; i < nRanks_; ++i) {
+      if (i == rank_) {
+        for (int j = 0; j < nRanks_; ++j) {
+          const char* from = static_cast<const char*>(src) + j * stride;
+          std::memcpy(scratch() + j * chunk, from + offset, bytes);
+        }
+      }
+      barrier();
+      char* to = static_cast<char*>(dest) + i * stride + offset;
+      std::memcpy(to, scratch() + rank_ * chunk, bytes);
+      barrier();
+    }
+  }
+}
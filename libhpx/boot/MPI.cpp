@@ -22,7 +22,10 @@ namespace {
 using MPINetwork = libhpx::boot::MPI;
 }
 
-MPINetwork::MPI() : libhpx::boot::Network(), comm_(), finalizeMPI_(0)
+MPINetwork::MPI(int threadLevel)
+    : libhpx::boot::Network(),
+      comm_(),
+      finalizeMPI_(0)
 {
   int init;
   if (MPI_Initialized(&init)) {
@@ -31,15 +34,20 @@ MPINetwork::MPI() : libhpx::boot::Network(), comm_(), finalizeMPI_(0)
 
   if (!init) {
     int level = MPI_THREAD_SINGLE;
-    if (MPI_Init_thread(NULL, NULL, THREAD_LEVEL, &level)) {
+    if (MPI_Init_thread(NULL, NULL, threadLevel, &level)) {
       throw log_error("mpi initialization failed\n");
     }
 
     finalizeMPI_ = 1;
 
-    if (level != THREAD_LEVEL) {
+    if (level < MPI_THREAD_SERIALIZED) {
       throw log_error("MPI thread level failed requested %d, received %d.\n",
-                      THREAD_LEVEL, level);
+                      threadLevel, level);
+    }
+
+    if (level < threadLevel) {
+      log_boot("MPI thread level requested %d, received %d.\n", threadLevel,
+               level);
     }
   }
 
@@ -39,25 +39,35 @@ BootNetwork::abort() const
   unreachable();
 }
 
+#ifdef HAVE_MPI
+/// The threaded ISIR network needs MPI_THREAD_MULTIPLE, so we have to ask for
+/// it when we initialize MPI.
+static int
+_MPIThreadLevel(const config_t* cfg)
+{
+  return (cfg->isir_threaded) ? MPI_THREAD_MULTIPLE : MPI_THREAD_SERIALIZED;
+}
+#endif
+
 static BootNetwork*
-_Default()
+_Default(const config_t* cfg)
 {
 #ifdef HAVE_PMI
   return new libhpx::boot::PMI();
 #endif
 
 #ifdef HAVE_MPI
-  return new libhpx::boot::MPI();
+  return new libhpx::boot::MPI(_MPIThreadLevel(cfg));
 #endif
 
   return new SMP();
 }
 
 BootNetwork*
-BootNetwork::Create(libhpx_boot_t type)
+BootNetwork::Create(const config_t* cfg)
 {
   BootNetwork* boot = nullptr;
-  switch (type) {
+  switch (cfg->boot) {
    case (HPX_BOOT_PMI):
 #ifdef HAVE_PMI
     boot = new libhpx::boot::PMI();
@@ -69,7 +79,7 @@ BootNetwork::Create(libhpx_boot_t type)
 
    case (HPX_BOOT_MPI):
 #ifdef HAVE_MPI
-    boot = new libhpx::boot::MPI();
+    boot = new libhpx::boot::MPI(_MPIThreadLevel(cfg));
     log_boot("initialized mpirun bootstrapper.\n");
 #else
     dbg_error("MPI bootstrap not supported in current configuration.\n");
@@ -81,14 +91,19 @@ BootNetwork::Create(libhpx_boot_t type)
     log_boot("initialized the SMP bootstrapper.\n");
     break;
 
+   case (HPX_BOOT_FORK):
+    boot = new libhpx::boot::Fork(cfg->boot_ranks);
+    log_boot("initialized the fork bootstrapper.\n");
+    break;
+
    case HPX_BOOT_DEFAULT:
    default:
-    boot = _Default();
+    boot = _Default(cfg);
     break;
   }
 
   if (!boot) {
-    boot = _Default();
+    boot = _Default(cfg);
   }
 
   if (!boot) {
@@ -17,6 +17,9 @@
 #include "libhpx/boot/Network.h"
 #include "libhpx/config.h"
 
+#include <atomic>
+#include <sys/types.h>
+
 #ifdef HAVE_MPI
 #include <mpi.h>
 #endif
@@ -39,12 +42,50 @@ class SMP final : public Network {
   void alltoall(void * dest, const void * src, int n, int stride) const;
 };
 
+/// A bootstrapper that forks the requested number of local processes.
+///
+/// This allows multi-locality runs on a single node without a process
+/// launcher. The collectives are implemented with a barrier and a scratch
+/// buffer in a shared anonymous mapping that is inherited across the fork.
+class Fork final : public Network {
+  static constexpr size_t SCRATCH_BYTES = 1 << 16;
+
+ public:
+  Fork(int ranks);
+  ~Fork();
+
+  libhpx_boot_t type() const {
+    return HPX_BOOT_FORK;
+  }
+
+  [[ noreturn ]] void abort() const;
+  void barrier() const;
+  void allgather(const void* src, void* dest, int n) const;
+  void alltoall(void * dest, const void * src, int n, int stride) const;
+
+ private:
+  struct Shared {
+    std::atomic<int> count;                     //!< barrier arrivals
+    std::atomic<int> sense;                     //!< barrier phase
+  };
+
+  char* scratch() const;
+
+  Shared*    shared_;                           //!< the shared mapping
+  pid_t*       pids_;                           //!< the process for each rank
+  size_t      bytes_;                           //!< the size of the mapping
+  mutable int sense_;                           //!< our barrier phase
+};
+
 #ifdef HAVE_MPI
 class MPI final : public Network {
-  static constexpr int THREAD_LEVEL = MPI_THREAD_SERIALIZED;
-
  public:
-  MPI();
+  /// Initialize MPI, if necessary, and bootstrap from MPI_COMM_WORLD.
+  ///
+  /// @param      level The MPI thread level to request. We require at least
+  ///                   MPI_THREAD_SERIALIZED, and leave it to the network to
+  ///                   check for anything more.
+  explicit MPI(int level);
   ~MPI();
 
   libhpx_boot_t type() const {
@@ -16,8 +16,69 @@
 #endif
 
 #include "libhpx/gas/Allocator.h"
+#include "libhpx/action.h"
+#include "libhpx/locality.h"
+#include "libhpx/parcel.h"
+#include "libhpx/Scheduler.h"
+#include "libhpx/Worker.h"
+#include "libhpx/util/math.h"
+#include <cstring>
+
+namespace {
+using libhpx::Worker;
+using libhpx::gas::Allocator;
+using libhpx::util::ceil_div;
+
+/// Ranges smaller than this are zeroed by the calling thread.
+constexpr size_t PARALLEL_ZERO_BYTES = size_t(1) << 22;
+
+int ZeroSliceHandler(char* lva, size_t bytes) {
+  std::memset(lva, 0, bytes);
+  return HPX_SUCCESS;
+}
+LIBHPX_ACTION(HPX_DEFAULT, 0, ZeroSlice, ZeroSliceHandler, HPX_POINTER,
+              HPX_SIZE_T);
+}
 
 /// Provide a place for the compiler to put the affinity vtable.
 libhpx::gas::Allocator::~Allocator()
 {
 }
+
+void
+Allocator::Zero(void* lva, size_t bytes)
+{
+  // Zeroing in parallel waits for the slices, so callers that can't block
+  // zero inline.
+  int workers = (here->sched) ? here->sched->getNTarget() : 1;
+  Worker* w = self;
+  if (bytes < PARALLEL_ZERO_BYTES || workers < 2 || !w || !w->canBlock()) {
+    std::memset(lva, 0, bytes);
+    return;
+  }
+
+  // Slice boundaries fall on pages, so that each page is first touched by the
+  // worker that zeroes it.
+  char* base = static_cast<char*>(lva);
+  uintptr_t page = HPX_PAGE_SIZE;
+  size_t slice = ceil_div(ceil_div(bytes, size_t(workers)), page) * page;
+  int n = ceil_div(bytes, slice);
+  auto boundary = [=](int i) {
+    if (i == 0) return base;
+    if (i == n) return base + bytes;
+    uintptr_t b = reinterpret_cast<uintptr_t>(base + i * slice);
+    return reinterpret_cast<char*>(b & ~(page - 1));
+  };
+
+  hpx_addr_t done = hpx_lco_and_new(n);
+  for (int i = 0; i < n; ++i) {
+    char* start = boundary(i);
+    size_t len = boundary(i + 1) - start;
+    hpx_parcel_t* p = action_new_parcel(ZeroSlice, HPX_HERE, done,
+                                        hpx_lco_set_action, 2, &start, &len);
+    Worker::SetAffinity(p, i);
+    parcel_launch(p);
+  }
+  hpx_lco_wait(done);
+  hpx_lco_delete_sync(done);
+}
@@ -49,7 +49,9 @@ CuckooHash::setAffinity(hpx_addr_t gva, int worker)
   // @todo: Should we be pinning gva? The interface doesn't require it, but it
   //        could prevent usage errors in AGAS? On the other hand, it could
   //        result in debugging issues with pin reference counting.
-  map_.insert(gva, worker);
+  if (map_.insert(gva, worker)) {
+    count_.fetch_add(1, std::memory_order_release);
+  }
 }
 
 void
@@ -59,7 +61,9 @@ CuckooHash::clearAffinity(hpx_addr_t gva)
     dbg_error("Attempt to clear affinity of %" PRIu64 " at %d (owned by %d)\n",
               gva, here->rank, here->gas->ownerOf(gva));
   }
-  map_.erase(gva);
+  if (map_.erase(gva)) {
+    count_.fetch_sub(1, std::memory_order_release);
+  }
 }
 
 int
@@ -101,6 +101,9 @@ URCU::setAffinity(hpx_addr_t k, int v)
     synchronize_rcu();
     delete n;
   }
+  else {
+    count_.fetch_add(1, std::memory_order_release);
+  }
 }
 
 int
@@ -113,6 +116,7 @@ void
 URCU::clearAffinity(hpx_addr_t k)
 {
   if (Node *n = remove(Hash(k), k)) {
+    count_.fetch_sub(1, std::memory_order_release);
     synchronize_rcu();
     delete n;
   }
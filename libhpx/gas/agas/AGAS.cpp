@@ -50,27 +50,29 @@ LIBHPX_ACTION(HPX_DEFAULT, 0, InsertUserBlock, AGAS::InsertUserBlockHandler,
 LIBHPX_ACTION(HPX_DEFAULT, 0,
               InsertCyclicSegment, AGAS::InsertCyclicSegmentHandler, HPX_ADDR,
               HPX_SIZE_T, HPX_SIZE_T, HPX_UINT32, HPX_POINTER, HPX_INT);
-LIBHPX_ACTION(HPX_DEFAULT, 0, AllocateCyclic, AGAS::AllocateCyclicHandler,
-              HPX_SIZE_T, HPX_SIZE_T, HPX_UINT32, HPX_UINT32, HPX_INT);
 }
 
 __thread size_t AGAS::BlockSizePassthrough_;
+__thread const char* AGAS::FreshChunk_;
+__thread size_t AGAS::FreshBytes_;
 AGAS* AGAS::Instance_;
 
 AGAS::AGAS(const config_t* config, const boot::Network* const boot)
-    : btt_(0),
+    : btt_(config->threads),
       chunks_(0),
       global_(chunks_, HEAP_SIZE),
       cyclic_(nullptr),
       rank_(boot->getRank()),
-      ranks_(boot->getNRanks())
+      ranks_(boot->getNRanks()),
+      cyclicBits_(GVA_OFFSET_BITS - ceil_log2(ranks_))
 {
   dbg_assert(!Instance_);
   Instance_ = this;
 
-  if (rank_ == 0) {
-    cyclic_ = new ChunkAllocator(chunks_, HEAP_SIZE);
-  }
+  // Every rank allocates cyclic segments from its own partition of the cyclic
+  // offset space, so cyclic allocation doesn't have to go through rank 0.
+  uint64_t partition = uint64_t(1) << cyclicBits_;
+  cyclic_ = new ChunkAllocator(chunks_, partition, rank_ * partition);
 
   initAllocators(rank_);
   rebalancer_init();
@@ -144,6 +146,18 @@ AGAS::invalidateMapping(GVA dst, unsigned to)
     std::free(lva);
   }
 
+  // Tell the home and the localities that recently accessed the block about
+  // the new owner, so that they don't keep forwarding through us. These are
+  // batched, so a bulk move sends one update parcel to each locality.
+  std::unique_ptr<uint32_t[]> accessors(new uint32_t[ranks_ + 1]);
+  int n = rebalancer_get_accessors(src, accessors.get(), ranks_);
+  accessors[n++] = src.home;
+  for (int i = 0; i < n; ++i) {
+    if (accessors[i] != rank_ && accessors[i] != to) {
+      btt_.pushOwner(accessors[i], src, to);
+    }
+  }
+
   // @todo We could explicitly send a continuation parcel to avoid a
   //       malloc/memcpy/free here.
   size_t bytes = sizeof(UpsertBlockArgs) + bsize;
@@ -193,9 +207,9 @@ AGAS::free(hpx_addr_t addr, hpx_addr_t rsync) {
     hpx_lco_set(rsync, 0, NULL, HPX_NULL, HPX_NULL);
   }
   else if (gva.cyclic) {
-    // We can't return early here, because the FreeSegment operation at rank 0
-    // returns the entire allocation to the cyclic allocator, and it could be
-    // reused before the rest of the segments have been freed.
+    // We can't return early here, because the FreeSegment operation at the
+    // allocating rank returns the entire allocation to its cyclic allocator,
+    // and it could be reused before the rest of the segments have been freed.
     hpx_bcast_rsync(FreeSegment, &gva);
     hpx_lco_set(rsync, 0, NULL, HPX_NULL, HPX_NULL);
   }
@@ -251,7 +265,7 @@ AGAS::freeSegment(GVA gva)
   if (!gva.cyclic) {
     global_free(lva);
   }
-  else if (rank_) {
+  else if (rank_ != cyclicOwnerOf(gva)) {
     std::free(lva);
   }
   else {
@@ -296,7 +310,7 @@ AGAS::insertUserBlock(GVA gva, size_t blocks, size_t padded, uint32_t attr,
 
   // Zero the memory if necessary.
   if (zero) {
-    std::memset(lva, 0, padded);
+    Zero(lva, padded);
   }
 
   // Insert the translation
@@ -322,16 +336,16 @@ AGAS::insertCyclicSegment(GVA gva, size_t blocks, size_t padded, uint32_t attr,
   dbg_assert(padded);
   dbg_assert(lva);
 
+  // The allocating rank zeroes its segment before the broadcast, if necessary.
   size_t bytes = blocks * padded;
-  if (rank_ != 0) {
+  if (rank_ != cyclicOwnerOf(gva)) {
     size_t boundary = std::max(size_t(8u), padded);
     if (posix_memalign(&lva, boundary, bytes)) {
       dbg_error("Failed memalign\n");
     }
-  }
-
-  if (zero) {
-    std::memset(lva, 0, bytes);
+    if (zero) {
+      Zero(lva, bytes);
+    }
   }
 
   // Adjust the gva to point at the first block on this rank.
@@ -357,6 +371,7 @@ AGAS::allocateUser(size_t n, size_t bsize, uint32_t, hpx_gas_dist_t dist,
 
   // Out of band communication to the chunk allocator infrastructure.
   BlockSizePassthrough_ = padded;
+  FreshChunk_ = nullptr;
 
   // Allocate the blocks as a contiguous, aligned array from local memory.
   void *local = global_memalign(padded, n * padded);
@@ -364,6 +379,9 @@ AGAS::allocateUser(size_t n, size_t bsize, uint32_t, hpx_gas_dist_t dist,
     dbg_error("failed user-defined allocation\n");
   }
 
+  // Blocks that stay here don't need to be zeroed if they're fresh.
+  int zeroHere = zero && !IsFresh(local, n * padded);
+
   // Iterate through all of the blocks and insert them into the block
   // translation tables. We use an asynchronous interface here in order to mask
   // the difference between local blocks and global blocks.
@@ -373,8 +391,8 @@ AGAS::allocateUser(size_t n, size_t bsize, uint32_t, hpx_gas_dist_t dist,
     hpx_addr_t where = (i == 0) ? HPX_HERE : dist(i, n, bsize);
     GVA addr = gva.add(i * padded, padded);
     const void* lva = static_cast<char*>(local) + i * padded;
-    hpx_call(where, InsertUserBlock, done, &addr, &n, &padded, &attr, &lva,
-             &zero);
+    const int* z = (where == HPX_HERE) ? &zeroHere : &zero;
+    hpx_call(where, InsertUserBlock, done, &addr, &n, &padded, &attr, &lva, z);
   }
   hpx_lco_wait(done);
   hpx_lco_delete(done, HPX_NULL);
@@ -394,14 +412,15 @@ AGAS::allocateLocal(size_t n, size_t bsize, uint32_t boundary, uint32_t attr,
 
   // Out of band communication to the chunk allocator infrastructure.
   BlockSizePassthrough_ = aligned;
+  FreshChunk_ = nullptr;
 
   void *lva = global_memalign(aligned, n * padded);
   if (!lva) {
     return HPX_NULL;
   }
 
-  if (zero) {
-    std::memset(lva, 0, n * padded);
+  if (zero && !IsFresh(lva, n * padded)) {
+    Zero(lva, n * padded);
   }
 
   GVA gva = lvaToGVA(lva, padded);
@@ -417,7 +436,6 @@ AGAS::allocateLocal(size_t n, size_t bsize, uint32_t boundary, uint32_t attr,
 GlobalVirtualAddress
 AGAS::allocateCyclic(size_t n, size_t bsize, uint32_t, uint32_t attr, int zero)
 {
-  dbg_assert(rank_ == 0);
   dbg_assert(bsize <= maxBlockSize());
 
   // Figure out how many blocks per node we need, and what the size is.
@@ -427,17 +445,26 @@ AGAS::allocateCyclic(size_t n, size_t bsize, uint32_t, uint32_t attr, int zero)
 
   // Transmit the padded block size through to the chunk allocator.
   BlockSizePassthrough_ = padded;
+  FreshChunk_ = nullptr;
 
-  // Allocate the blocks as a contiguous, aligned array from cyclic memory. This
-  // only happens at rank 0, where the cyclic_memalign is functional. We use
-  // this segment to define the GVA of the allocation, and then broadcast a
-  // request for the entire system to allocate their own segment.
+  // Allocate the blocks as a contiguous, aligned array from cyclic memory. The
+  // cyclic allocator at each rank manages a disjoint partition of the offset
+  // space, so we can use this segment to define the GVA of the allocation
+  // without coordinating with the other ranks, and then broadcast a request for
+  // the entire system to allocate their own segment.
   void *lva = cyclic_memalign(padded, blocks * padded);
   if (!lva) {
     dbg_error("failed cyclic allocation\n");
   }
 
+  if (zero && !IsFresh(lva, blocks * padded)) {
+    Zero(lva, blocks * padded);
+  }
+
+  // Cyclic allocations always start at rank 0, regardless of which rank
+  // allocated them.
   GVA gva = lvaToGVA(lva, padded);
+  gva.home = 0;
   gva.cyclic = 1;
   if (hpx_bcast_rsync(InsertCyclicSegment, &gva, &blocks, &padded, &attr, &lva,
                       &zero)) {
@@ -448,24 +475,12 @@ AGAS::allocateCyclic(size_t n, size_t bsize, uint32_t, uint32_t attr, int zero)
 
 hpx_addr_t
 AGAS::alloc_cyclic(size_t n, size_t bsize, uint32_t boundary, uint32_t attr) {
-  int zero = 0;
-  GVA gva;
-  if (hpx_call_sync(HPX_THERE(0), AllocateCyclic, &gva, sizeof(gva), &n, &bsize,
-                    &boundary, &attr, &zero)) {
-    dbg_error("Failed to allocate.\n");
-  }
-  return gva;
+  return allocateCyclic(n, bsize, boundary, attr, 0);
 }
 
 hpx_addr_t
 AGAS::calloc_cyclic(size_t n, size_t bsize, uint32_t boundary, uint32_t attr) {
-  int zero = 1;
-  GVA gva;
-  if (hpx_call_sync(HPX_THERE(0), AllocateCyclic, &gva, sizeof(gva), &n, &bsize,
-                    &boundary, &attr, &zero)) {
-    dbg_error("Failed to allocate.\n");
-  }
-  return gva;
+  return allocateCyclic(n, bsize, boundary, attr, 1);
 }
 
 void
@@ -608,13 +623,12 @@ AGAS::memcpy(hpx_addr_t to, hpx_addr_t from, size_t size)
 void*
 AGAS::chunkAllocate(void* addr, size_t n, size_t align, bool cyclic)
 {
-  if (cyclic) {
-    dbg_assert(cyclic_);
-    return cyclic_->allocate(addr, n, align, BlockSizePassthrough_);
-  }
-  else {
-    return global_.allocate(addr, n, align, BlockSizePassthrough_);
-  }
+  ChunkAllocator* chunks = (cyclic) ? cyclic_ : &global_;
+  dbg_assert(chunks);
+  void* chunk = chunks->allocate(addr, n, align, BlockSizePassthrough_);
+  FreshChunk_ = static_cast<const char*>(chunk);
+  FreshBytes_ = n;
+  return chunk;
 }
 
 void
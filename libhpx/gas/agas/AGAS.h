@@ -145,6 +145,11 @@ class AGAS : public GAS {
     btt_.updateOwner(gva, owner);
   }
 
+  /// Send the pending owner updates for a rank.
+  void flushOwners(uint32_t rank) {
+    btt_.flushOwners(rank);
+  }
+
   /// Allocate a chunk from the appropriate chunk allocator.
   ///
   /// This uses the BlockSizePassthrough variable internally.
@@ -222,13 +227,6 @@ class AGAS : public GAS {
     return HPX_SUCCESS;
   }
 
-  static int AllocateCyclicHandler(size_t blocks, size_t bsize,
-                                   uint32_t boundary, uint32_t attr, int zero)
-  {
-    GVA gva = Instance()->allocateCyclic(blocks, bsize, boundary, attr, zero);
-    return HPX_THREAD_CONTINUE(gva);
-  }
-
  private:
   /// We leverage the user distribution to implement the blocked distribution.
   static hpx_addr_t Blocked(uint32_t i, size_t n, size_t bsize) {
@@ -268,6 +266,14 @@ class AGAS : public GAS {
   /// Convert a local virtual address to a global virtual address.
   GVA lvaToGVA(const void* lva, size_t bsize) const;
 
+  /// Find the rank that allocated a cyclic address.
+  ///
+  /// Each rank allocates cyclic segments from its own partition of the offset
+  /// space, so the allocating rank can be recovered from the offset.
+  unsigned cyclicOwnerOf(GVA gva) const {
+    return unsigned(gva.offset >> cyclicBits_);
+  }
+
   /// Insert a block into the translation table for a user distribution.
   ///
   /// This will possibly create a new allocation if the block is not being
@@ -287,13 +293,15 @@ class AGAS : public GAS {
   /// Insert a segment into the translation table.
   ///
   /// This will possibly create a new segment and insert it into the local
-  /// translation table. For rank 0 it will just insert the lva as passed here.
+  /// translation table. For the rank that allocated the segment it will just
+  /// insert the lva as passed here.
   ///
   /// @param        gva The base global virtual address of the allocation.
   /// @param     blocks The number of blocks in the segment.
   /// @param     padded The padded block size.
   /// @param       attr The attributes for the segment.
-  /// @param        lva The local virtual address of the segment for rank 0.
+  /// @param        lva The local virtual address of the segment at the
+  ///                   allocating rank.
   /// @param       zero True if we should zero the segment.
   void insertCyclicSegment(GVA gva, size_t blocks, size_t padded, uint32_t attr,
                            void* lva, int zero);
@@ -319,12 +327,27 @@ class AGAS : public GAS {
   /// alignment, however the callback interface used by jemalloc can't help us.
   static __thread size_t BlockSizePassthrough_;
 
+  /// These thread locals record the last chunk that the chunk allocators
+  /// mapped for this thread. Chunks come straight from system_mmap() so they
+  /// are already zero, and allocations that are satisfied from a fresh chunk
+  /// can skip zeroing.
+  static __thread const char* FreshChunk_;
+  static __thread size_t FreshBytes_;
+
+  /// Check if an allocation lies in the last chunk mapped for this thread.
+  static bool IsFresh(const void* lva, size_t bytes) {
+    const char* p = static_cast<const char*>(lva);
+    return (FreshChunk_ && FreshChunk_ <= p &&
+            p + bytes <= FreshChunk_ + FreshBytes_);
+  }
+
   BlockTranslationTable btt_;                   //!< maps gva to lva
   ChunkTable         chunks_;                   //!< maps from chunk to gva
   ChunkAllocator     global_;                   //!< allocates global chunks
   ChunkAllocator    *cyclic_;                   //!< allocates cyclic chunks
   const unsigned       rank_;                   //!< current rank
   const unsigned      ranks_;                   //!< total number of ranks
+  const unsigned cyclicBits_;                   //!< log2 cyclic partition size
 };
 } // namespace agas
 } // namespace gas
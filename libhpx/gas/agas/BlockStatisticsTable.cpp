@@ -32,7 +32,8 @@ using HierarchicalBST = libhpx::gas::agas::HierarchicalBST;
 
 BST::BlockStatisticsTable()
     : rank_(here->rank),
-      map_()
+      map_(),
+      accessors_()
 {
 }
 
@@ -130,10 +131,14 @@ BST::toBuffer(unsigned char* output)
       uint64_t total_vwgt  = 0;
       uint64_t total_vsize = 0;
       int prev_nbrs = nbrs;
+      std::vector<uint32_t> accessors;
       for (unsigned k = 0; k < ranks; ++k) {
         uint64_t count = entry.counts[k];
         uint64_t size = entry.sizes[k];
         if (count != 0) {
+          if (k != rank_) {
+            accessors.push_back(k);
+          }
           lnbrs[k].push_back(id);
           adjncy[nbrs++] = k;
           adjwgt.push_back(count * size);
@@ -142,6 +147,10 @@ BST::toBuffer(unsigned char* output)
         }
       }
 
+      if (!accessors.empty()) {
+        accessors_.insert(item.first, std::move(accessors));
+      }
+
       vtxs[id]   = item.first;
       vwgt[id]   = total_vwgt;
       vsizes[id] = total_vsize;
@@ -168,6 +177,9 @@ BST::toBuffer(unsigned char* output)
 hpx_parcel_t*
 BST::toParcel()
 {
+  // Accessors that weren't used by the last rebalance are stale now.
+  accessors_.clear();
+
   auto lt = map_.lock_table();
   size_t max_bytes = serializeMaxBytes();
   hpx_parcel_t* p = hpx_parcel_acquire(NULL, max_bytes);
@@ -177,6 +189,22 @@ BST::toParcel()
   return p;
 }
 
+int
+BST::takeAccessors(GVA gva, uint32_t* ranks, int n)
+{
+  std::vector<uint32_t> accessors;
+  if (!accessors_.find(gva, accessors)) {
+    return 0;
+  }
+  accessors_.erase(gva);
+
+  int i = 0;
+  for (int e = std::min(n, int(accessors.size())); i < e; ++i) {
+    ranks[i] = accessors[i];
+  }
+  return i;
+}
+
 HierarchicalBST::HierarchicalBST()
 {
   const int n = here->config->threads;
@@ -23,6 +23,7 @@
 #include <city_hasher.hh>
 #include <cinttypes>
 #include <unordered_map>
+#include <vector>
 #include "rebalancer.h"
 
 namespace libhpx {
@@ -80,6 +81,10 @@ class BlockStatisticsTable
   // format from the global BST, and serializes it into a parcel.
   virtual hpx_parcel_t* toParcel();
 
+  // Take the localities that accessed a block before the last
+  // serialization, returning at most @p n of them in @p ranks.
+  int takeAccessors(GVA gva, uint32_t* ranks, int n);
+
  protected:
   // Maximum bytes required for the serialized parcel.
   size_t serializeMaxBytes() const;
@@ -91,9 +96,11 @@ class BlockStatisticsTable
 
  private:
   using Map = cuckoohash_map<GVA, Entry, CityHasher<GVA>>;
+  using Accessors = cuckoohash_map<GVA, std::vector<uint32_t>, CityHasher<GVA>>;
 
   const unsigned rank_;                         //!< cache the local rank
   Map map_;                                     //!< the hashtable
+  Accessors accessors_;                         //!< the last epoch's accessors
 };
 
 // A hierarchical BST.
@@ -20,19 +20,35 @@
 #include "libhpx/action.h"
 #include "libhpx/debug.h"
 #include "libhpx/Worker.h"
+#include <cinttypes>
+#include <sched.h>
 
 namespace {
 using libhpx::self;
 using GVA = libhpx::gas::agas::GlobalVirtualAddress;
 using BTT = libhpx::gas::agas::BlockTranslationTable;
-LIBHPX_ACTION(HPX_DEFAULT, 0, UpdateOwner, BTT::UpdateOwnerHandler, HPX_ADDR,
-              HPX_UINT32);
+LIBHPX_ACTION(HPX_DEFAULT, HPX_MARSHALLED, UpdateOwners,
+              BTT::UpdateOwnersHandler, HPX_POINTER, HPX_SIZE_T);
+LIBHPX_ACTION(HPX_DEFAULT, 0, FlushOwners, BTT::FlushOwnersHandler, HPX_UINT32);
+
+/// The number of owner updates that we batch before sending.
+constexpr size_t OWNER_BATCH_SIZE = 256;
+
+/// The number of translations that each worker caches.
+constexpr size_t CACHE_SLOTS = 4096;
 }
 
-BTT::BlockTranslationTable(size_t size)
+BTT::BlockTranslationTable(size_t threads)
     : rank_(here->rank),
-      map_()
+      map_(),
+      caches_()
 {
+  for (size_t i = 0; i < threads + 1; ++i) {
+    caches_.emplace_back(new Cache());
+  }
+  for (unsigned i = 0; i < here->ranks; ++i) {
+    owners_.emplace_back(new OwnerBatch());
+  }
 }
 
 BTT::~BlockTranslationTable()
@@ -40,14 +56,74 @@ BTT::~BlockTranslationTable()
 }
 
 int
-BTT::UpdateOwnerHandler(hpx_addr_t addr, uint32_t owner)
+BTT::UpdateOwnersHandler(const void* records, size_t bytes)
+{
+  assert(here->gas->type() == HPX_GAS_AGAS);
+  AGAS *agas = static_cast<AGAS*>(here->gas);
+  auto r = static_cast<const OwnerRecord*>(records);
+  for (size_t i = 0, e = bytes / sizeof(*r); i < e; ++i) {
+    // We're authoritative for the blocks that we own, and updates can race
+    // with moves, so we only install translations for other owners.
+    if (r[i].owner != here->rank && agas->ownerOf(r[i].addr) != here->rank) {
+      agas->updateOwner(GlobalVirtualAddress(r[i].addr), r[i].owner);
+    }
+  }
+  log_gas("installed %zu owner updates\n", bytes / sizeof(*r));
+  return HPX_SUCCESS;
+}
+
+int
+BTT::FlushOwnersHandler(uint32_t rank)
 {
   assert(here->gas->type() == HPX_GAS_AGAS);
   AGAS *agas = static_cast<AGAS*>(here->gas);
-  agas->updateOwner(GlobalVirtualAddress(addr), owner);
+  agas->flushOwners(rank);
   return HPX_SUCCESS;
 }
 
+void
+BTT::pushOwner(uint32_t rank, GVA gva, uint32_t owner)
+{
+  dbg_assert(rank != rank_);
+  OwnerBatch& batch = *owners_[rank];
+  size_t n = 0;
+  {
+    std::lock_guard<std::mutex> _(batch.lock);
+    batch.owners[gva.getAddr()] = owner;
+    n = batch.owners.size();
+  }
+
+  if (n == 1) {
+    hpx_call(HPX_HERE, FlushOwners, HPX_NULL, &rank);
+  }
+  else if (OWNER_BATCH_SIZE <= n) {
+    flushOwners(rank);
+  }
+}
+
+void
+BTT::flushOwners(uint32_t rank)
+{
+  std::vector<OwnerRecord> records;
+  {
+    OwnerBatch& batch = *owners_[rank];
+    std::lock_guard<std::mutex> _(batch.lock);
+    records.reserve(batch.owners.size());
+    for (auto& i : batch.owners) {
+      records.push_back(OwnerRecord{i.first, i.second});
+    }
+    batch.owners.clear();
+  }
+
+  if (records.empty()) {
+    return;
+  }
+
+  size_t bytes = records.size() * sizeof(OwnerRecord);
+  hpx_call(HPX_THERE(rank), UpdateOwners, HPX_NULL, records.data(), bytes);
+  log_gas("sent %zu owner updates to %u\n", records.size(), rank);
+}
+
 void
 BTT::insert(GVA gva, uint32_t owner, void *lva, size_t blocks, uint32_t attr)
 {
@@ -79,21 +155,81 @@ BTT::updateOwner(GlobalVirtualAddress gva, uint32_t owner) {
   map_.upsert(gva, fn, Entry(owner, NULL, 1, HPX_GAS_ATTR_NONE));
 }
 
+BTT::Cache&
+BTT::cache() const
+{
+  unsigned i = (self) ? self->getId() : caches_.size() - 1;
+  return *caches_[i];
+}
+
+BTT::Slot&
+BTT::getSlot(Cache& cache, GVA gva)
+{
+  uint64_t key = gva.toKey();
+  auto i = cache.slots.find(key);
+  if (i != cache.slots.end()) {
+    return i->second;
+  }
+
+  // Make room by folding some other slot's count into the table. The entry
+  // stays marked as cached, so a later drain still sweeps the other caches,
+  // and the sum of its counts is unchanged.
+  if (CACHE_SLOTS <= cache.slots.size()) {
+    auto victim = cache.slots.begin();
+    uint64_t evicted = victim->first;
+    int32_t count = victim->second.count;
+    cache.slots.erase(victim);
+    if (count) {
+      auto add = [&](Entry& entry) {
+        entry.count += count;
+      };
+      map_.update_fn(GVA(evicted), add);
+    }
+    log_gas("evicted %" PRIu64 " (%d)\n", evicted, count);
+  }
+
+  Slot& slot = cache.slots[key];
+  slot.lva = nullptr;
+  slot.count = 0;
+  return slot;
+}
+
 bool
 BTT::tryPin(GVA gva, void **lva) {
-  unsigned owner = 0;
+  uint64_t key = gva.toKey();
+  Cache& cache = this->cache();
+  std::unique_lock<std::mutex> lock(cache.lock);
+
+  // The common case is a block that this worker has already translated.
+  auto i = cache.slots.find(key);
+  if (i != cache.slots.end() && i->second.lva) {
+    Slot& slot = i->second;
+    slot.count++;
+    log_gas("pinned %zu (cached %d)\n", gva.getAddr(), slot.count);
+    if (lva) {
+      *lva = static_cast<char*>(slot.lva) + gva.toBlockOffset();
+    }
+    return true;
+  }
 
   // The fn lambda runs while holding the proper locks on the hash table that
-  // will provide atomic access to its fields. We increment the count and grab
-  // the lva whil we're in there.
+  // will provide atomic access to its fields. We grab the lva while we're in
+  // there, and either count the pin in the table if the block is draining, or
+  // mark it so that a drain will look for it in the caches.
+  unsigned owner = 0;
+  void *base = nullptr;
+  bool cacheable = false;
   auto fn = [&](Entry& entry) {
     owner = entry.owner;
     if (owner == rank_) {
-      assert(entry.count >= 0);
-      entry.count++;
-      log_gas("pinned %zu (%d)\n", gva.getAddr(), entry.count);
-      if (lva) {
-        *lva = (char*)(entry.lva) + gva.toBlockOffset();
+      base = entry.lva;
+      if (entry.draining) {
+        entry.count++;
+        log_gas("pinned %zu (%d)\n", gva.getAddr(), entry.count);
+      }
+      else {
+        entry.cached = true;
+        cacheable = true;
       }
     }
   };
@@ -106,16 +242,25 @@ BTT::tryPin(GVA gva, void **lva) {
 
   // if I have an entry and was the owner then I pinned it
   if (owner == rank_) {
+    if (cacheable) {
+      Slot& slot = getSlot(cache, gva);
+      slot.lva = base;
+      slot.count++;
+      log_gas("pinned %zu (cached %d)\n", gva.getAddr(), slot.count);
+    }
+    if (lva) {
+      *lva = static_cast<char*>(base) + gva.toBlockOffset();
+    }
     return true;
   }
+  lock.unlock();
 
   // if I have an entry, but don't own the translation, and the current parcel
   // was sent to this entry, then the sender has a bad cached translation and
   // should be updated to my view of the owner
   hpx_parcel_t *p = self->getCurrentParcel();
   if (p->src != rank_) {
-    hpx_addr_t addr = gva.getAddr();
-    hpx_call(HPX_THERE(p->src), UpdateOwner, HPX_NULL, &addr, &owner);
+    pushOwner(p->src, gva, owner);
   }
   return false;
 }
@@ -123,22 +268,48 @@ BTT::tryPin(GVA gva, void **lva) {
 void
 BTT::unpin(GVA gva)
 {
+  uint64_t key = gva.toKey();
+  Cache& cache = this->cache();
   hpx_parcel_t *p = NULL;
+  {
+    std::lock_guard<std::mutex> _(cache.lock);
+
+    // The pin may have happened on a different worker, so it's fine for our
+    // cached count to go negative.
+    auto i = cache.slots.find(key);
+    if (i != cache.slots.end()) {
+      i->second.count--;
+      log_gas("unpinned %zu (cached %d)\n", gva.getAddr(), i->second.count);
+      return;
+    }
 
-  // The lambda runs while holding the correct locks to provide atomicity for
-  // accessing the record's fields. We reduce it's reference count and take its
-  // continuation if the count reaches zero.
-  auto fn = [&](Entry& entry) {
-    assert(entry.owner == rank_);
-    assert(entry.count > 0);
-    if (--entry.count) {
-      std::swap(p, entry.cont);
+    // The lambda runs while holding the correct locks to provide atomicity for
+    // accessing the record's fields. If the block is draining we reduce its
+    // reference count and take its continuation if the count reaches zero.
+    bool cacheable = false;
+    auto fn = [&](Entry& entry) {
+      assert(entry.owner == rank_);
+      if (entry.draining) {
+        if (--entry.count == 0) {
+          std::swap(p, entry.cont);
+        }
+        log_gas("unpinned %zu (%d)\n", gva.getAddr(), entry.count);
+      }
+      else {
+        entry.cached = true;
+        cacheable = true;
+      }
+    };
+
+    if (!map_.update_fn(gva, fn)) {
+      dbg_error("cannot find gva during unpin\n");
     }
-    log_gas("unpinned %zu (%d)\n", gva.getAddr(), entry.count);
-  };
 
-  if (!map_.update_fn(gva, fn)) {
-    dbg_error("cannot find gva during unpin\n");
+    if (cacheable) {
+      Slot& slot = getSlot(cache, gva);
+      slot.count--;
+      log_gas("unpinned %zu (cached %d)\n", gva.getAddr(), slot.count);
+    }
   }
 
   // If we got a continuation from the reduction then submit it back to the
@@ -148,6 +319,70 @@ BTT::unpin(GVA gva)
   }
 }
 
+bool
+BTT::isSweeping(GVA gva) const
+{
+  Entry entry;
+  return map_.find(gva, entry) && entry.sweeping;
+}
+
+void
+BTT::drain(GVA gva)
+{
+  // Once the entry is draining no worker will add it to its cache, so we only
+  // need to sweep the caches once. A concurrent drain that finds someone else
+  // sweeping has to wait for the fold, otherwise it could see a zero count
+  // while pins are still sitting in the caches.
+  bool cached = false;
+  bool sweeping = false;
+  auto fn = [&](Entry& entry) {
+    if (entry.owner == rank_) {
+      entry.draining = true;
+      cached = entry.cached;
+      entry.cached = false;
+      entry.sweeping |= cached;
+      sweeping = entry.sweeping;
+    }
+  };
+
+  if (!map_.update_fn(gva, fn)) {
+    return;
+  }
+
+  if (!cached) {
+    while (sweeping && (sweeping = isSweeping(gva))) {
+      if (self && self->getCurrentParcel()) {
+        self->yield();
+      }
+      else {
+        sched_yield();
+      }
+    }
+    return;
+  }
+
+  uint64_t key = gva.toKey();
+  int32_t count = 0;
+  for (auto& cache : caches_) {
+    std::lock_guard<std::mutex> _(cache->lock);
+    auto i = cache->slots.find(key);
+    if (i != cache->slots.end()) {
+      count += i->second.count;
+      cache->slots.erase(i);
+    }
+  }
+
+  // Unpins that missed in the caches while we were sweeping have already been
+  // counted in the table, so this fold can't bring the count to zero with a
+  // continuation waiting.
+  auto add = [&](Entry& entry) {
+    entry.count += count;
+    entry.sweeping = false;
+  };
+  map_.update_fn(gva, add);
+  log_gas("drained %zu (%d)\n", gva.getAddr(), count);
+}
+
 void*
 BTT::getLVA(GVA gva) const
 {
@@ -249,6 +484,8 @@ BTT::waitForZeroCount(GlobalVirtualAddress gva)
 bool
 BTT::tryRemove(GlobalVirtualAddress gva, void*& lva)
 {
+  drain(gva);
+
   int count = 0;
   auto fn = [&](Entry& entry) {
     count = entry.count;
@@ -286,6 +523,8 @@ BTT::tryRemoveForFastpathFree(GVA gva)
     return out;
   }
 
+  drain(gva);
+
   auto fn = [&](Entry& entry) {
     if (entry.count == 0 && entry.blocks == 1) {
       out = entry.lva;
@@ -303,9 +542,12 @@ BTT::tryRemoveForFastpathFree(GVA gva)
 bool
 BTT::tryMove(GVA gva, uint32_t to, uint32_t& attr, void*& out)
 {
+  drain(gva);
+
   auto fn = [&](Entry& entry) {
     if (entry.count == 0) {
       entry.owner = to;
+      entry.draining = false;
       attr = entry.attr;
       out = entry.lva;
     }
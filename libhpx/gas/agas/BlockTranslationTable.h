@@ -16,19 +16,43 @@
 
 #include "GlobalVirtualAddress.h"
 #include "libhpx/parcel.h"
+#include "libhpx/util/Aligned.h"
 #include "hpx/hpx.h"
 #include <cuckoohash_map.hh>
 #include <cinttypes>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace libhpx {
 namespace gas {
 namespace agas {
+/// The block translation table maps global virtual addresses to their owners
+/// and local translations.
+///
+/// Pin counts are sharded across per-worker translation caches. A worker pins
+/// a local block by incrementing the count in its own cache, so the common
+/// pin/unpin of a hot block doesn't touch the shared table. A lightweight
+/// thread may unpin on a different worker than it pinned on, so an individual
+/// cached count can be negative, and only the sum is meaningful.
+///
+/// Operations that need a zero count (move and free) first drain the block.
+/// Draining stops new pins from being cached, removes the block from all of
+/// the caches, and folds their counts into the shared count in the table,
+/// which is then used until the block leaves this locality. A drain that
+/// overlaps with another drain's sweep waits for the fold to finish.
+///
+/// Each cache holds a bounded number of slots. When a cache is full a slot is
+/// evicted and its count is folded into the table to make room.
 class BlockTranslationTable
 {
  public:
   using GVA = GlobalVirtualAddress;
 
-  BlockTranslationTable(size_t);
+  /// Allocate a table with translation caches for @p threads workers, along
+  /// with one shared by threads that aren't workers.
+  BlockTranslationTable(size_t threads);
   ~BlockTranslationTable();
 
   /// Insert a block translation record for a gva.
@@ -40,8 +64,9 @@ class BlockTranslationTable
   /// Try an pin a translation.
   ///
   /// This will check to see if the translation is available and owned locally,
-  /// and if so it will atomically increment the reference count and return the
-  /// local translation through the @p lva parameter.
+  /// and if so it will increment the reference count and return the local
+  /// translation through the @p lva parameter. This is satisfied from the
+  /// calling worker's translation cache when possible.
   ///
   /// @param        gva The global virtual address to translate.
   /// @param[out]   lva The pinned translation.
@@ -127,11 +152,29 @@ class BlockTranslationTable
   /// @param      owner The new owner.
   void updateOwner(GVA gva, uint32_t owner);
 
-  /// The asynchronous entry point for ownerUpdate.
+  /// Tell a locality about the owner of a block.
+  ///
+  /// Updates are batched per destination locality and duplicates are merged.
+  /// A batch is sent when it fills, or by a lightweight thread that is spawned
+  /// when the first update is added, so updates that are produced together
+  /// travel together.
+  ///
+  /// @param       rank The locality to update.
+  /// @param        gva The global virtual address.
+  /// @param      owner The owner to tell @p rank about.
+  void pushOwner(uint32_t rank, GVA gva, uint32_t owner);
+
+  /// Send the pending owner updates for a rank.
+  void flushOwners(uint32_t rank);
+
+  /// The asynchronous entry point for a batch of owner updates.
   ///
   /// This verifies that the local GAS instance is an AGAS instance, and then
-  /// updates the owner of the passed @p address to @p owner.
-  static int UpdateOwnerHandler(hpx_addr_t addr, uint32_t owner);
+  /// installs all of the (address, owner) pairs in the batch.
+  static int UpdateOwnersHandler(const void* records, size_t bytes);
+
+  /// The entry point for the thread that sends the owner updates for a rank.
+  static int FlushOwnersHandler(uint32_t rank);
 
  private:
   /// Try to remove a global virtual address from the block translation table.
@@ -150,6 +193,15 @@ class BlockTranslationTable
   /// case it will return a pointer to the previous local virtual address in
   bool tryMove(GVA gva, uint32_t rank, uint32_t& attr, void*& lva);
 
+  /// Move the pin counts for a gva from the translation caches into the table.
+  ///
+  /// After this returns the gva will not be cached again until it is removed
+  /// or moved away, so the count in the table is exact.
+  void drain(GVA gva);
+
+  /// Check if a drain is still folding the cached counts for a gva.
+  bool isSweeping(GVA gva) const;
+
   /// Block the calling thread until the reference count for the gva hits zero.
   ///
   /// This can suffer from spurious wake up events, so anyone calling this
@@ -163,19 +215,59 @@ class BlockTranslationTable
     size_t      blocks;
     hpx_parcel_t *cont;
     uint32_t      attr;
+    bool        cached;                         //!< may be in a cache
+    bool      draining;                         //!< counted in the table
+    bool      sweeping;                         //!< caches being folded
     Entry() : count(0), owner(0), lva(NULL), blocks(1), cont(NULL),
-              attr(HPX_GAS_ATTR_NONE) {
+              attr(HPX_GAS_ATTR_NONE), cached(false), draining(false),
+              sweeping(false) {
     }
     Entry(int32_t o, void *l, size_t b, uint32_t a)
-        : count(0), owner(o), lva(l), blocks(b), cont(NULL), attr(a) {
+        : count(0), owner(o), lva(l), blocks(b), cont(NULL), attr(a),
+          cached(false), draining(false), sweeping(false) {
     }
   };
 
+  /// A cached translation and the pin count that this worker contributes.
+  struct Slot {
+    void      *lva;                             //!< NULL if only unpinned
+    int32_t  count;
+  };
+
+  /// The translation cache for one worker.
+  struct Cache : public util::Aligned<HPX_CACHELINE_SIZE> {
+    std::mutex                             lock; //!< held by the owner
+    std::unordered_map<uint64_t, Slot>    slots; //!< keyed by GVA::toKey()
+  };
+
+  /// Find or create the slot for a gva in a cache.
+  ///
+  /// This evicts another slot if the cache is full. The caller must hold the
+  /// cache's lock.
+  Slot& getSlot(Cache& cache, GVA gva);
+
   using Hash = CityHasher<GlobalVirtualAddress>;
   using Map = cuckoohash_map<GlobalVirtualAddress, Entry, Hash>;
 
+  /// An owner update on the wire.
+  struct OwnerRecord {
+    hpx_addr_t  addr;
+    uint32_t   owner;
+  };
+
+  /// The pending owner updates for one destination.
+  struct OwnerBatch : public util::Aligned<HPX_CACHELINE_SIZE> {
+    std::mutex                                lock;
+    std::unordered_map<hpx_addr_t, uint32_t> owners;
+  };
+
+  /// Get the translation cache for the current worker.
+  Cache& cache() const;
+
   const unsigned rank_;                         //!< cache the local rank
   Map map_;                                     //!< the hashtable
+  std::vector<std::unique_ptr<Cache>> caches_;  //!< one per worker
+  std::vector<std::unique_ptr<OwnerBatch>> owners_; //!< one per rank
 };
 } // namespace agas
 } // namespace gas
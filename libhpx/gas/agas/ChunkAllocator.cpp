@@ -17,6 +17,7 @@
 
 #include "ChunkAllocator.h"
 #include "libhpx/debug.h"
+#include "libhpx/locality.h"
 #include "libhpx/memory.h"
 #include "libhpx/system.h"
 #include "libhpx/util/math.h"
@@ -28,11 +29,13 @@ using libhpx::util::ceil_log2;
 using libhpx::util::ceil_div;
 }
 
-ChunkAllocator::ChunkAllocator(ChunkTable& chunks, size_t heapSize)
+ChunkAllocator::ChunkAllocator(ChunkTable& chunks, size_t heapSize,
+                               uint64_t base)
     : Bitmap(ceil_div(heapSize, as_bytes_per_chunk()),
              ceil_log2(as_bytes_per_chunk()),
              ceil_log2(heapSize)),
       chunkSize_(as_bytes_per_chunk()),
+      base_(base),
       chunks_(chunks)
 {
 }
@@ -51,7 +54,7 @@ ChunkAllocator::allocate(void* addr, size_t n, size_t align, size_t bsize)
   if (reserve(nbits, log2_align, &bit)) {
     dbg_error("Could not reserve gva for %zu bytes\n", n);
   }
-  uint64_t offset = bit * chunkSize_;
+  uint64_t offset = base_ + bit * chunkSize_;
 
   // 2) get backing memory
   align = 1 << log2_align;
@@ -59,7 +62,12 @@ ChunkAllocator::allocate(void* addr, size_t n, size_t align, size_t bsize)
   dbg_assert(base);
   dbg_assert(((uintptr_t)base & (align - 1)) == 0);
 
-  // 3) insert the inverse mappings
+  // 3) place the chunk before anything touches it
+  if (system_set_gas_membind(base, n, offset, here->config->gas_numa)) {
+    log_gas("could not apply the numa policy to the chunk at %p\n", base);
+  }
+
+  // 4) insert the inverse mappings
   char* chunk = static_cast<char*>(base);
   for (int i = 0, e = nbits; i < e; ++i) {
     chunks_.insert(chunk, offset);
@@ -75,7 +83,7 @@ ChunkAllocator::deallocate(void* addr, size_t n)
   // 1) release the bits
   uint64_t offset = chunks_.offsetOf(addr);
   uint32_t nbits = ceil_div(n, chunkSize_);
-  uint32_t bit = offset / chunkSize_;
+  uint32_t bit = (offset - base_) / chunkSize_;
   release(bit, nbits);
 
   // 2) unmap the backing memory
@@ -17,6 +17,7 @@
 #include "ChunkTable.h"
 #include "libhpx/util/Bitmap.h"
 #include <cstddef>
+#include <cstdint>
 
 namespace libhpx {
 namespace gas {
@@ -29,9 +30,12 @@ namespace agas {
 /// allocated the chunk allocator will go through the system_mmap()
 /// functionality to get backing memory, and it will update the chunk table with
 /// the mapping.
+///
+/// A chunk allocator can also manage a subrange of the address space, starting
+/// at @p base, so that each rank can allocate from a disjoint partition.
 class ChunkAllocator : public util::Bitmap {
  public:
-  ChunkAllocator(ChunkTable& chunks, size_t heapSize);
+  ChunkAllocator(ChunkTable& chunks, size_t heapSize, uint64_t base = 0);
   ~ChunkAllocator();
 
   /// Allocate a chunk from the global address space.
@@ -54,6 +58,7 @@ class ChunkAllocator : public util::Bitmap {
 
  private:
   const size_t chunkSize_;
+  const uint64_t base_;
   ChunkTable& chunks_;
 };
 
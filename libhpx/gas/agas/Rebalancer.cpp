@@ -70,6 +70,24 @@ void rebalancer_add_entry(int src, int dst, hpx_addr_t block, size_t size) {
   _bst->add(gva, src, 1, size);
 }
 
+// Get the localities that accessed a block in the last rebalancing epoch.
+//
+// This is used to push owner updates when the block is moved. The access
+// records are taken from the block's statistics when they are aggregated, and
+// are discarded once they've been read.
+//
+/// @param    block The global address of the block.
+/// @param[out] ranks The localities that accessed the block.
+/// @param        n The capacity of @p ranks.
+///
+/// @returns The number of localities in @p ranks.
+int rebalancer_get_accessors(hpx_addr_t block, uint32_t *ranks, int n) {
+  if (!_bst) {
+    return 0;
+  }
+  return _bst->takeAccessors(GVA(block), ranks, n);
+}
+
 // Initialize the AGAS-based rebalancer.
 int rebalancer_init(void) {
   _bst = new BST();
@@ -107,10 +107,8 @@ static const chunk_hooks_t _global_hooks = {
 };
 
 void
-AGAS::initAllocators(unsigned rank)
+AGAS::initAllocators(unsigned)
 {
-  if (rank == 0) {
-    as_set_allocator(AS_CYCLIC, &_cyclic_hooks);
-  }
+  as_set_allocator(AS_CYCLIC, &_cyclic_hooks);
   as_set_allocator(AS_GLOBAL, &_global_hooks);
 }
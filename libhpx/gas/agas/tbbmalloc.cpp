@@ -57,11 +57,11 @@ _global_chunk_free(intptr_t pool_id, void* raw_ptr, size_t raw_bytes)
 }
 
 void
-AGAS::initAllocators(unsigned rank)
+AGAS::initAllocators(unsigned)
 {
   MemoryPool* pool = nullptr;
   size_t chunkSize = as_bytes_per_chunk();
-  if (rank == 0) {
+  {
     const MemPoolPolicy policy(_cyclic_chunk_alloc, _cyclic_chunk_free,
                                chunkSize);
     pool_create_v1(AS_CYCLIC, &policy, &pool);
@@ -25,12 +25,6 @@ class GlobalAllocator {
  private:
   void* hpx143Fix_;
 };
-
-class CyclicAllocator {
- public:
-  CyclicAllocator(int rank);
-  ~CyclicAllocator();
-};
 } // namespace pgas
 } // namespace gas
 } // namespace libhpx
@@ -35,11 +35,14 @@ const uint64_t MAX_HEAP_BYTES = UINT64_C(1) << GPA_OFFSET_BITS;
 }
 
 HeapSegment* HeapSegment::Instance_;
+__thread const char* HeapSegment::FreshChunk_;
+__thread size_t HeapSegment::FreshBytes_;
 
 HeapSegment::HeapSegment(size_t size)
     : bytesPerChunk_(as_bytes_per_chunk()),
       nBytes_(size - (size % bytesPerChunk_)),
       csbrk_(nBytes_),
+      gbrk_(0),
       nChunks_(ceil_div(nBytes_, bytesPerChunk_)),
       logMaxBlockSize_(std::min(GPA_MAX_LG_BSIZE, ceil_log2(nBytes_))),
       base_(newSegment()),
@@ -107,10 +110,19 @@ HeapSegment::allocateChunk(void *addr, size_t n, size_t align, ChunkType type)
   uint64_t offset = bit * bytesPerChunk_;
   assert(offset % align == 0);
 
+  // Global chunks are reserved from the bottom of the heap, so a chunk that
+  // starts above every chunk that we've handed out has never been written.
+  bool fresh = false;
   if (type == GLOBAL) {
     if (offset + n > csbrk_) {
       dbg_error("out-of-memory detected\n");
     }
+    uint64_t gbrk = gbrk_.load(std::memory_order_relaxed);
+    while (gbrk < offset + n &&
+           !gbrk_.compare_exchange_weak(gbrk, offset + n,
+                                        std::memory_order_relaxed)) {
+    }
+    fresh = (gbrk <= offset);
   }
   else {
     setCsbrk(offset);
@@ -118,6 +130,17 @@ HeapSegment::allocateChunk(void *addr, size_t n, size_t align, ChunkType type)
 
   void *p = offsetToLVA(offset);
   dbg_assert(((uintptr_t)p & (align - 1)) == 0);
+
+  if (fresh) {
+    FreshChunk_ = static_cast<const char*>(p);
+    FreshBytes_ = n;
+  }
+
+  // This only places pages that haven't been touched yet, chunks that are
+  // reused keep their original placement.
+  if (system_set_gas_membind(p, n, offset, here->config->gas_numa)) {
+    log_gas("could not apply the numa policy to the chunk at %p\n", p);
+  }
   return p;
 }
 
@@ -176,11 +199,12 @@ HeapSegment::chunksAreUsed(uint64_t offset, size_t n) const
 bool
 HeapSegment::setCsbrk(uint64_t offset)
 {
-  // csbrk is monotonically decreasing
+  // csbrk is monotonically decreasing, a returned cyclic lease can be leased
+  // again above it
   uint64_t old = csbrk_.load(std::memory_order_relaxed);
-  if (old > offset) {
-    csbrk_.compare_exchange_weak(old, offset, std::memory_order_relaxed,
-                                 std::memory_order_relaxed);
+  while (offset < old &&
+         !csbrk_.compare_exchange_weak(old, offset, std::memory_order_relaxed,
+                                       std::memory_order_relaxed)) {
   }
-  return chunksAreUsed(offset, old - offset);
+  return (offset < old) && chunksAreUsed(offset, old - offset);
 }
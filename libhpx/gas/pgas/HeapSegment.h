@@ -25,8 +25,13 @@
 /// divided into cyclic and acyclic regions. Each locality manages its acyclic
 /// region with a combination of jemalloc and a simple, locking-bitmap-based
 /// jemalloc chunk allocator. The cyclic region is managed via an sbrk at the
-/// root locality. The regions start out opposite each other in the space, and
-/// grow towards each other.
+/// root locality, which leases ranges of it to the localities so that they can
+/// allocate cyclic blocks locally. Cyclic arrays always start at the root
+/// locality, which records the lease holders so that frees reach the locality
+/// that reserved the range. A locality returns a lease to the root once all of
+/// the allocations in it have been freed, but the csbrk never moves back up,
+/// and partially used leases stay with their holder. The regions start out
+/// opposite each other in the space, and grow towards each other.
 ///
 ///   +------------------------
 ///   | cyclic
@@ -162,6 +167,22 @@ class HeapSegment {
   /// @returns TRUE if the offset is a cyclic offset, FALSE otherwise.
   bool isCyclicOffset(uint64_t offset) const;
 
+  /// Check if an allocation lies in the last chunk allocated for this thread,
+  /// if that chunk had never been handed out before.
+  ///
+  /// Chunks that have never been used still hold the zeros that mmap gave us,
+  /// so allocations in them don't need to be zeroed. Callers reset
+  /// FreshChunk_ before allocating so that this only matches a chunk that was
+  /// allocated for that request.
+  static bool IsFresh(const void* lva, size_t bytes) {
+    const char* p = static_cast<const char*>(lva);
+    return (FreshChunk_ && FreshChunk_ <= p &&
+            p + bytes <= FreshChunk_ + FreshBytes_);
+  }
+
+  static __thread const char* FreshChunk_;
+  static __thread size_t FreshBytes_;
+
  private:
 
   /// Check to see if the heap contains the given local virtual address.
@@ -200,6 +221,7 @@ class HeapSegment {
   const size_t bytesPerChunk_;
   const size_t nBytes_;
   std::atomic<uint64_t> csbrk_;
+  std::atomic<uint64_t> gbrk_;                  //!< top of used global chunks
   const uint32_t nChunks_;
   const uint32_t logMaxBlockSize_;
   char *base_;
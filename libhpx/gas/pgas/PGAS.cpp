@@ -15,32 +15,46 @@
 # include "config.h"
 #endif
 
+#include <algorithm>
+#include <cinttypes>
 #include <cstring>
+#include <iterator>
 #include "PGAS.h"
 #include "libhpx/Network.h"
 #include "libhpx/util/math.h"
 
 namespace {
 using libhpx::gas::pgas::PGAS;
+using libhpx::util::ceil2;
 using libhpx::util::ceil_log2;
 using libhpx::util::ceil_div;
 }
 
 static LIBHPX_ACTION(HPX_INTERRUPT, 0, SetCsbrk, PGAS::SetCsbrkHandler,
                      HPX_SIZE_T);
-static LIBHPX_ACTION(HPX_INTERRUPT, 0, ZeroBlocks, PGAS::ZeroBlocksHandler,
+static LIBHPX_ACTION(HPX_DEFAULT, 0, ZeroBlocks, PGAS::ZeroBlocksHandler,
                      HPX_UINT64, HPX_SIZE_T, HPX_SIZE_T);
-static LIBHPX_ACTION(HPX_INTERRUPT, 0, AllocateCyclicBlocks,
-                     PGAS::AllocateCyclicBlocksHandler, HPX_SIZE_T,HPX_SIZE_T,
-                     HPX_UINT32, HPX_UINT32, HPX_INT);
+static LIBHPX_ACTION(HPX_INTERRUPT, 0, LeaseCyclic, PGAS::LeaseCyclicHandler,
+                     HPX_SIZE_T, HPX_SIZE_T, HPX_UINT32);
+static LIBHPX_ACTION(HPX_INTERRUPT, 0, ReturnCyclic, PGAS::ReturnCyclicHandler,
+                     HPX_UINT64);
 static LIBHPX_ACTION(HPX_DEFAULT, 0, Free, PGAS::FreeHandler, HPX_ADDR,
                      HPX_ADDR);
+static LIBHPX_ACTION(HPX_DEFAULT, 0, FreeCyclic, PGAS::FreeCyclicHandler,
+                     HPX_UINT64, HPX_ADDR);
 
 PGAS::PGAS(const config_t *cfg)
     : GAS(),
       HeapSegment(cfg->heapsize),
       global_(here->rank),
-      cyclic_(here->rank)
+      cyclicLock_(),
+      cyclicNext_(0),
+      cyclicEnd_(0),
+      cyclicFree_(),
+      cyclicLive_(),
+      cyclicLeases_(),
+      leaseLock_(),
+      leases_()
 {
 }
 
@@ -77,11 +91,17 @@ PGAS::free(hpx_addr_t gpa, hpx_addr_t sync)
     return;
   }
 
-  dbg_assert(!isCyclicAddress(gpa) || here->rank == 0);
-
-  // return the memory to the the correct local memory region
+  // Cyclic allocations are based at rank 0, but their ranges were reserved
+  // from a lease held by the rank that allocated them, so forward the free
+  // there.
   if (isCyclicAddress(gpa)) {
-    cyclic_free(gpaToLVA(gpa));
+    uint64_t offset = gpa_to_offset(gpa);
+    uint32_t rank = cyclicLeaseHolder(offset);
+    if (rank != here->rank) {
+      hpx_call(HPX_THERE(rank), FreeCyclic, HPX_NULL, &offset, &sync);
+      return;
+    }
+    releaseCyclic(offset);
   }
   else {
     global_free(gpaToLVA(gpa));
@@ -93,64 +113,51 @@ PGAS::free(hpx_addr_t gpa, hpx_addr_t sync)
 hpx_addr_t
 PGAS::alloc_cyclic(size_t n, size_t bsize, uint32_t boundary, uint32_t attr)
 {
-  uint64_t offset;
-  int zero = 0;
-  hpx_call_sync(HPX_THERE(0), AllocateCyclicBlocks, &offset, sizeof(offset), &n,
-                &bsize, &boundary, &attr, &zero);
-  return offsetToGPA(offset);
+  // cyclic arrays always start at rank 0, no matter who allocates them
+  return offset_to_gpa(0, allocateCyclicBlocks(n, bsize, boundary, 0));
 }
 
 hpx_addr_t
 PGAS::calloc_cyclic(size_t n, size_t bsize, uint32_t boundary, uint32_t attr)
 {
-  uint64_t offset;
-  int zero = 1;
-  hpx_call_sync(HPX_THERE(0), AllocateCyclicBlocks, &offset, sizeof(offset), &n,
-                &bsize, &boundary, &attr, &zero);
-  return offsetToGPA(offset);
+  return offset_to_gpa(0, allocateCyclicBlocks(n, bsize, boundary, 1));
 }
 
 hpx_addr_t
 PGAS::alloc_local(size_t n, size_t bsize, uint32_t boundary,
                   uint32_t attr) {
-  return offsetToGPA(allocateBlocks(n, bsize, boundary, attr, false, false));
+  return offsetToGPA(allocateBlocks(n, bsize, boundary, attr, false));
 }
 
 hpx_addr_t
 PGAS::calloc_local(size_t n, size_t bsize, uint32_t boundary,
                    uint32_t attr) {
-  return offsetToGPA(allocateBlocks(n, bsize, boundary, attr, true, false));
+  return offsetToGPA(allocateBlocks(n, bsize, boundary, attr, true));
 }
 
 inline uint64_t
 PGAS::allocateBlocks(size_t n, size_t bsize, uint32_t boundary,
-                     uint32_t attr, bool zero, bool cyclic)
+                     uint32_t attr, bool zero)
 {
   uint64_t padded = uint64_t(1) << ceil_log2(bsize);
   dbg_assert_str(padded <= maxBlockSize(), "block size too large.\n");
 
   void* lva;
-  if (cyclic && boundary) {
-    lva = cyclic_memalign(boundary, n * padded);
-  }
-  else if (cyclic) {
-    lva = cyclic_malloc(n * padded);
-  }
-  else if (boundary && zero) {
-    lva = global_memalign(boundary, n * padded);
-    std::memset(lva, 0, n * padded);
-  }
-  else if (boundary) {
+  FreshChunk_ = nullptr;
+  if (boundary) {
     lva = global_memalign(boundary, n * padded);
   }
-  else if (zero) {
-    lva = global_calloc(n, padded);
-  }
   else {
     lva = global_malloc(n * padded);
   }
-
   dbg_assert(lva);
+
+  // We zero here rather than using calloc, so that large allocations are
+  // zeroed by all of the workers. Memory in a chunk that was just mapped is
+  // already zero.
+  if (zero && !IsFresh(lva, n * padded)) {
+    Zero(lva, n * padded);
+  }
   return lvaToOffset(lva);
 }
 
@@ -161,24 +168,232 @@ PGAS::zeroBlocks(uint64_t offset, size_t n, size_t bsize)
   uint64_t blocks = ceil_div(uint64_t(n), uint64_t(here->ranks));
   uint32_t align = ceil_log2(bsize);
   uint64_t padded = uint64_t(1) << align;
-  std::memset(offsetToLVA(offset), 0, blocks * padded);
+  Zero(offsetToLVA(offset), blocks * padded);
 }
 
 uint64_t
-PGAS::allocateCyclicBlocks(size_t n, size_t bsize, uint32_t boundary,
-                           uint32_t attr, int zero)
+PGAS::allocateCyclicBlocks(size_t n, size_t bsize, uint32_t boundary, int zero)
 {
-  dbg_assert(here->rank == 0);
   uint64_t blocks = ceil_div(uint64_t(n), uint64_t(here->ranks));
-  uint64_t offset = allocateBlocks(blocks, bsize, boundary, attr, zero, true);
-  uint64_t csbrk = getCsbrk();
-  hpx_bcast_rsync(SetCsbrk, &csbrk);
+  uint64_t padded = uint64_t(1) << ceil_log2(bsize);
+  dbg_assert_str(padded <= maxBlockSize(), "block size too large.\n");
+
+  // Cyclic address arithmetic needs the base to be aligned to the padded
+  // block size.
+  uint64_t align = std::max({uint64_t(boundary), padded, uint64_t(8)});
+  uint64_t offset = reserveCyclic(blocks * padded, ceil2(align));
   if (zero) {
-    dbg_check(hpx_bcast_rsync(ZeroBlocks, &offset, &blocks, &bsize), "\n");
+    dbg_check(hpx_bcast_rsync(ZeroBlocks, &offset, &n, &bsize), "\n");
+  }
+  return offset;
+}
+
+uint64_t
+PGAS::leaseCyclic(size_t bytes, size_t align, uint32_t rank)
+{
+  dbg_assert(here->rank == 0);
+  void* lva = allocateChunk(nullptr, bytes, align, CYCLIC);
+  uint64_t offset = lvaToOffset(lva);
+  {
+    std::lock_guard<std::mutex> _(leaseLock_);
+    leases_.emplace(offset, Lease{bytes, rank});
   }
+  uint64_t csbrk = getCsbrk();
+  dbg_check(hpx_bcast_rsync(SetCsbrk, &csbrk), "\n");
+  log_gas("leased %zu cyclic bytes at offset %" PRIu64 " to %u\n", bytes,
+          offset, rank);
   return offset;
 }
 
+void
+PGAS::returnCyclic(uint64_t offset)
+{
+  dbg_assert(here->rank == 0);
+  size_t bytes;
+  {
+    std::lock_guard<std::mutex> _(leaseLock_);
+    auto i = leases_.find(offset);
+    if (i == leases_.end()) {
+      dbg_error("cyclic offset %" PRIu64 " is not a lease\n", offset);
+    }
+    bytes = i->second.bytes;
+    leases_.erase(i);
+  }
+  deallocateChunk(offsetToLVA(offset), bytes);
+  log_gas("returned %zu cyclic bytes at offset %" PRIu64 "\n", bytes, offset);
+}
+
+uint32_t
+PGAS::cyclicLeaseHolder(uint64_t offset)
+{
+  dbg_assert(here->rank == 0);
+  std::lock_guard<std::mutex> _(leaseLock_);
+  auto i = leases_.upper_bound(offset);
+  if (i == leases_.begin()) {
+    dbg_error("cyclic offset %" PRIu64 " was never leased\n", offset);
+  }
+  --i;
+  dbg_assert(offset < i->first + i->second.bytes);
+  return i->second.rank;
+}
+
+uint64_t
+PGAS::reserveCyclic(size_t bytes, size_t align)
+{
+  dbg_assert(bytes);
+  while (true) {
+    {
+      std::lock_guard<std::mutex> _(cyclicLock_);
+      uint64_t offset;
+      if (tryReserveCyclic(bytes, align, offset)) {
+        cyclicLive_.emplace(offset, bytes);
+        return offset;
+      }
+    }
+
+    // We don't hold the lock while we wait for rank 0, so other threads can
+    // continue to allocate from the existing leases in the meantime.
+    size_t chunk = bytesPerChunk_;
+    size_t n = ceil_div(bytes, chunk) * chunk;
+    size_t a = std::max(align, chunk);
+    uint32_t rank = here->rank;
+    uint64_t offset;
+    dbg_check(hpx_call_sync(HPX_THERE(0), LeaseCyclic, &offset, sizeof(offset),
+                            &n, &a, &rank), "\n");
+
+    // Whatever is left in the current lease goes to the free ranges.
+    uint64_t lease;
+    bool retire = false;
+    {
+      std::lock_guard<std::mutex> _(cyclicLock_);
+      uint64_t next = cyclicNext_;
+      uint64_t end = cyclicEnd_;
+      cyclicLeases_.emplace(offset, n);
+      cyclicNext_ = offset;
+      cyclicEnd_ = offset + n;
+      if (next < end) {
+        insertFreeCyclic(next, end - next);
+        retire = tryRetireLease(next, lease);
+      }
+    }
+    if (retire) {
+      hpx_call(HPX_THERE(0), ReturnCyclic, HPX_NULL, &lease);
+    }
+  }
+}
+
+bool
+PGAS::tryReserveCyclic(size_t bytes, size_t align, uint64_t& offset)
+{
+  // First fit from the free ranges.
+  for (auto i = cyclicFree_.begin(), e = cyclicFree_.end(); i != e; ++i) {
+    uint64_t start = i->first;
+    uint64_t   end = start + i->second;
+    uint64_t  base = (start + align - 1) & ~uint64_t(align - 1);
+    if (end < base + bytes) {
+      continue;
+    }
+    cyclicFree_.erase(i);
+    if (start < base) {
+      cyclicFree_.emplace(start, base - start);
+    }
+    if (base + bytes < end) {
+      cyclicFree_.emplace(base + bytes, end - base - bytes);
+    }
+    offset = base;
+    return true;
+  }
+
+  // Then bump allocate from the current lease.
+  uint64_t base = (cyclicNext_ + align - 1) & ~uint64_t(align - 1);
+  if (cyclicEnd_ < base + bytes) {
+    return false;
+  }
+  if (cyclicNext_ < base) {
+    insertFreeCyclic(cyclicNext_, base - cyclicNext_);
+  }
+  cyclicNext_ = base + bytes;
+  offset = base;
+  return true;
+}
+
+void
+PGAS::releaseCyclic(uint64_t offset)
+{
+  uint64_t lease;
+  {
+    std::lock_guard<std::mutex> _(cyclicLock_);
+    auto i = cyclicLive_.find(offset);
+    if (i == cyclicLive_.end()) {
+      dbg_error("cyclic offset %" PRIu64 " was not allocated here\n", offset);
+    }
+    size_t bytes = i->second;
+    cyclicLive_.erase(i);
+    insertFreeCyclic(offset, bytes);
+    if (!tryRetireLease(offset, lease)) {
+      return;
+    }
+  }
+  hpx_call(HPX_THERE(0), ReturnCyclic, HPX_NULL, &lease);
+}
+
+bool
+PGAS::tryRetireLease(uint64_t offset, uint64_t& lease)
+{
+  auto l = cyclicLeases_.upper_bound(offset);
+  dbg_assert(l != cyclicLeases_.begin());
+  --l;
+  uint64_t start = l->first;
+  uint64_t   end = start + l->second;
+
+  // Keep the lease that we're bump allocating from.
+  if (end == cyclicEnd_) {
+    return false;
+  }
+
+  // Free ranges are coalesced, so the lease is free if a single free range
+  // covers it. That range may extend into neighboring leases.
+  auto f = cyclicFree_.upper_bound(start);
+  if (f == cyclicFree_.begin()) {
+    return false;
+  }
+  --f;
+  uint64_t first = f->first;
+  uint64_t  last = first + f->second;
+  if (last < end) {
+    return false;
+  }
+
+  cyclicFree_.erase(f);
+  if (first < start) {
+    cyclicFree_.emplace(first, start - first);
+  }
+  if (end < last) {
+    cyclicFree_.emplace(end, last - end);
+  }
+  cyclicLeases_.erase(l);
+  lease = start;
+  return true;
+}
+
+void
+PGAS::insertFreeCyclic(uint64_t offset, size_t bytes)
+{
+  auto next = cyclicFree_.lower_bound(offset);
+  if (next != cyclicFree_.end() && offset + bytes == next->first) {
+    bytes += next->second;
+    next = cyclicFree_.erase(next);
+  }
+  if (next != cyclicFree_.begin()) {
+    auto prev = std::prev(next);
+    if (prev->first + prev->second == offset) {
+      prev->second += bytes;
+      return;
+    }
+  }
+  cyclicFree_.emplace(offset, bytes);
+}
+
 void
 PGAS::memcpy(hpx_addr_t to, hpx_addr_t from, size_t n, hpx_addr_t sync)
 {
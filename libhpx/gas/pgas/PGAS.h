@@ -20,6 +20,9 @@
 #include "libhpx/debug.h"
 #include "libhpx/gpa.h"
 #include "libhpx/locality.h"
+#include <map>
+#include <mutex>
+#include <unordered_map>
 
 namespace libhpx {
 namespace gas {
@@ -131,14 +134,22 @@ class PGAS : public GAS, public HeapSegment {
   /// @}
 
  public:
-  /// Asynchronous entry point for the allocate operation
-  static int AllocateCyclicBlocksHandler(size_t n, size_t bsize, uint32_t align,
-                                         uint32_t attr, int zero)
+  /// Asynchronous entry point for the leaseCyclic operation.
+  static int LeaseCyclicHandler(size_t bytes, size_t align, uint32_t rank)
   {
     dbg_assert(here->gas->type() == HPX_GAS_PGAS);
     PGAS* pgas = static_cast<PGAS*>(here->gas);
-    hpx_addr_t addr = pgas->allocateCyclicBlocks(n, bsize, align, attr, zero);
-    return HPX_THREAD_CONTINUE(addr);
+    uint64_t offset = pgas->leaseCyclic(bytes, align, rank);
+    return HPX_THREAD_CONTINUE(offset);
+  }
+
+  /// Asynchronous entry point for the returnCyclic operation.
+  static int ReturnCyclicHandler(uint64_t offset)
+  {
+    dbg_assert(here->gas->type() == HPX_GAS_PGAS);
+    PGAS* pgas = static_cast<PGAS*>(here->gas);
+    pgas->returnCyclic(offset);
+    return HPX_SUCCESS;
   }
 
   /// Asynchronous entry point for the setCsbrk operation.
@@ -178,6 +189,20 @@ class PGAS : public GAS, public HeapSegment {
     return HPX_SUCCESS;
   }
 
+  /// Asynchronous entry point for freeing a cyclic allocation at the locality
+  /// that holds its lease.
+  ///
+  /// @param     offset The base offset of the cyclic allocation.
+  /// @param        lco An lco to signal when the free operation completes.
+  /// @returns             HPX_SUCCSS
+  static int FreeCyclicHandler(uint64_t offset, hpx_addr_t lco) {
+    dbg_assert(here->gas->type() == HPX_GAS_PGAS);
+    PGAS* pgas = static_cast<PGAS*>(here->gas);
+    pgas->releaseCyclic(offset);
+    hpx_lco_set(lco, 0, NULL, HPX_NULL, HPX_NULL);
+    return HPX_SUCCESS;
+  }
+
  private:
   /// Convert a global address into a local virtual address.
   ///
@@ -200,7 +225,7 @@ class PGAS : public GAS, public HeapSegment {
 
   /// The core allocation routine.
   ///
-  /// This allocates contiguous blocks of memory from the designated address
+  /// This allocates contiguous blocks of memory from the global address
   /// space, zeroing them if necessary. Blocks are always aligned to a 2^k
   /// boundary, so the total number of bytes allocated may be more than n *
   /// bsize.
@@ -210,11 +235,10 @@ class PGAS : public GAS, public HeapSegment {
   /// @param boundary The alignment boundary.
   /// @param     attr Attributes for the allocation.
   /// @param     zero A flag that indicates if we should zero the allocation.
-  /// @param   cyclic A flag indicating the blocks must be cyclic.
   ///
   /// @returns        The base offset of the global allocation.
   uint64_t allocateBlocks(size_t n, size_t bsize, uint32_t boundary,
-                            uint32_t attr, bool zero, bool cyclic);
+                          uint32_t attr, bool zero);
 
   /// Zero the memory for a sequence of blocks.
   ///
@@ -225,21 +249,102 @@ class PGAS : public GAS, public HeapSegment {
 
   /// The cyclic block allocator.
   ///
-  /// This allocates n blocks in a cyclic distribution. It must only be called
-  /// at rank 0.
+  /// This allocates n blocks in a cyclic distribution. The blocks are reserved
+  /// from this rank's cyclic leases, so rank 0 is only involved when we need
+  /// a new lease.
   ///
   /// @param        n The number of blocks to allocate.
   /// @param    bsize The block size for this allocation.
   /// @param boundary The alignment boundary.
-  /// @param     attr Attributes for the allocation.
   /// @param     zero A flag that indicates if we should zero the allocation.
   ///
-  /// @returns        The based address of the global allocation.
+  /// @returns        The base offset of the global allocation.
   uint64_t allocateCyclicBlocks(size_t n, size_t bsize, uint32_t boundary,
-                                uint32_t attr, int zero);
+                                int zero);
+
+  /// Lease a range of the cyclic heap.
+  ///
+  /// This moves the csbrk to cover the new range at all of the ranks, and
+  /// records @p rank as the holder of the lease. It must only be called at
+  /// rank 0.
+  ///
+  /// @param    bytes The number of bytes to lease (a multiple of the chunk
+  ///                 size).
+  /// @param    align The alignment required for the range.
+  /// @param     rank The rank that is leasing the range.
+  ///
+  /// @returns        The base offset of the leased range.
+  uint64_t leaseCyclic(size_t bytes, size_t align, uint32_t rank);
+
+  /// Return a lease that its holder no longer uses.
+  ///
+  /// This releases the lease's chunks so that they can be leased again. It
+  /// must only be called at rank 0.
+  ///
+  /// @param   offset The base offset of the lease.
+  void returnCyclic(uint64_t offset);
+
+  /// Find the rank holding the lease that contains a cyclic offset.
+  ///
+  /// This must only be called at rank 0.
+  uint32_t cyclicLeaseHolder(uint64_t offset);
+
+  /// Reserve a range of the cyclic heap for a local cyclic allocation.
+  ///
+  /// This will lease more of the cyclic heap from rank 0 if the existing
+  /// leases can't satisfy the request.
+  ///
+  /// @param    bytes The number of bytes to reserve.
+  /// @param    align The alignment required for the range (a power of 2).
+  ///
+  /// @returns        The base offset of the reserved range.
+  uint64_t reserveCyclic(size_t bytes, size_t align);
+
+  /// Try to reserve a range from the existing leases.
+  ///
+  /// The caller must hold the cyclicLock_.
+  ///
+  /// @returns        true if @p offset was reserved, false otherwise.
+  bool tryReserveCyclic(size_t bytes, size_t align, uint64_t& offset);
+
+  /// Release a range previously reserved with reserveCyclic().
+  ///
+  /// If this leaves one of our leases entirely free, and it isn't the lease
+  /// that we're currently allocating from, the lease is returned to rank 0.
+  void releaseCyclic(uint64_t offset);
+
+  /// Take a lease that is entirely free out of the free ranges.
+  ///
+  /// The caller must hold the cyclicLock_.
+  ///
+  /// @param   offset An offset in the lease to check.
+  /// @param[out] lease The base offset of the lease.
+  ///
+  /// @returns        true if the lease was free and was taken, false otherwise.
+  bool tryRetireLease(uint64_t offset, uint64_t& lease);
+
+  /// Return a range to the free ranges, coalescing it with its neighbors.
+  ///
+  /// The caller must hold the cyclicLock_.
+  void insertFreeCyclic(uint64_t offset, size_t bytes);
 
   GlobalAllocator global_;
-  CyclicAllocator cyclic_;
+
+  std::mutex                           cyclicLock_; //!< protects the leases
+  uint64_t                             cyclicNext_; //!< unused lease offset
+  uint64_t                              cyclicEnd_; //!< end of current lease
+  std::map<uint64_t, size_t>           cyclicFree_; //!< free leased ranges
+  std::unordered_map<uint64_t, size_t> cyclicLive_; //!< reserved ranges
+  std::map<uint64_t, size_t>         cyclicLeases_; //!< leases we hold
+
+  /// A range of the cyclic heap leased to a rank, recorded at rank 0.
+  struct Lease {
+    size_t   bytes;
+    uint32_t  rank;
+  };
+
+  std::mutex                            leaseLock_; //!< protects leases_
+  std::map<uint64_t, Lease>                leases_; //!< leases by offset
 };
 } // namespace pgas
 } // namespace gas
@@ -25,7 +25,6 @@ namespace {
 using HeapSegment = libhpx::gas::pgas::HeapSegment;
 using ChunkType = libhpx::gas::pgas::HeapSegment::ChunkType;
 using GlobalAllocator = libhpx::gas::pgas::GlobalAllocator;
-using CyclicAllocator = libhpx::gas::pgas::CyclicAllocator;
 }
 
 /// @file  libhpx/gas/pgas/global.c
@@ -66,13 +65,6 @@ _global_chunk_alloc(void *addr, size_t n, size_t align, bool *zero,
   return _chunk_alloc(addr, n, align, zero, commit, arena, ChunkType::GLOBAL);
 }
 
-static void *
-_cyclic_chunk_alloc(void *addr, size_t n, size_t align, bool *zero,
-                      bool *commit, unsigned arena)
-{
-  return _chunk_alloc(addr, n, align, zero, commit, arena, ChunkType::CYCLIC);
-}
-
 
 static bool
 _chunk_free(void *addr, size_t n, bool commited, unsigned arena)
@@ -103,22 +95,3 @@ GlobalAllocator::~GlobalAllocator() {
     as_free(AS_GLOBAL, hpx143Fix_);
   }
 }
-
-static const chunk_hooks_t _cyclic_hooks = {
-  .alloc    = _cyclic_chunk_alloc,
-  .dalloc   = _chunk_free,
-  .commit   = as_null_commit,
-  .decommit = as_null_decommit,
-  .purge    = as_null_purge,
-  .split    = as_null_split,
-  .merge    = as_null_merge
-};
-
-CyclicAllocator::CyclicAllocator(int rank) {
-  if (rank == 0) {
-    as_set_allocator(AS_CYCLIC, &_cyclic_hooks);
-  }
-}
-
-CyclicAllocator::~CyclicAllocator() {
-}
@@ -26,15 +26,6 @@ using namespace rml;
 using HeapSegment = libhpx::gas::pgas::HeapSegment;
 using ChunkType = libhpx::gas::pgas::HeapSegment::ChunkType;
 using GlobalAllocator = libhpx::gas::pgas::GlobalAllocator;
-using CyclicAllocator = libhpx::gas::pgas::CyclicAllocator;
-}
-
-static void *
-_cyclic_chunk_alloc(intptr_t pool_id, size_t &bytes) {
-  assert(pool_id == AS_CYCLIC);
-  HeapSegment* segment = HeapSegment::Instance();
-  size_t align = segment->getBytesPerChunk();
-  return segment->allocateChunk(nullptr, bytes, align, ChunkType::CYCLIC);
 }
 
 static void *
@@ -65,20 +56,3 @@ GlobalAllocator::GlobalAllocator(int rank)
 GlobalAllocator::~GlobalAllocator()
 {
 }
-
-CyclicAllocator::CyclicAllocator(int rank)
-{
-  if (rank == 0) {
-    int id = AS_CYCLIC;
-    size_t granularity = as_bytes_per_chunk();
-    const MemPoolPolicy policy(_cyclic_chunk_alloc, _chunk_free, granularity);
-
-    MemoryPool* pool = nullptr;
-    pool_create_v1(id, &policy, &pool);
-    pools[id] = pool;
-  }
-}
-
-CyclicAllocator::~CyclicAllocator()
-{
-}
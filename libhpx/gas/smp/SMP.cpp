@@ -55,7 +55,7 @@ SMP::calloc_local(size_t n, size_t bsize, uint32_t boundary, uint32_t attr)
   if (boundary) {
     auto bytes = n * bsize;
     dbg_check(posix_memalign(&p, boundary, bytes));
-    p = std::memset(p, 0, bytes);
+    Zero(p, bytes);
   } else {
     p = std::calloc(n, bsize);
   }
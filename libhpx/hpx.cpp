@@ -33,6 +33,7 @@
 #include "libhpx/instrumentation.h"
 #include "libhpx/memory.h"
 #include "libhpx/Network.h"
+#include "libhpx/ParcelCache.h"
 #include "libhpx/percolation.h"
 #include "libhpx/process.h"
 #include "libhpx/Scheduler.h"
@@ -63,6 +64,7 @@ static void _cleanup(locality_t *l) {
   apex_finalize();
 #endif
 
+  libhpx::network::ParcelCache::Fini();
   delete l->net;
 
   if (l->percolation) {
@@ -119,7 +121,7 @@ int hpx_init(int *argc, char ***argv) {
   }
 
   // bootstrap
-  here->boot = libhpx::boot::Network::Create(here->config->boot);
+  here->boot = libhpx::boot::Network::Create(here->config);
   if (!here->boot) {
     status = log_error("failed to bootstrap.\n");
     goto unwind1;
@@ -165,6 +167,12 @@ int hpx_init(int *argc, char ***argv) {
 
   if (!here->config->threads) {
     here->config->threads = cores;
+
+    // forked localities share the node's cores
+    int ranks = here->ranks;
+    if (here->boot->type() == HPX_BOOT_FORK && ranks <= cores) {
+      here->config->threads = cores / ranks;
+    }
   }
   log_dflt("HPX running %d worker threads on %d cores\n", here->config->threads,
            cores);
@@ -194,6 +202,9 @@ int hpx_init(int *argc, char ***argv) {
   apex_init("HPX WORKER THREAD", here->rank, here->ranks);
 #endif
 
+  // per-worker parcel caches
+  libhpx::network::ParcelCache::Init(here->config);
+
   // thread scheduler
   here->sched = new Scheduler(here->config);
   if (!here->sched) {
@@ -259,6 +270,14 @@ int hpx_get_num_threads(void) {
   return (here && here->sched) ? here->sched->getNWorkers() : -1;
 }
 
+int hpx_set_num_active_threads(int n) {
+  return (here && here->sched) ? here->sched->setLimit(n) : -1;
+}
+
+int hpx_get_num_active_threads(void) {
+  return (here && here->sched) ? here->sched->getNTarget() : -1;
+}
+
 /// Called by the application to shutdown the scheduler and network. May be
 /// called from any lightweight HPX thread, or the network thread.
 void
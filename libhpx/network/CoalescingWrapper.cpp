@@ -20,7 +20,8 @@
 #include "libhpx/debug.h"
 #include "libhpx/libhpx.h"
 #include "libhpx/parcel.h"
-#include <memory>
+#include "libhpx/Worker.h"
+#include <algorithm>
 #include <cstring>
 
 namespace {
@@ -29,86 +30,114 @@ using libhpx::network::CoalescingWrapper;
 
 /// Demultiplex coalesced parcels on the receiver side.
 ///
+/// The coalesced parcels are launched in place, as nested parcels, and the
+/// parcel that carries them is deleted when the last of them is deleted.
+///
 /// @param       buffer The buffer of coalesced parcels.
 /// @param            n The number of coalesced bytes.
 int
 DemultiplexHandler(char* buffer, size_t n) {
-  auto end = buffer + n;
-  while (buffer < end) {
-    auto p = reinterpret_cast<hpx_parcel_t*>(buffer);
-    auto q = parcel_clone(p);
-    parcel_launch(q);
-    buffer += parcel_size(p);
-  }
+  hpx_parcel_t *p = libhpx::self->getCurrentParcel();
+  dbg_assert(hpx_parcel_get_data(p) == buffer && p->size == n);
+  parcel_launch_coalesced(p);
   return HPX_SUCCESS;
 }
-LIBHPX_ACTION(HPX_DEFAULT, HPX_MARSHALLED, Demultiplex, DemultiplexHandler,
-              HPX_POINTER, HPX_SIZE_T);
 
-class CoalescingBuffer {
- public:
-  CoalescingBuffer() : parcels_(), ssync_(), bytes_() {
+// Demultiplex is a compressed action so that the CompressionWrapper compresses
+// coalesced parcels as a batch when compression is enabled.
+LIBHPX_ACTION(HPX_DEFAULT, HPX_MARSHALLED | HPX_COMPRESSED, Demultiplex,
+              DemultiplexHandler, HPX_POINTER, HPX_SIZE_T);
+
+}
+
+CoalescingWrapper::Buffers::Buffers(int ranks)
+    : util::Aligned<HPX_CACHELINE_SIZE>(),
+      lock(),
+      buffers(ranks),
+      active()
+{
+  for (auto& buffer : buffers) {
+    buffer.fat = nullptr;
+    buffer.ssync = nullptr;
+    buffer.bytes = 0;
+    buffer.parcels = 0;
+    buffer.slot = -1;
   }
+}
 
-  void record(hpx_parcel_t *p) {
-    while (auto s = parcel_stack_pop(&p->next)) {
-      parcel_stack_push(&ssync_, s);
-    }
-    parcel_stack_push(&parcels_, p);
-    bytes_ += parcel_size(p);
+CoalescingWrapper::CoalescingWrapper(Network* impl, const config_t *cfg,
+                                     GAS *gas)
+    : NetworkWrapper(impl),
+      util::Aligned<HPX_CACHELINE_SIZE>(),
+      gas_(*gas),
+      parcels_(cfg->coalescing_buffersize),
+      bytes_(cfg->coalescing_bytes),
+      timeout_(cfg->coalescing_timeout),
+      sets_(),
+      next_(0)
+{
+  // One set of buffers for each worker, and one shared set for everyone else.
+  for (int i = 0, e = cfg->threads + 1; i < e; ++i) {
+    sets_.emplace_back(new Buffers(HPX_LOCALITIES));
   }
+  log_net("Created coalescing network\n");
+}
 
-  void finish(hpx_addr_t target, Network* net) {
-    if (!bytes_) return;
-    auto fat = action_new_parcel(Demultiplex, target, 0, 0, 2, NULL, bytes_);
-    char *next = static_cast<char*>(hpx_parcel_get_data(fat));
-    while (auto p = parcel_stack_pop(&parcels_)) {
-      auto n = parcel_size(p);
-      memcpy(next, p, n);
-      parcel_delete(p);
-      next += n;
-    }
-    if (net->send(fat, ssync_)) {
-      throw std::exception();
+CoalescingWrapper::~CoalescingWrapper()
+{
+  for (auto& set : sets_) {
+    for (auto& buffer : set->buffers) {
+      if (buffer.fat) {
+        parcel_delete(buffer.fat);
+      }
     }
   }
+}
 
- private:
-  hpx_parcel_t *parcels_;                       //!< parcels for this rank
-  hpx_parcel_t   *ssync_;                       //!< the continuations
-  unsigned        bytes_;                       //!< the number of bytes
-};
-
-class Coalescing {
- public:
-  Coalescing(std::atomic<unsigned>& c) : c_(c) {
-    c_++;
-  }
-  ~Coalescing() {
-    c_--;
-  }
- private:
-  std::atomic<unsigned>& c_;
-};
+CoalescingWrapper::Buffers&
+CoalescingWrapper::buffers() const
+{
+  unsigned i = (self) ? self->getId() : sets_.size() - 1;
+  return *sets_[std::min(i, unsigned(sets_.size() - 1))];
 }
 
-/// Send parcels from the coalesced network.
 void
-CoalescingWrapper::send(unsigned n) {
-  if (!n)
-    return;
-
-  std::unique_ptr<CoalescingBuffer[]> buffers(new CoalescingBuffer[HPX_LOCALITIES]);
-
-  for (auto i = 0u, e = n; i < e; ++i) {
-    auto p = sends_.dequeue();
-    dbg_assert(p);
-    auto target = gas_.ownerOf(p->target);
-    buffers[target].record(p);
+CoalescingWrapper::send(Buffers& set, int rank)
+{
+  Buffer& buffer = set.buffers[rank];
+  hpx_parcel_t *fat = buffer.fat;
+  hpx_parcel_t *ssync = buffer.ssync;
+
+  // We only send the part of the fat parcel that we've filled.
+  fat->size = buffer.bytes;
+  buffer.fat = nullptr;
+  buffer.ssync = nullptr;
+  buffer.bytes = 0;
+  buffer.parcels = 0;
+
+  // Remove the destination from the active list.
+  int last = set.active.back();
+  set.active[buffer.slot] = last;
+  set.buffers[last].slot = buffer.slot;
+  set.active.pop_back();
+  buffer.slot = -1;
+
+  if (impl_->send(fat, ssync)) {
+    throw std::exception();
   }
+}
 
-  for (auto i = 0, e = HPX_LOCALITIES; i < e; ++i) {
-    buffers[i].finish(HPX_THERE(i), impl_);
+void
+CoalescingWrapper::expire(Buffers& set, bool all)
+{
+  // Iterate backwards because send() moves the last active destination into
+  // the slot that it frees.
+  for (int i = int(set.active.size()) - 1; i >= 0; --i) {
+    int rank = set.active[i];
+    Buffer& buffer = set.buffers[rank];
+    if (all || timeout_ <= hpx_time_elapsed_us(buffer.start)) {
+      send(set, rank);
+    }
   }
 }
 
@@ -122,60 +151,71 @@ CoalescingWrapper::send(hpx_parcel_t *p, hpx_parcel_t *ssync)
   // Prepare the parcel now, 1) to serialize it while its data is probably in
   // our cache and 2) to make sure it gets a pid from the right parent.
   parcel_prepare(p);
-  sends_.enqueue(p);
+  uint32_t n = parcel_coalesced_size(p);
+  if (bytes_ < PARCEL_COALESCED_HEADER + n) {
+    return impl_->send(p, ssync);
+  }
 
-  // Notify the world that there's another parcel in the queue.
-  auto n = 1 + count_++;
+  int rank = gas_.ownerOf(p->target);
+  Buffers& set = buffers();
+  std::lock_guard<std::mutex> _(set.lock);
+  Buffer& buffer = set.buffers[rank];
+  if (buffer.fat && bytes_ < buffer.bytes + n) {
+    send(set, rank);
+  }
 
-  // Coalesce on demand as long as we have enough parcels available.
-  while (size_ < n) {
-    Coalescing _(coalescing_);
-    if (count_.compare_exchange_strong(n, n - size_)) {
-      send(size_);
-      n -= size_;
-    }
+  if (!buffer.fat) {
+    hpx_addr_t target = HPX_THERE(rank);
+    buffer.fat = action_new_parcel(Demultiplex, target, 0, 0, 2, NULL, bytes_);
+    buffer.bytes = PARCEL_COALESCED_HEADER;
+    buffer.start = hpx_time_now();
+    buffer.slot = set.active.size();
+    set.active.push_back(rank);
   }
 
+  // Copy the parcel into place in the fat parcel.
+  parcel_coalesce(hpx_parcel_get_data(buffer.fat), buffer.bytes, p);
+  parcel_delete(p);
+  buffer.bytes += n;
+  while (auto s = parcel_stack_pop(&ssync)) {
+    parcel_stack_push(&buffer.ssync, s);
+  }
+
+  if (++buffer.parcels == parcels_) {
+    send(set, rank);
+  }
   return LIBHPX_OK;
 }
 
 void
-CoalescingWrapper::progress(int n) {
-  // If the number of buffered parcels is the same as the previous time we
-  // progressed, we'll do an eager send operation to reduce latency and make
-  // sure we're not inducing deadlock.
-  unsigned count = count_;
-  if (count == prev_) {
-    Coalescing _(coalescing_);
-    send(count_.exchange(0));
-    count = 0;
+CoalescingWrapper::progress(int n)
+{
+  // Send our own expired buffers, and sweep one other set in case its worker
+  // isn't sending or progressing.
+  Buffers& mine = buffers();
+  if (auto _ = std::unique_lock<std::mutex>(mine.lock, std::try_to_lock)) {
+    expire(mine, false);
+  }
+
+  Buffers& other = *sets_[next_++ % sets_.size()];
+  if (&other != &mine) {
+    if (auto _ = std::unique_lock<std::mutex>(other.lock, std::try_to_lock)) {
+      expire(other, false);
+    }
   }
-  prev_ = count;
+
   NetworkWrapper::progress(n);
 }
 
 void
-CoalescingWrapper::flush() {
+CoalescingWrapper::flush()
+{
   // coalesce the rest of the buffered sends
-  send(count_.exchange(0));
-
-  // wait for any concurrent operations to complete
-  while (coalescing_) { /* spin */; }
+  for (auto& set : sets_) {
+    std::lock_guard<std::mutex> _(set->lock);
+    expire(*set, true);
+  }
 
   // and flush the underlying network
   NetworkWrapper::flush();
 }
-
-CoalescingWrapper::CoalescingWrapper(Network* impl, const config_t *cfg,
-                                     GAS *gas)
-    : NetworkWrapper(impl),
-      util::Aligned<HPX_CACHELINE_SIZE>(),
-      gas_(*gas),
-      size_(cfg->coalescing_buffersize),
-      prev_(0),
-      count_(0),
-      coalescing_(0),
-      sends_()
-{
-  log_net("Created coalescing network\n");
-}
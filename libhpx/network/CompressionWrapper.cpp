@@ -19,18 +19,21 @@
 #include "libhpx/action.h"
 #include "libhpx/libhpx.h"
 #include "libhpx/parcel.h"
+#include "libhpx/Worker.h"
 #include <lz4.h>
-#include <utility>
-
-// TODO:
-// 1. in-place compression and decompression.
-// 2. compression and coalescing.
+#include <algorithm>
+#include <cstring>
 
 namespace {
 using libhpx::Network;
+using libhpx::self;
 using libhpx::network::NetworkWrapper;
 using libhpx::network::CompressionWrapper;
 
+/// We compress every SAMPLE-th parcel for an action, even when we don't expect
+/// compression to pay off, so that its statistics follow its data.
+constexpr uint32_t SAMPLE = 32;
+
 struct Args {
   size_t bytes;
   char data[];
@@ -54,26 +57,107 @@ LIBHPX_ACTION(HPX_DEFAULT, HPX_MARSHALLED, Decompress, DecompressHandler,
               HPX_POINTER, HPX_SIZE_T);
 } // namespace
 
-CompressionWrapper::CompressionWrapper(Network* impl)
-    : NetworkWrapper(impl)
+CompressionWrapper::CompressionWrapper(Network* impl, const config_t *cfg)
+    : NetworkWrapper(impl),
+      minsize_(cfg->parcel_compression_minsize),
+      ratio_(std::min(std::max(cfg->parcel_compression_ratio, 0), 100)),
+      actions_(action_table_size()),
+      stats_(new Stats[actions_]),
+      scratch_()
+{
+  for (int i = 0; i < actions_; ++i) {
+    stats_[i].ratio = 0;
+    stats_[i].skips = 0;
+  }
+
+  // One scratch space for each worker, and one shared one for everyone else.
+  for (int i = 0, e = cfg->threads + 1; i < e; ++i) {
+    scratch_.emplace_back(new Scratch());
+    scratch_.back()->state.reset(new char[LZ4_sizeofState()]);
+    scratch_.back()->bytes = 0;
+  }
+}
+
+CompressionWrapper::Scratch&
+CompressionWrapper::scratch() const
 {
+  unsigned i = (self) ? self->getId() : scratch_.size() - 1;
+  return *scratch_[std::min(i, unsigned(scratch_.size() - 1))];
+}
+
+bool
+CompressionWrapper::shouldCompress(hpx_action_t id, size_t bytes)
+{
+  if (bytes < minsize_ || LZ4_MAX_INPUT_SIZE < bytes) {
+    return false;
+  }
+
+  if (actions_ <= id) {
+    return true;
+  }
+
+  // A ratio of 0 means that we haven't seen this action yet.
+  Stats& stats = stats_[id];
+  uint32_t ratio = stats.ratio.load(std::memory_order_relaxed);
+  if (ratio * 100 <= ratio_ * 256) {
+    return true;
+  }
+  return (stats.skips.fetch_add(1, std::memory_order_relaxed) % SAMPLE == 0);
+}
+
+void
+CompressionWrapper::record(hpx_action_t id, size_t bytes, size_t compressed)
+{
+  if (actions_ <= id) {
+    return;
+  }
+
+  // Keep an exponentially weighted average of the ratio. Concurrent updates
+  // can lose samples, which is fine for an estimate.
+  Stats& stats = stats_[id];
+  uint32_t sample = std::max(uint32_t(compressed * 256 / bytes), 1u);
+  uint32_t ratio = stats.ratio.load(std::memory_order_relaxed);
+  ratio = (ratio) ? (7 * ratio + sample) / 8 : sample;
+  stats.ratio.store(ratio, std::memory_order_relaxed);
 }
 
 int
 CompressionWrapper::send(hpx_parcel_t *p, hpx_parcel_t *ssync)
 {
-  if (action_is_compressed(p->action)) {
-    size_t isize = parcel_size(p);
-    size_t bytes = sizeof(Args) + LZ4_compressBound(isize);
-    hpx_parcel_t *q = parcel_new(p->target, Decompress, 0, 0, p->pid, 0, bytes);
-    auto* args = static_cast<Args*>(hpx_parcel_get_data(q));
-    args->bytes = isize;
-    auto* buffer = reinterpret_cast<char*>(p);
-    if (auto csize = LZ4_compress_fast(buffer, args->data, isize, bytes, 1)) {
-      q->size = sizeof(Args) + csize;
-      std::swap(p, q);
-    }
-    parcel_delete(q);
+  if (!action_is_compressed(p->action)) {
+    return impl_->send(p, ssync);
+  }
+
+  size_t isize = parcel_size(p);
+  if (!shouldCompress(p->action, isize)) {
+    return impl_->send(p, ssync);
+  }
+
+  Scratch& scratch = this->scratch();
+  std::unique_lock<std::mutex> lock(scratch.lock);
+  size_t bound = LZ4_compressBound(isize);
+  if (scratch.bytes < bound) {
+    scratch.buffer.reset(new char[bound]);
+    scratch.bytes = bound;
   }
-  return impl_->send(p, ssync);
+
+  auto* buffer = reinterpret_cast<char*>(p);
+  size_t csize = LZ4_compress_fast_extState(scratch.state.get(), buffer,
+                                            scratch.buffer.get(), isize,
+                                            scratch.bytes, 1);
+  record(p->action, isize, (csize) ? csize : isize);
+  if (!csize || isize <= sizeof(Args) + csize) {
+    lock.unlock();
+    return impl_->send(p, ssync);
+  }
+
+  size_t bytes = sizeof(Args) + csize;
+  hpx_parcel_t *q = parcel_new(p->target, Decompress, 0, 0, p->pid, 0, bytes);
+  auto* args = static_cast<Args*>(hpx_parcel_get_data(q));
+  args->bytes = isize;
+  std::memcpy(args->data, scratch.buffer.get(), csize);
+  lock.unlock();
+
+  parcel_delete(p);
+  return impl_->send(q, ssync);
 }
@@ -21,10 +21,14 @@
 #include "SMPNetwork.h"
 #ifdef HAVE_MPI
 #include "isir/FunneledNetwork.h"
+#include "isir/ThreadedNetwork.h"
 #endif
-#ifdef HAVE_PHOTON
+#ifdef HAVE_PWC
 #include "pwc/PWCNetwork.h"
 #endif
+#ifdef HAVE_SHM
+#include "shm/ShmNetwork.h"
+#endif
 #include "libhpx/debug.h"
 #include "libhpx/instrumentation.h"
 
@@ -38,8 +42,8 @@ using BootNetwork = libhpx::boot::Network;
 
 Network::Network()
     : StringOps(),
-      CollectiveOps(),
       LCOOps(),
+      CollectiveOps(),
       MemoryOps(),
       ParcelOps()
 {
@@ -81,8 +85,18 @@ Network::Create(config_t *cfg, const BootNetwork& boot, GAS *gas)
   }
 
   if (type == HPX_NETWORK_PWC) {
-#ifndef HAVE_PHOTON
-    dbg_error("PWC network selection fails (photon disabled in config)\n");
+#ifndef HAVE_PWC
+    dbg_error("PWC network selection fails (no PWC transport in config)\n");
+#endif
+  }
+
+  // Forked ranks share this node and don't have MPI or Photon.
+  if (type == HPX_NETWORK_DEFAULT && boot.type() == HPX_BOOT_FORK) {
+#ifdef HAVE_SHM
+    type = HPX_NETWORK_SHM;
+#else
+    dbg_error("fork bootstrap requires the SHM network (configure with "
+              "--enable-shm)\n");
 #endif
   }
 
@@ -97,7 +111,7 @@ Network::Create(config_t *cfg, const BootNetwork& boot, GAS *gas)
 
   switch (type) {
    case HPX_NETWORK_PWC:
-#ifdef HAVE_PHOTON
+#ifdef HAVE_PWC
     network = libhpx::network::pwc::PWCNetwork::Create(cfg, boot, gas);
 #else
     log_level(LEVEL, "PWC network unavailable (no network configured)\n");
@@ -106,12 +120,25 @@ Network::Create(config_t *cfg, const BootNetwork& boot, GAS *gas)
 
    case HPX_NETWORK_ISIR:
 #ifdef HAVE_MPI
-    network = new libhpx::network::isir::FunneledNetwork(cfg, gas);
+    if (cfg->isir_threaded) {
+      network = libhpx::network::isir::ThreadedNetwork::Create(cfg, gas);
+    }
+    else {
+      network = new libhpx::network::isir::FunneledNetwork(cfg, gas);
+    }
 #else
     log_level(LEVEL, "ISIR network unavailable (no network configured)\n");
 #endif
     break;
 
+   case HPX_NETWORK_SHM:
+#ifdef HAVE_SHM
+    network = new libhpx::network::shm::ShmNetwork(cfg, boot, gas);
+#else
+    log_level(LEVEL, "SHM network unavailable (no network configured)\n");
+#endif
+    break;
+
    case HPX_NETWORK_SMP:
     network = new SMPNetwork(boot);
     break;
@@ -129,20 +156,23 @@ Network::Create(config_t *cfg, const BootNetwork& boot, GAS *gas)
   }
 
   if (cfg->parcel_compression) {
-    network = new CompressionWrapper(network);
+    network = new CompressionWrapper(network, cfg);
   }
 
   if (cfg->coalescing_buffersize) {
     network = new CoalescingWrapper(network, cfg, gas);
   }
 
-  if (!config_trace_at_isset(here->config, here->rank)) {
-    return network;
+  if (config_trace_at_isset(here->config, here->rank) &&
+      inst_trace_class(HPX_TRACE_NETWORK)) {
+    network = new InstrumentationWrapper(network);
   }
 
-  if (!inst_trace_class(HPX_TRACE_NETWORK)) {
-    return network;
+  // The progress thread is outermost so that it owns all of the progress and
+  // probe calls, including the ones that the other wrappers make.
+  if (cfg->progress_thread && type != HPX_NETWORK_SMP) {
+    network = new ProgressWrapper(network, cfg);
   }
 
-  return new InstrumentationWrapper(network);
+  return network;
 }
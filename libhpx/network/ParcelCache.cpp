@@ -0,0 +1,191 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "libhpx/ParcelCache.h"
+#include "libhpx/debug.h"
+#include "libhpx/memory.h"
+#include "libhpx/Worker.h"
+#include "libhpx/util/math.h"
+#include <new>
+
+namespace {
+using libhpx::self;
+using libhpx::Worker;
+using libhpx::network::ParcelCache;
+}
+
+char* ParcelCache::Base_ = nullptr;
+char* ParcelCache::End_ = nullptr;
+std::atomic<char*> ParcelCache::Next_(nullptr);
+ParcelCache::Cache* ParcelCache::Caches_ = nullptr;
+int ParcelCache::NCaches_ = 0;
+
+void
+ParcelCache::Init(const config_t* cfg)
+{
+  dbg_assert(!Caches_);
+  Base_ = nullptr;
+  End_ = nullptr;
+  if (!cfg->parcel_cachesize) {
+    return;
+  }
+
+  // The per-worker caches live at the base of the region, followed by the
+  // chunks.
+  int n = cfg->threads;
+  size_t header = CHUNK_BYTES * util::ceil_div(n * sizeof(Cache), CHUNK_BYTES);
+  size_t bytes = header + CHUNK_BYTES * util::ceil_div(cfg->parcel_cachesize,
+                                                       CHUNK_BYTES);
+  void* base = as_memalign(AS_REGISTERED, CHUNK_BYTES, bytes);
+  if (!base) {
+    log_mem("could not reserve %zu bytes for the parcel cache\n", bytes);
+    return;
+  }
+
+  Caches_ = static_cast<Cache*>(base);
+  for (int i = 0; i < n; ++i) {
+    new(&Caches_[i]) Cache();
+  }
+  NCaches_ = n;
+
+  Base_ = static_cast<char*>(base);
+  End_ = Base_ + bytes;
+  Next_ = Base_ + header;
+  log_mem("reserved %zu bytes for the parcel cache at %p\n", bytes, base);
+}
+
+void
+ParcelCache::Fini()
+{
+  if (!Caches_) {
+    return;
+  }
+
+  for (int i = 0; i < NCaches_; ++i) {
+    Caches_[i].~Cache();
+  }
+  as_free(AS_REGISTERED, Base_);
+
+  // Keep the region bounds so that blocks that are deleted while the network
+  // is torn down are recognized, and dropped, by Deallocate().
+  Next_ = End_;
+  Caches_ = nullptr;
+  NCaches_ = 0;
+}
+
+void*
+ParcelCache::Allocate(size_t bytes)
+{
+  Worker* w = self;
+  if (!w || !Caches_) {
+    return nullptr;
+  }
+
+  int id = w->getId();
+  int sizeClass = SizeClass(bytes);
+  if (N_CLASSES <= sizeClass || NCaches_ <= id) {
+    return nullptr;
+  }
+
+  Cache& cache = Caches_[id];
+  Block* block = cache.free[sizeClass];
+  if (!block) {
+    block = Refill(cache, id, sizeClass);
+  }
+
+  if (block) {
+    cache.free[sizeClass] = block->next;
+  }
+  return block;
+}
+
+bool
+ParcelCache::Deallocate(void* ptr)
+{
+  char* addr = static_cast<char*>(ptr);
+  if (addr < Base_ || End_ <= addr) {
+    return false;
+  }
+
+  // The region has already been released.
+  if (!Caches_) {
+    return true;
+  }
+
+  Chunk* chunk = ChunkOf(ptr);
+  Block* block = static_cast<Block*>(ptr);
+  Cache& cache = Caches_[chunk->owner];
+
+  Worker* w = self;
+  if (w && w->getId() == chunk->owner) {
+    block->next = cache.free[chunk->sizeClass];
+    cache.free[chunk->sizeClass] = block;
+    return true;
+  }
+
+  // Only the owner ever removes blocks from the remote list, and it always
+  // takes the entire list at once, so this push is ABA-safe.
+  block->next = cache.remote.load(std::memory_order_relaxed);
+  while (!cache.remote.compare_exchange_weak(block->next, block,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+  }
+  return true;
+}
+
+ParcelCache::Block*
+ParcelCache::Refill(Cache& cache, int owner, int sizeClass)
+{
+  // Reclaim everything that has been freed remotely.
+  Block* remote = cache.remote.exchange(nullptr, std::memory_order_acquire);
+  while (remote) {
+    Block* next = remote->next;
+    int c = ChunkOf(remote)->sizeClass;
+    remote->next = cache.free[c];
+    cache.free[c] = remote;
+    remote = next;
+  }
+
+  if (Block* block = cache.free[sizeClass]) {
+    return block;
+  }
+
+  // Carve a new chunk out of the region. Once the region is exhausted we don't
+  // bump the next pointer anymore, which keeps it from overflowing.
+  if (End_ <= Next_.load(std::memory_order_relaxed)) {
+    return nullptr;
+  }
+
+  char* base = Next_.fetch_add(CHUNK_BYTES, std::memory_order_relaxed);
+  if (End_ <= base) {
+    log_mem("parcel cache exhausted, falling back to the registered heap\n");
+    return nullptr;
+  }
+
+  new(base) Chunk{owner, sizeClass};
+
+  // Thread the blocks onto the freelist so that they are allocated in address
+  // order. The first cacheline holds the chunk header.
+  size_t size = HPX_CACHELINE_SIZE * (sizeClass + 1);
+  char* first = base + HPX_CACHELINE_SIZE;
+  for (size_t i = (CHUNK_BYTES - HPX_CACHELINE_SIZE) / size; i > 0; --i) {
+    Block* block = reinterpret_cast<Block*>(first + (i - 1) * size);
+    block->next = cache.free[sizeClass];
+    cache.free[sizeClass] = block;
+  }
+  return cache.free[sizeClass];
+}
@@ -18,16 +18,77 @@
 #include "libhpx/ParcelStringOps.h"
 #include "libhpx/action.h"
 #include "libhpx/debug.h"
+#include "libhpx/libhpx.h"
 #include "libhpx/parcel.h"
 #include <algorithm>
+#include <vector>
 
 namespace {
 using libhpx::network::ParcelStringOps;
 
+/// Check to see if a transfer is large enough to be pipelined.
+///
+/// Large memget and memput operations are split into chunks of
+/// --hpx-network-chunksize bytes, so that neither side needs a parcel the size
+/// of the whole transfer, and so that several chunks can be in flight at once.
+bool
+IsChunked(size_t n)
+{
+  size_t chunk = here->config->network_chunksize;
+  return (chunk && chunk < n);
+}
+
+/// A sliding window of in-flight chunks.
+///
+/// Each chunk in the window is tracked by a future, and the futures are
+/// recycled once the chunk that is using them completes.
+class ChunkWindow {
+ public:
+  ChunkWindow() : futures_(std::max(here->config->network_chunkwindow, 1u)),
+                  n_(0)
+  {
+    for (auto& f : futures_) {
+      f = hpx_lco_future_new(0);
+    }
+  }
+
+  ~ChunkWindow() {
+    wait();
+    for (auto f : futures_) {
+      hpx_lco_delete_sync(f);
+    }
+  }
+
+  /// Get the future for the next chunk, waiting for a slot if necessary.
+  hpx_addr_t next() {
+    hpx_addr_t f = futures_[n_ % futures_.size()];
+    if (futures_.size() <= n_) {
+      hpx_lco_wait_reset(f);
+    }
+    ++n_;
+    return f;
+  }
+
+  /// Wait for all of the chunks in the window to complete.
+  void wait() {
+    size_t i = (futures_.size() < n_) ? n_ - futures_.size() : 0;
+    for (; i < n_; ++i) {
+      hpx_lco_wait_reset(futures_[i % futures_.size()]);
+    }
+    n_ = 0;
+  }
+
+ private:
+  std::vector<hpx_addr_t> futures_;
+  size_t n_;
+};
+
 class ParcelMemget {
   static HPX_ACTION_DECL(Request);
   static HPX_ACTION_DECL(Reply);
   static HPX_ACTION_DECL(Sync);
+  static HPX_ACTION_DECL(Chunk);
+  static HPX_ACTION_DECL(Pipeline);
 
   struct ReplyArgs {
     char  *to;
@@ -63,6 +124,39 @@ class ParcelMemget {
     return hpx_thread_continue(from, n);
   }
 
+  static int
+  ChunkHandler(const char *from, size_t offset, char *to, size_t n,
+               hpx_addr_t lsync)
+  {
+    return RequestHandler(from + offset, to, n, lsync);
+  }
+
+  /// Get a large region in chunks, each of which is replied to directly into
+  /// its place in the destination.
+  static void
+  Chunked(char *to, hpx_addr_t from, size_t n)
+  {
+    size_t chunk = here->config->network_chunksize;
+    ChunkWindow window;
+    for (size_t offset = 0; offset < n; offset += chunk) {
+      size_t bytes = std::min(chunk, n - offset);
+      char *dest = to + offset;
+      hpx_addr_t lsync = window.next();
+      hpx_call(from, Chunk, HPX_NULL, &offset, &dest, &bytes, &lsync);
+    }
+    window.wait();
+  }
+
+  static int
+  PipelineHandler(char *to, hpx_addr_t from, size_t n, hpx_addr_t lsync,
+                  hpx_addr_t rsync)
+  {
+    Chunked(to, from, n);
+    hpx_lco_set(lsync, 0, NULL, HPX_NULL, HPX_NULL);
+    hpx_lco_set(rsync, 0, NULL, HPX_NULL, HPX_NULL);
+    return HPX_SUCCESS;
+  }
+
  public:
   ParcelMemget() {
     LIBHPX_REGISTER_ACTION(HPX_DEFAULT, HPX_MARSHALLED, Reply, ReplyHandler,
@@ -71,12 +165,24 @@ class ParcelMemget {
                            HPX_POINTER, HPX_POINTER, HPX_SIZE_T, HPX_ADDR);
     LIBHPX_REGISTER_ACTION(HPX_INTERRUPT, HPX_PINNED, Sync, SyncHandler,
                            HPX_POINTER, HPX_SIZE_T);
+    LIBHPX_REGISTER_ACTION(HPX_DEFAULT, HPX_PINNED, Chunk, ChunkHandler,
+                           HPX_POINTER, HPX_SIZE_T, HPX_POINTER, HPX_SIZE_T,
+                           HPX_ADDR);
+    LIBHPX_REGISTER_ACTION(HPX_DEFAULT, 0, Pipeline, PipelineHandler,
+                           HPX_POINTER, HPX_ADDR, HPX_SIZE_T, HPX_ADDR,
+                           HPX_ADDR);
   }
 
   void
   operator()(void *dest, hpx_addr_t from, size_t size, hpx_addr_t lsync,
              hpx_addr_t rsync)
   {
+    if (IsChunked(size)) {
+      hpx_call(HPX_HERE, Pipeline, HPX_NULL, &dest, &from, &size, &lsync,
+               &rsync);
+      return;
+    }
+
     hpx_action_t op  = Request;
     hpx_action_t rop = hpx_lco_set_action;
     action_call_lsync(op, from, rsync, rop, 3, &dest, &size, &lsync);
@@ -85,6 +191,12 @@ class ParcelMemget {
   void
   operator()(void *dest, hpx_addr_t from, size_t size, hpx_addr_t lsync)
   {
+    if (IsChunked(size)) {
+      Chunked(static_cast<char*>(dest), from, size);
+      hpx_lco_set(lsync, 0, NULL, HPX_NULL, HPX_NULL);
+      return;
+    }
+
     hpx_addr_t rsync = hpx_lco_future_new(0);
     operator()(dest, from, size, lsync, rsync);
     hpx_lco_wait(rsync);
@@ -94,6 +206,11 @@ class ParcelMemget {
   void
   operator()(void *dest, hpx_addr_t from, size_t size)
   {
+    if (IsChunked(size)) {
+      Chunked(static_cast<char*>(dest), from, size);
+      return;
+    }
+
     action_call_rsync(Sync, from, dest, size, 1, &size);
   }
 } get;
@@ -101,9 +218,18 @@ class ParcelMemget {
 HPX_ACTION_DECL(ParcelMemget::Request) = 0;
 HPX_ACTION_DECL(ParcelMemget::Reply) = 0;
 HPX_ACTION_DECL(ParcelMemget::Sync) = 0;
+HPX_ACTION_DECL(ParcelMemget::Chunk) = 0;
+HPX_ACTION_DECL(ParcelMemget::Pipeline) = 0;
 
 class ParcelMemput {
   static HPX_ACTION_DECL(Async);
+  static HPX_ACTION_DECL(Chunk);
+  static HPX_ACTION_DECL(Pipeline);
+
+  struct ChunkArgs {
+    size_t offset;
+    char data[];
+  };
 
   static int
   AsyncHandler(char *dest, const char *from, size_t n)
@@ -111,16 +237,68 @@ class ParcelMemput {
     std::copy(from, from + n, dest);
     return HPX_SUCCESS;
   }
+
+  static int
+  ChunkHandler(char *dest, const ChunkArgs& args, size_t n)
+  {
+    std::copy(args.data, args.data + n - sizeof(ChunkArgs), dest + args.offset);
+    return HPX_SUCCESS;
+  }
+
+  /// Put a large region in chunks, with at most a window's worth of chunk
+  /// parcels allocated at any time.
+  ///
+  /// @returns          After the last chunk has been copied out of @p from.
+  static void
+  Launch(hpx_addr_t dest, const char *from, size_t n, ChunkWindow& window)
+  {
+    size_t chunk = here->config->network_chunksize;
+    hpx_action_t set = hpx_lco_set_action;
+    hpx_pid_t pid = hpx_thread_current_pid();
+    for (size_t offset = 0; offset < n; offset += chunk) {
+      size_t bytes = std::min(chunk, n - offset);
+      hpx_addr_t rsync = window.next();
+      auto p = parcel_new(dest, Chunk, rsync, set, pid, NULL,
+                          sizeof(ChunkArgs) + bytes);
+      auto args = static_cast<ChunkArgs*>(hpx_parcel_get_data(p));
+      args->offset = offset;
+      std::copy(from + offset, from + offset + bytes, args->data);
+      parcel_launch(p);
+    }
+  }
+
+  static int
+  PipelineHandler(hpx_addr_t dest, const char *from, size_t n,
+                  hpx_addr_t lsync, hpx_addr_t rsync)
+  {
+    ChunkWindow window;
+    Launch(dest, from, n, window);
+    hpx_lco_set(lsync, 0, NULL, HPX_NULL, HPX_NULL);
+    window.wait();
+    hpx_lco_set(rsync, 0, NULL, HPX_NULL, HPX_NULL);
+    return HPX_SUCCESS;
+  }
+
  public:
   ParcelMemput() {
     LIBHPX_REGISTER_ACTION(HPX_INTERRUPT, HPX_PINNED | HPX_MARSHALLED, Async,
                            AsyncHandler, HPX_POINTER, HPX_POINTER, HPX_SIZE_T);
+    LIBHPX_REGISTER_ACTION(HPX_INTERRUPT, HPX_PINNED | HPX_MARSHALLED, Chunk,
+                           ChunkHandler, HPX_POINTER, HPX_POINTER, HPX_SIZE_T);
+    LIBHPX_REGISTER_ACTION(HPX_DEFAULT, 0, Pipeline, PipelineHandler, HPX_ADDR,
+                           HPX_POINTER, HPX_SIZE_T, HPX_ADDR, HPX_ADDR);
   }
 
   void
   operator()(hpx_addr_t dest, const void *from, size_t size, hpx_addr_t lsync,
              hpx_addr_t rsync)
   {
+    if (IsChunked(size)) {
+      hpx_call(HPX_HERE, Pipeline, HPX_NULL, &dest, &from, &size, &lsync,
+               &rsync);
+      return;
+    }
+
     hpx_action_t set = hpx_lco_set_action;
     action_call_async(Async, dest, lsync, set, rsync, set, 2, from, size);
   }
@@ -128,6 +306,14 @@ class ParcelMemput {
   void
   operator()(hpx_addr_t dest, const void *from, size_t size, hpx_addr_t rsync)
   {
+    if (IsChunked(size)) {
+      ChunkWindow window;
+      Launch(dest, static_cast<const char*>(from), size, window);
+      window.wait();
+      hpx_lco_set(rsync, 0, NULL, HPX_NULL, HPX_NULL);
+      return;
+    }
+
     hpx_action_t set = hpx_lco_set_action;
     action_call_lsync(Async, dest, rsync, set, 2, from, size);
   }
@@ -135,10 +321,18 @@ class ParcelMemput {
   void
   operator()(hpx_addr_t dest, const void *from, size_t size)
   {
+    if (IsChunked(size)) {
+      ChunkWindow window;
+      Launch(dest, static_cast<const char*>(from), size, window);
+      return;
+    }
+
     action_call_rsync(Async, dest, NULL, 0, 2, from, size);
   }
 } put;
 HPX_ACTION_DECL(ParcelMemput::Async) = 0;
+HPX_ACTION_DECL(ParcelMemput::Chunk) = 0;
+HPX_ACTION_DECL(ParcelMemput::Pipeline) = 0;
 
 class ParcelMemcpy {
   static HPX_ACTION_DECL(Request);
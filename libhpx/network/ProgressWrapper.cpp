@@ -0,0 +1,155 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "Wrappers.h"
+#include "libhpx/Scheduler.h"
+#include "libhpx/debug.h"
+#include "libhpx/locality.h"
+#include "libhpx/memory.h"
+#include "libhpx/parcel.h"
+#include "libhpx/system.h"
+
+namespace {
+using libhpx::Scheduler;
+using libhpx::network::NetworkWrapper;
+using libhpx::network::ProgressWrapper;
+}
+
+ProgressWrapper::ProgressWrapper(Network* impl, const config_t *cfg)
+    : NetworkWrapper(impl),
+      util::Aligned<HPX_CACHELINE_SIZE>(),
+      sends_(),
+      flushLock_(),
+      flushed_(),
+      flushRequests_(0),
+      flushes_(0),
+      stop_(false),
+      thread_(&ProgressWrapper::run, this, cfg->progress_cpu)
+{
+  log_net("started the network progress thread\n");
+}
+
+ProgressWrapper::~ProgressWrapper()
+{
+  stop_.store(true, std::memory_order_release);
+  thread_.join();
+  while (hpx_parcel_t *p = sends_.dequeue()) {
+    hpx_parcel_t *ssync = p->next;
+    p->next = NULL;
+    while (hpx_parcel_t *q = parcel_stack_pop(&ssync)) {
+      parcel_delete(q);
+    }
+    parcel_delete(p);
+  }
+}
+
+void
+ProgressWrapper::run(int cpu)
+{
+  // The progress thread allocates the parcels that it receives.
+  as_join(AS_REGISTERED);
+  as_join(AS_GLOBAL);
+  as_join(AS_CYCLIC);
+
+  if (system_set_progress_affinity(cpu)) {
+    log_error("failed to bind the progress thread to cpu %d\n", cpu);
+  }
+
+  // Sends and completions are always driven, because the sends that stop an
+  // epoch can be enqueued after our scheduler has stopped. Received parcels
+  // are only probed while the scheduler is running, like the workers would.
+  while (!stop_.load(std::memory_order_acquire)) {
+    handleFlush();
+
+    Scheduler* sched = here->sched;
+    if (!sched) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    sendAll();
+    impl_->progress(0);
+    if (sched->getState() != Scheduler::RUN) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    hpx_parcel_t *stack = impl_->probe(0);
+    while (hpx_parcel_t *p = parcel_stack_pop(&stack)) {
+      sched->spawn(p);
+    }
+  }
+
+  as_leave();
+}
+
+void
+ProgressWrapper::sendAll()
+{
+  // The ssync continuation travels in the parcel's next pointer, like in the
+  // threaded ISIR network.
+  while (hpx_parcel_t *p = sends_.dequeue()) {
+    hpx_parcel_t *ssync = p->next;
+    p->next = NULL;
+    dbg_check(impl_->send(p, ssync), "failed to perform a network send\n");
+  }
+}
+
+void
+ProgressWrapper::handleFlush()
+{
+  // Read the request count first, so that every send that was enqueued before
+  // a flush() call is injected before we report that call as handled.
+  uint64_t requests = flushRequests_.load(std::memory_order_acquire);
+  if (requests == flushes_) {
+    return;
+  }
+
+  sendAll();
+  impl_->flush();
+
+  std::lock_guard<std::mutex> _(flushLock_);
+  flushes_ = requests;
+  flushed_.notify_all();
+}
+
+void
+ProgressWrapper::progress(int)
+{
+}
+
+hpx_parcel_t*
+ProgressWrapper::probe(int)
+{
+  return NULL;
+}
+
+void
+ProgressWrapper::flush()
+{
+  std::unique_lock<std::mutex> _(flushLock_);
+  uint64_t ticket = flushRequests_.fetch_add(1, std::memory_order_acq_rel) + 1;
+  flushed_.wait(_, [&]() { return ticket <= flushes_; });
+}
+
+int
+ProgressWrapper::send(hpx_parcel_t *p, hpx_parcel_t *ssync)
+{
+  p->next = ssync;
+  sends_.enqueue(p);
+  return 0;
+}
@@ -18,6 +18,11 @@
 #include "libhpx/util/Aligned.h"
 #include "libhpx/util/TwoLockQueue.h"
 #include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace libhpx {
 namespace network {
@@ -124,30 +129,146 @@ class InstrumentationWrapper final : public NetworkWrapper {
   int send(hpx_parcel_t* p, hpx_parcel_t* ssync);
 };
 
+/// A network wrapper that compresses the parcels for compressed actions.
+///
+/// Coalesced parcels are compressed as a batch. Each action keeps a running
+/// estimate of how well its parcels compress, and parcels are sent without
+/// compression while that estimate says that compression won't pay off, with
+/// an occasional sample to keep the estimate current. Parcels are compressed
+/// into per-worker scratch buffers, so we only allocate a parcel to send when
+/// compression succeeds.
 class CompressionWrapper final : public NetworkWrapper {
  public:
-  CompressionWrapper(Network* impl);
+  CompressionWrapper(Network* impl, const config_t *cfg);
   int send(hpx_parcel_t* p, hpx_parcel_t* ssync);
+
+ private:
+  /// The running statistics for one action.
+  struct Stats {
+    std::atomic<uint32_t> ratio;                //!< compressed size in 1/256ths
+    std::atomic<uint32_t> skips;                //!< sends since the last sample
+  };
+
+  /// The compression state and output buffer for one worker.
+  struct Scratch : util::Aligned<HPX_CACHELINE_SIZE> {
+    std::mutex                 lock;
+    std::unique_ptr<char[]>   state;
+    std::unique_ptr<char[]>  buffer;
+    size_t                    bytes;
+  };
+
+  /// Check to see if a parcel for action @p id should be compressed.
+  bool shouldCompress(hpx_action_t id, size_t bytes);
+
+  /// Update the statistics for action @p id with a compression result.
+  void record(hpx_action_t id, size_t bytes, size_t compressed);
+
+  /// Select the scratch space for the current worker.
+  Scratch& scratch() const;
+
+  const size_t                       minsize_;
+  const uint32_t                       ratio_;
+  const int                          actions_;
+  std::unique_ptr<Stats[]>             stats_;
+  std::vector<std::unique_ptr<Scratch>> scratch_;
 };
 
+/// A network wrapper that coalesces small parcels to the same destination.
+///
+/// Each worker has its own set of append buffers, one per destination, so
+/// workers don't contend with each other when they send. Parcels are copied
+/// into a fat parcel for their destination when they are sent, and the fat
+/// parcel is sent when it holds --hpx-coalescing-buffersize parcels, when the
+/// next parcel won't fit in --hpx-coalescing-bytes, or when its first parcel
+/// has waited for --hpx-coalescing-timeout microseconds.
 class CoalescingWrapper final : public NetworkWrapper,
                                 public util::Aligned<HPX_CACHELINE_SIZE>
 {
  public:
   CoalescingWrapper(Network* impl, const config_t *cfg, GAS *gas);
+  ~CoalescingWrapper();
   void progress(int n);
   void flush();
   int send(hpx_parcel_t* p, hpx_parcel_t* ssync);
 
  private:
-  void send(unsigned n);
+  /// The fat parcel that is being filled for one destination.
+  struct Buffer {
+    hpx_parcel_t   *fat;                        //!< the parcel being filled
+    hpx_parcel_t *ssync;                        //!< the continuations
+    uint32_t      bytes;                        //!< the bytes used in fat
+    uint32_t    parcels;                        //!< the parcels in fat
+    int            slot;                        //!< the index in active
+    hpx_time_t    start;                        //!< the first append time
+  };
+
+  /// The buffers for one worker.
+  struct Buffers : public util::Aligned<HPX_CACHELINE_SIZE> {
+    explicit Buffers(int ranks);
+
+    std::mutex            lock;                 //!< held by the owner
+    std::vector<Buffer> buffers;                //!< one per destination
+    std::vector<int>     active;                //!< non-empty destinations
+  };
+
+  /// Get the buffers for the current worker.
+  Buffers& buffers() const;
+
+  /// Send the fat parcel for a destination.
+  void send(Buffers& buffers, int rank);
+
+  /// Send the fat parcels that have timed out, or all of them.
+  void expire(Buffers& buffers, bool all);
 
   GAS& gas_;
-  const unsigned size_;
-  std::atomic<unsigned> prev_;
-  std::atomic<unsigned> count_;
-  std::atomic<unsigned> coalescing_;
-  util::TwoLockQueue<hpx_parcel_t*> sends_;
+  const uint32_t parcels_;
+  const uint32_t bytes_;
+  const uint64_t timeout_;
+  std::vector<std::unique_ptr<Buffers>> sets_;
+  std::atomic<unsigned> next_;                  //!< the next set to sweep
+};
+
+/// A network wrapper that drives the network from a dedicated thread.
+///
+/// The progress thread makes all of the progress and probe calls, and hands
+/// the parcels that it receives to the workers through their mailboxes, so
+/// communication keeps moving while every worker is busy. Workers enqueue
+/// their sends for the progress thread to inject rather than calling the
+/// network directly. The thread is bound to --hpx-progress-cpu if it is set.
+/// Since the underlying network isn't thread safe in this mode, flush() asks
+/// the progress thread to flush and waits for it rather than touching the
+/// network itself.
+class ProgressWrapper final : public NetworkWrapper,
+                              public util::Aligned<HPX_CACHELINE_SIZE>
+{
+ public:
+  ProgressWrapper(Network* impl, const config_t *cfg);
+  ~ProgressWrapper();
+
+  void progress(int n);
+  hpx_parcel_t* probe(int n);
+  void flush();
+  int send(hpx_parcel_t* p, hpx_parcel_t* ssync);
+
+ private:
+  using ParcelQueue = libhpx::util::TwoLockQueue<hpx_parcel_t*>;
+
+  /// The progress thread's main loop.
+  void run(int cpu);
+
+  /// Inject all of the pending sends into the network.
+  void sendAll();
+
+  /// Flush the network on behalf of callers waiting in flush().
+  void handleFlush();
+
+  ParcelQueue                  sends_;          //!< sends to inject
+  std::mutex               flushLock_;          //!< protects flushes_
+  std::condition_variable    flushed_;          //!< signals flushes_
+  std::atomic<uint64_t> flushRequests_;         //!< flush() calls so far
+  uint64_t                   flushes_;          //!< requests handled so far
+  std::atomic<bool>             stop_;          //!< tell the thread to stop
+  std::thread                 thread_;          //!< the progress thread
 };
 
 } // namespace network
@@ -93,6 +93,7 @@ void hpx_parcel_set_action(hpx_parcel_t *p, hpx_action_t action) {
 
 void hpx_parcel_set_target(hpx_parcel_t *p, hpx_addr_t addr) {
   p->target = addr;
+  p->affinity = 0;
 }
 
 void hpx_parcel_set_cont_action(hpx_parcel_t *p, hpx_action_t action) {
@@ -22,6 +22,7 @@
 
 namespace {
 using libhpx::Network;
+using libhpx::network::ParcelLCOOps;
 using libhpx::network::ParcelStringOps;
 using libhpx::network::isir::FunneledNetwork;
 }
@@ -29,6 +30,7 @@ using libhpx::network::isir::FunneledNetwork;
 FunneledNetwork::FunneledNetwork(const config_t *cfg, GAS *gas)
     : Network(),
       ParcelStringOps(),
+      ParcelLCOOps(),
       util::Aligned<HPX_CACHELINE_SIZE>(),
       sends_(),
       recvs_(),
@@ -120,6 +122,8 @@ FunneledNetwork::deallocate(const hpx_parcel_t* p)
 
 int
 FunneledNetwork::send(hpx_parcel_t *p, hpx_parcel_t *ssync) {
+  isends_.wait(p);
+
   // Use the unused parcel-next pointer to get the ssync continuation parcels
   // through the concurrent queue, along with the primary parcel.
   p->next = ssync;
@@ -18,6 +18,7 @@
 #include "IRecvBuffer.h"
 #include "ISendBuffer.h"
 #include "MPITransport.h"
+#include "libhpx/ParcelLCOOps.h"
 #include "libhpx/ParcelStringOps.h"
 #include "libhpx/util/Aligned.h"
 #include "libhpx/util/TwoLockQueue.h"
@@ -27,6 +28,7 @@ namespace libhpx {
 namespace network {
 namespace isir {
 class FunneledNetwork : public Network, public ParcelStringOps,
+                        public ParcelLCOOps,
                         public util::Aligned<HPX_CACHELINE_SIZE>
 {
  public:
@@ -44,9 +46,6 @@ class FunneledNetwork : public Network, public ParcelStringOps,
   void pin(const void *base, size_t bytes, void *key);
   void unpin(const void *base, size_t bytes);
 
-  int wait(hpx_addr_t lco, int reset);
-  int get(hpx_addr_t lco, size_t n, void *to, int reset);
-
   int init(void **collective);
   int sync(void *in, size_t in_size, void* out, void *collective);
 
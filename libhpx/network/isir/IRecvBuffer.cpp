@@ -18,7 +18,9 @@
 #include "IRecvBuffer.h"
 #include "parcel_utils.h"
 #include "libhpx/events.h"
+#include "libhpx/memory.h"
 #include "libhpx/parcel.h"
+#include <cstring>
 #include <memory>
 #include <libhpx/Topology.h>
 #ifdef HAVE_APEX
@@ -31,6 +33,11 @@ using libhpx::network::isir::IRecvBuffer;
 
 IRecvBuffer::IRecvBuffer(const config_t *cfg, Transport &xport)
     : xport_(xport),
+      eagerSize_((cfg->isir_eagersize + HPX_CACHELINE_SIZE - 1) &
+                 ~(HPX_CACHELINE_SIZE - 1)),
+      eagerCount_(cfg->isir_eagerring),
+      eager_(nullptr),
+      eagerRequests_(nullptr),
       limit_(cfg->isir_recvlimit),
       capacity_(0),
       size_(0),
@@ -38,10 +45,32 @@ IRecvBuffer::IRecvBuffer(const config_t *cfg, Transport &xport)
       records_(nullptr)
 {
   reserve((limit_) ? std::min(64u, limit_) : 64u);
+
+  if (eagerCount_) {
+    size_t bytes = size_t(eagerCount_) * eagerSize_;
+    eager_ = static_cast<char*>(as_memalign(AS_REGISTERED, HPX_CACHELINE_SIZE,
+                                            bytes));
+    xport_.pin(eager_, bytes, nullptr);
+    eagerRequests_ = new Request[eagerCount_];
+    for (unsigned i = 0; i < eagerCount_; ++i) {
+      startEager(i);
+    }
+  }
 }
 
 IRecvBuffer::~IRecvBuffer()
 {
+  if (eagerCount_) {
+    for (unsigned i = 0; i < eagerCount_; ++i) {
+      if (!xport_.cancel(eagerRequests_[i])) {
+        log_net("dropped an eager recv during shutdown\n");
+      }
+    }
+    delete [] eagerRequests_;
+    xport_.unpin(eager_, size_t(eagerCount_) * eagerSize_);
+    as_free(AS_REGISTERED, eager_);
+  }
+
   hpx_parcel_t *chain = reserve(0);
   while (hpx_parcel_t *p = parcel_stack_pop(&chain)) {
     parcel_delete(p);
@@ -52,6 +81,7 @@ int
 IRecvBuffer::progress(hpx_parcel_t** stack)
 {
   assert(stack);
+  int n = progressEager(stack);
   probe();
   std::unique_ptr<int[]> out(new int[size_]);
   std::unique_ptr<Status[]> statuses(new Status[size_]);
@@ -63,6 +93,50 @@ IRecvBuffer::progress(hpx_parcel_t** stack)
     parcel_stack_push(stack, p);
     start(out[i]);
   }
+  return n + e;
+}
+
+void
+IRecvBuffer::startEager(unsigned i)
+{
+  char* buffer = eager_ + size_t(i) * eagerSize_;
+  eagerRequests_[i] = xport_.irecv(buffer, eagerSize_, ISIR_EAGER_TAG);
+}
+
+int
+IRecvBuffer::progressEager(hpx_parcel_t** stack)
+{
+  if (!eagerCount_) {
+    return 0;
+  }
+
+  std::unique_ptr<int[]> out(new int[eagerCount_]);
+  std::unique_ptr<Status[]> statuses(new Status[eagerCount_]);
+  int e = xport_.Testsome(eagerCount_, eagerRequests_, &out[0], &statuses[0]);
+  for (int i = 0; i < e; ++i) {
+    // Copy the message into a parcel from the parcel allocator, and give the
+    // buffer back to MPI right away.
+    unsigned j = out[i];
+    int bytes = xport_.bytes(statuses[i]);
+    uint32_t size = isir_bytes_to_payload_size(bytes);
+    hpx_parcel_t *p = parcel_alloc(size);
+    std::memcpy(isir_network_offset(p), eager_ + size_t(j) * eagerSize_,
+                bytes);
+    p->thread = nullptr;
+    p->next = nullptr;
+    p->state = PARCEL_SERIALIZED;
+    p->size = size;
+    p->src = xport_.source(statuses[i]);
+    startEager(j);
+
+    log_net("finished an eager recv for a %u-byte payload\n", p->size);
+    EVENT_NETWORK_RECV();
+#ifdef HAVE_APEX
+    apex_recv(p->id, p->size, p->src, topo_value_to_worker(p->id)+1);
+#endif
+    EVENT_PARCEL_RECV(p->id, p->action, p->size, p->src, p->target);
+    parcel_stack_push(stack, p);
+  }
   return e;
 }
 
@@ -113,8 +187,9 @@ IRecvBuffer::start(unsigned i)
 void
 IRecvBuffer::probe()
 {
+  // Eager messages will match a preposted receive once it is reposted.
   int tag = xport_.iprobe();
-  if (tag < 0) {
+  if (tag < 0 || tag == ISIR_EAGER_TAG) {
     return;
   }
 
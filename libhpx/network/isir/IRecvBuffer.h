@@ -22,6 +22,14 @@ namespace libhpx {
 namespace network {
 namespace isir {
 
+/// The receive side of the isir network.
+///
+/// Messages are received in one of two ways. Small messages can be sent with
+/// the eager tag, which matches a ring of preposted fixed-size receives. These
+/// are copied into right-sized parcels and the receive is immediately reposted,
+/// so they cost neither a probe nor a new irecv. All other messages are
+/// discovered with MPI_Iprobe, and we post a right-sized irecv for each of
+/// them based on the size encoded in their tag.
 class IRecvBuffer {
  public:
   using Transport = libhpx::network::isir::MPITransport;
@@ -86,7 +94,21 @@ class IRecvBuffer {
   /// parcel.
   hpx_parcel_t* finish(unsigned i, const Status& status);
 
+  /// Start the preposted eager receive for slot @p i of the ring.
+  void startEager(unsigned i);
+
+  /// Test the eager ring, turning any completed receives into parcels.
+  ///
+  /// @param[out]   stack The stack of received parcels.
+  ///
+  /// @returns            The number of completed receives.
+  int progressEager(hpx_parcel_t** stack);
+
   Transport              &xport_;
+  const unsigned      eagerSize_;               //!< bytes per eager buffer
+  const unsigned     eagerCount_;               //!< eager buffers in the ring
+  char*                  eager_;                //!< the eager buffers
+  Request*       eagerRequests_;                //!< the eager receives
   const unsigned          limit_;
   unsigned             capacity_;
   unsigned                 size_;
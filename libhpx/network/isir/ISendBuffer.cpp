@@ -18,6 +18,8 @@
 #include "ISendBuffer.h"
 #include "parcel_utils.h"
 #include "libhpx/debug.h"
+#include "libhpx/locality.h"
+#include "libhpx/Worker.h"
 #include "hpx/builtins.h"
 #include <exception>
 #include <memory>
@@ -131,9 +133,9 @@ ISendBuffer::start(unsigned long id)
   unsigned i = _index_of(id, size_);
   hpx_parcel_t *p = records_[i].parcel;
   void *from = isir_network_offset(p);
-  unsigned to = gas_.ownerOf(p->target);
+  unsigned to = records_[i].rank;
   unsigned n = payload_size_to_isir_bytes(p->size);
-  int tag = PayloadSizeToTag(p->size);
+  int tag = (n <= eager_) ? ISIR_EAGER_TAG : PayloadSizeToTag(p->size);
   log_net("starting a parcel send: tag %d, %d bytes\n", tag, n);
   requests_[i] = xport_.isend(to, from, n, tag);
 }
@@ -177,7 +179,15 @@ ISendBuffer::testRange(unsigned i, unsigned n, int* out, hpx_parcel_t **ssync)
     unsigned k = out[j];
     assert(i <= k && k < i + n);
 
-    // handle each of the completed requests
+    // handle each of the completed requests, returning the send credit to
+    // the peer that we sent to, which may no longer own the target
+    if (credits_) {
+      unsigned to = records_[k].rank;
+      if (peers_[to].credits++ == 0 && !peers_[to].held.empty()) {
+        returned_.push_back(to);
+      }
+      queued_[to].fetch_sub(1, std::memory_order_release);
+    }
     parcel_delete(records_[k].parcel);
     while (hpx_parcel_t *p = parcel_stack_pop(&records_[k].ssync)) {
       parcel_stack_push(ssync, p);
@@ -274,12 +284,23 @@ ISendBuffer::cancelAll()
   for (unsigned long id = min_, e = active_; id < e; ++id) {
     cancel(id, &p);
   }
+  for (auto& peer : peers_) {
+    for (auto& record : peer.held) {
+      parcel_stack_push(&p, record.parcel);
+      while (hpx_parcel_t *q = parcel_stack_pop(&record.ssync)) {
+        parcel_stack_push(&p, q);
+      }
+    }
+    peer.held.clear();
+  }
+  held_ = 0;
   return p;
 }
 
 ISendBuffer::ISendBuffer(const config_t *cfg, GAS *gas, Transport &xport)
     : gas_(*gas),
       xport_(xport),
+      eager_((cfg->isir_eagerring) ? cfg->isir_eagersize : 0),
       limit_(cfg->isir_sendlimit),
       twin_(cfg->isir_testwindow),
       size_(0),
@@ -287,9 +308,20 @@ ISendBuffer::ISendBuffer(const config_t *cfg, GAS *gas, Transport &xport)
       active_(0),
       max_(0),
       requests_(nullptr),
-      records_(nullptr)
+      records_(nullptr),
+      credits_(cfg->isir_credits),
+      peers_(),
+      returned_(),
+      held_(0),
+      queued_((cfg->isir_credits) ? here->ranks : 0)
 {
   reserve(64);
+  if (credits_) {
+    peers_.resize(here->ranks);
+    for (auto& peer : peers_) {
+      peer.credits = credits_;
+    }
+  }
 }
 
 ISendBuffer::~ISendBuffer()
@@ -309,21 +341,80 @@ ISendBuffer::~ISendBuffer()
 }
 
 void
-ISendBuffer::append(hpx_parcel_t *p, hpx_parcel_t *ssync)
+ISendBuffer::push(const Record& record)
 {
   unsigned max = _index_of(max_++, size_);
-  records_[max].parcel = p;
-  records_[max].ssync = ssync;
+  records_[max] = record;
   if (size_ <= max_ - min_) {
     reserve(2 * size_);
   }
 }
 
+void
+ISendBuffer::release()
+{
+  for (unsigned to : returned_) {
+    Peer& peer = peers_[to];
+    while (peer.credits && !peer.held.empty()) {
+      push(peer.held.front());
+      peer.held.pop_front();
+      peer.credits -= 1;
+      held_ -= 1;
+    }
+  }
+  returned_.clear();
+}
+
+void
+ISendBuffer::wait(const hpx_parcel_t *p) const
+{
+  if (!credits_) {
+    return;
+  }
+
+  // Sends that are already in the lane's queue aren't counted yet, so the
+  // window can be exceeded by one send per concurrent sender.
+  Worker* w = self;
+  if (!w || !w->canBlock()) {
+    return;
+  }
+
+  const std::atomic<unsigned>& queued = queued_[gas_.ownerOf(p->target)];
+  while (credits_ <= queued.load(std::memory_order_acquire)) {
+    hpx_thread_yield();
+  }
+}
+
+void
+ISendBuffer::append(hpx_parcel_t *p, hpx_parcel_t *ssync)
+{
+  // Resolve the destination once, since the target may move (with AGAS)
+  // before the send completes and its credit has to go back to this peer.
+  Record record = { p, ssync, gas_.ownerOf(p->target) };
+  if (!credits_) {
+    push(record);
+    return;
+  }
+  queued_[record.rank].fetch_add(1, std::memory_order_relaxed);
+
+  // Sends to a peer are held in order behind any that are already waiting.
+  Peer& peer = peers_[record.rank];
+  if (peer.credits && peer.held.empty()) {
+    peer.credits -= 1;
+    push(record);
+    return;
+  }
+
+  peer.held.push_back(record);
+  held_ += 1;
+  log_net("holding a send until credits return (%lu held)\n", held_);
+}
+
 int
 ISendBuffer::flush(hpx_parcel_t **ssync)
 {
   int total = 0;
-  while (min_ != max_) {
+  while (min_ != max_ || held_) {
     total += progress(ssync);
   }
   return total;
@@ -333,6 +424,7 @@ int
 ISendBuffer::progress(hpx_parcel_t **ssync)
 {
   unsigned long m = testAll(ssync);
+  release();
   unsigned long n = startAll(); (void)n;
   DEBUG_IF (m) {
     log_net("finished %lu sends\n", m);
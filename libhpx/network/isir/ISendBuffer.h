@@ -18,6 +18,9 @@
 #include "libhpx/config.h"
 #include "libhpx/GAS.h"
 #include "libhpx/parcel.h"
+#include <atomic>
+#include <deque>
+#include <vector>
 
 namespace libhpx {
 namespace network {
@@ -37,9 +40,24 @@ class ISendBuffer {
   /// Finalize a send buffer.
   ~ISendBuffer();
 
+  /// Wait for the window to a peer to open.
+  ///
+  /// Each peer has a window of --hpx-isir-credits queued sends, which counts
+  /// both the outstanding and the held sends. The network calls this when a
+  /// parcel is sent, and if the caller is a lightweight thread that can block
+  /// it yields until the peer's window has room, which bounds the memory held
+  /// for a peer under incast. Other callers return immediately. This is thread
+  /// safe.
+  ///
+  /// @param            p The parcel that is being sent.
+  void wait(const hpx_parcel_t *p) const;
+
   /// Append a send to the buffer.
   ///
-  /// This may or may not start the send immediately.
+  /// This may or may not start the send immediately. A send to a peer that has
+  /// no credits is held back until one of that peer's sends completes. Sends
+  /// are only held beyond the window when they come from callers that can't
+  /// wait().
   ///
   /// @param            p The stack of parcels to send.
   /// @param        ssync The stack of parcel continuations.
@@ -66,8 +84,21 @@ class ISendBuffer {
   struct Record {
     hpx_parcel_t *parcel;
     hpx_parcel_t *ssync;
+    unsigned        rank;                       //!< the destination rank
   };
 
+  /// The flow control state for one peer.
+  struct Peer {
+    unsigned         credits;                   //!< available send credits
+    std::deque<Record> held;                    //!< sends waiting for credits
+  };
+
+  /// Put a send into the buffer.
+  void push(const Record& record);
+
+  /// Move held sends into the buffer for peers that have credits again.
+  void release();
+
   static int PayloadSizeToTag(unsigned payload);
 
   void reserve(unsigned size);
@@ -95,6 +126,7 @@ class ISendBuffer {
 
   GAS&             gas_;
   Transport&     xport_;
+  unsigned       eager_;                        //!< largest eager send
   unsigned       limit_;
   unsigned        twin_;
   unsigned        size_;
@@ -103,6 +135,11 @@ class ISendBuffer {
   unsigned long    max_;
   Request*    requests_;
   Record*      records_;
+  unsigned     credits_;                        //!< the window for each peer
+  std::vector<Peer> peers_;
+  std::vector<unsigned> returned_;              //!< peers that got credits
+  unsigned long   held_;                        //!< the total held sends
+  std::vector<std::atomic<unsigned>> queued_;   //!< queued sends per peer
 };
 } // namespace isir
 } // namespace network
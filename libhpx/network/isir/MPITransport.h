@@ -32,21 +32,50 @@ class MPITransport {
   typedef MPI_Request Request;
   typedef MPI_Status Status;
 
-  MPITransport() : world_(MPI_COMM_NULL), finalize_(false) {
+  /// Create a transport with its own duplicate of MPI_COMM_WORLD.
+  ///
+  /// @param      level The thread level to request if we initialize MPI.
+  explicit MPITransport(int level = MPI_THREAD_SERIALIZED)
+      : world_(MPI_COMM_NULL)
+  {
+    Initialize(level);
+    Check(MPI_Comm_dup(MPI_COMM_WORLD, &world_));
+  }
+
+  ~MPITransport() {
+    Check(MPI_Comm_free(&world_));
+    Finalize();
+  }
+
+  /// Initialize MPI if nobody else has, and take a reference to it.
+  ///
+  /// MPI is finalized when the last reference is released, but only if we
+  /// were the ones that initialized it.
+  ///
+  /// @param      level The thread level to request.
+  ///
+  /// @returns          The thread level that MPI provides.
+  static int Initialize(int level) {
     int initialized;
     Check(MPI_Initialized(&initialized));
     if (!initialized) {
-      int level;
-      Check(MPI_Init_thread(nullptr, nullptr, MPI_THREAD_SERIALIZED, &level));
-      assert(level >= MPI_THREAD_SERIALIZED);
-      finalize_ = true;
+      int provided;
+      Check(MPI_Init_thread(nullptr, nullptr, level, &provided));
+      assert(provided >= MPI_THREAD_SERIALIZED);
+      Owner() = true;
     }
-    Check(MPI_Comm_dup(MPI_COMM_WORLD, &world_));
+    ++References();
+
+    int provided;
+    Check(MPI_Query_thread(&provided));
+    return provided;
   }
 
-  ~MPITransport() {
-    Check(MPI_Comm_free(&world_));
-    if (finalize_) {
+  /// Release a reference taken with Initialize().
+  static void Finalize() {
+    assert(References() > 0);
+    if (--References() == 0 && Owner()) {
+      Owner() = false;
       MPI_Finalize();
     }
   }
@@ -197,8 +226,17 @@ class MPITransport {
     char data_[];
   };
 
+  static int& References() {
+    static int references = 0;
+    return references;
+  }
+
+  static bool& Owner() {
+    static bool owner = false;
+    return owner;
+  }
+
   MPI_Comm world_;
-  bool  finalize_;
 };
 
 } // namespace isir
@@ -0,0 +1,271 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "ThreadedNetwork.h"
+#include "FunneledNetwork.h"
+#include "libhpx/Worker.h"
+#include "libhpx/collective.h"
+#include "libhpx/debug.h"
+#include "libhpx/locality.h"
+#include "libhpx/parcel.h"
+#include "libhpx/boot/Network.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+using libhpx::Network;
+using libhpx::network::ParcelLCOOps;
+using libhpx::network::ParcelStringOps;
+using libhpx::network::isir::FunneledNetwork;
+using libhpx::network::isir::ThreadedNetwork;
+
+/// Agree on the number of lanes.
+///
+/// The default lane count depends on each rank's worker count, which can
+/// differ between ranks, so we use the smallest count that any rank asks for.
+/// This is collective.
+int AgreeLanes(const config_t *cfg)
+{
+  int n = (cfg->isir_lanes) ? cfg->isir_lanes : std::max(cfg->threads, 1);
+  std::vector<int> lanes(here->ranks);
+  here->boot->allgather(&n, &lanes[0], sizeof(n));
+  return *std::min_element(lanes.begin(), lanes.end());
+}
+}
+
+Network*
+ThreadedNetwork::Create(const config_t *cfg, GAS *gas)
+{
+  // Hold a reference to MPI while we decide, so that it isn't finalized
+  // between the check and the creation of the fallback network.
+  Network* network = nullptr;
+  int level = Transport::Initialize(MPI_THREAD_MULTIPLE);
+  if (level < MPI_THREAD_MULTIPLE) {
+    log_net("MPI provides thread level %d, using the funneled network\n",
+            level);
+    network = new FunneledNetwork(cfg, gas);
+  }
+  else {
+    network = new ThreadedNetwork(cfg, gas);
+  }
+  Transport::Finalize();
+  return network;
+}
+
+ThreadedNetwork::Lane::Lane(const config_t *cfg, GAS *gas)
+    : util::Aligned<HPX_CACHELINE_SIZE>(),
+      sends(),
+      xport(MPI_THREAD_MULTIPLE),
+      isends(cfg, gas, xport),
+      irecvs(cfg, xport),
+      lock()
+{
+}
+
+ThreadedNetwork::Lane::~Lane()
+{
+  while (hpx_parcel_t *p = sends.dequeue()) {
+    parcel_delete(p);
+  }
+}
+
+void
+ThreadedNetwork::Lane::sendAll()
+{
+  while (hpx_parcel_t *p = sends.dequeue()) {
+    hpx_parcel_t *ssync = p->next;
+    p->next = NULL;
+    isends.append(p, ssync);
+  }
+}
+
+ThreadedNetwork::ThreadedNetwork(const config_t *cfg, GAS *gas)
+    : Network(),
+      ParcelStringOps(),
+      ParcelLCOOps(),
+      util::Aligned<HPX_CACHELINE_SIZE>(),
+      lanes_(),
+      next_(0),
+      recvs_()
+{
+  // Communicator duplication is collective, and lane i only talks to lane i,
+  // so every rank has to create the same number of lanes.
+  int n = AgreeLanes(cfg);
+  for (int i = 0; i < n; ++i) {
+    lanes_.emplace_back(new Lane(cfg, gas));
+  }
+  log_net("ISIR network using %d threaded lanes\n", n);
+}
+
+ThreadedNetwork::~ThreadedNetwork()
+{
+  while (hpx_parcel_t *p = recvs_.dequeue()) {
+    parcel_delete(p);
+  }
+}
+
+int
+ThreadedNetwork::type() const
+{
+  return HPX_NETWORK_ISIR;
+}
+
+ThreadedNetwork::Lane&
+ThreadedNetwork::lane() const
+{
+  unsigned i = (self) ? self->getId() : 0;
+  return *lanes_[i % lanes_.size()];
+}
+
+int
+ThreadedNetwork::init(void **ctx)
+{
+  flush();
+
+  auto coll = static_cast<coll_t*>(*ctx);
+  int num_active = coll->group_sz;
+  log_net("ISIR network collective being initialized."
+          "Total active ranks: %d\n", num_active);
+  int32_t *ranks = reinterpret_cast<int32_t*>(coll->data);
+
+  if (coll->comm_bytes == 0) {
+    // we have not yet allocated a communicator
+    coll->comm_bytes = sizeof(Transport::Communicator);
+    auto bytes = sizeof(coll_t) + coll->group_bytes + coll->comm_bytes;
+    coll = static_cast<coll_t*>(realloc(coll, bytes));
+    *ctx = coll;
+  }
+
+  // setup communicator, collectives always use the first lane
+  auto offset = coll->data + coll->group_bytes;
+  auto comm = reinterpret_cast<Transport::Communicator*>(offset);
+  Lane& lane = *lanes_[0];
+  std::lock_guard<std::mutex> _(lane.lock);
+  lane.xport.createComm(comm, num_active, ranks);
+  return 0;
+}
+
+int
+ThreadedNetwork::sync(void *in, size_t count, void *out, void *ctx)
+{
+  // flushing network is necessary (sufficient?) to execute any
+  // packets destined for collective operation
+  flush();
+
+  auto coll = static_cast<coll_t *>(ctx);
+  auto offset = coll->data + coll->group_bytes;
+  auto comm = reinterpret_cast<Transport::Communicator*>(offset);
+  Lane& lane = *lanes_[0];
+  std::lock_guard<std::mutex> _(lane.lock);
+  switch (coll->type) {
+   case ALL_REDUCE:
+    lane.xport.allreduce(in, out, count, NULL, &coll->op, comm);
+    break;
+   default:
+    log_dflt("Collective type descriptor: %d is invalid!\n", coll->type);
+    break;
+  }
+  return 0;
+}
+
+void
+ThreadedNetwork::deallocate(const hpx_parcel_t* p)
+{
+  dbg_error("ISIR network has not network-managed parcels\n");
+}
+
+int
+ThreadedNetwork::send(hpx_parcel_t *p, hpx_parcel_t *ssync)
+{
+  // Use the unused parcel-next pointer to get the ssync continuation parcels
+  // through the concurrent queue, along with the primary parcel. If nobody is
+  // using our lane we start the send immediately.
+  Lane& lane = this->lane();
+  lane.isends.wait(p);
+  p->next = ssync;
+  lane.sends.enqueue(p);
+  if (auto _ = std::unique_lock<std::mutex>(lane.lock, std::try_to_lock)) {
+    lane.sendAll();
+  }
+  return 0;
+}
+
+hpx_parcel_t *
+ThreadedNetwork::probe(int)
+{
+  return recvs_.dequeue();
+}
+
+void
+ThreadedNetwork::flush()
+{
+  for (auto& lane : lanes_) {
+    std::lock_guard<std::mutex> _(lane->lock);
+    lane->sendAll();
+    hpx_parcel_t *ssync = NULL;
+    lane->isends.flush(&ssync);
+    if (ssync) {
+      recvs_.enqueue(ssync);
+    }
+  }
+}
+
+void
+ThreadedNetwork::pin(const void *base, size_t n, void *key)
+{
+  Transport::pin(base, n, key);
+}
+
+void
+ThreadedNetwork::unpin(const void* base, size_t n)
+{
+  Transport::unpin(base, n);
+}
+
+void
+ThreadedNetwork::progress(Lane& lane)
+{
+  if (auto _ = std::unique_lock<std::mutex>(lane.lock, std::try_to_lock)) {
+    hpx_parcel_t *chain = NULL;
+    if (int n = lane.irecvs.progress(&chain)) {
+      log_net("completed %d recvs\n", n);
+      recvs_.enqueue(chain);
+    }
+    chain = NULL;
+    if (int n = lane.isends.progress(&chain)) {
+      log_net("completed %d sends\n", n);
+      recvs_.enqueue(chain);
+    }
+    lane.sendAll();
+  }
+}
+
+void
+ThreadedNetwork::progress(int)
+{
+  Lane& mine = lane();
+  progress(mine);
+
+  // Sweep one of the other lanes, in case its workers aren't running.
+  if (lanes_.size() > 1) {
+    unsigned i = next_.fetch_add(1, std::memory_order_relaxed);
+    Lane& other = *lanes_[i % lanes_.size()];
+    if (&other != &mine) {
+      progress(other);
+    }
+  }
+}
@@ -0,0 +1,108 @@
+// ==================================================================-*- C++ -*-
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifndef LIBHPX_NETWORK_ISIR_THREADED_NETWORK_H
+#define LIBHPX_NETWORK_ISIR_THREADED_NETWORK_H
+
+#include "libhpx/Network.h"
+#include "IRecvBuffer.h"
+#include "ISendBuffer.h"
+#include "MPITransport.h"
+#include "libhpx/ParcelLCOOps.h"
+#include "libhpx/ParcelStringOps.h"
+#include "libhpx/util/Aligned.h"
+#include "libhpx/util/TwoLockQueue.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace libhpx {
+namespace network {
+namespace isir {
+
+/// An isend/irecv network that workers can drive concurrently.
+///
+/// The network is split into a number of independent lanes, each with its own
+/// communicator and its own send and receive buffers. Workers inject sends into
+/// and test completions on their own lane, so they only contend with the other
+/// workers that share it. Each lane is still serialized by a lock, but the
+/// lanes run concurrently, which requires MPI_THREAD_MULTIPLE.
+///
+/// Lanes are matched by communicator, so lane i on one rank only receives from
+/// lane i on the other ranks. Workers sweep the other lanes round-robin during
+/// progress so that lanes without a running worker still complete.
+///
+/// Each lane has its own send buffer, so the --hpx-isir-credits window to a
+/// peer applies per lane, and a rank can have up to lanes times credits sends
+/// queued for each peer.
+class ThreadedNetwork : public Network, public ParcelStringOps,
+                        public ParcelLCOOps,
+                        public util::Aligned<HPX_CACHELINE_SIZE>
+{
+ public:
+  /// Create a threaded network, or a funneled one if MPI doesn't provide
+  /// MPI_THREAD_MULTIPLE.
+  static Network* Create(const config_t *cfg, GAS *gas);
+
+  ThreadedNetwork(const config_t *cfg, GAS *gas);
+  ~ThreadedNetwork();
+
+  int type() const;
+  void progress(int);
+  hpx_parcel_t* probe(int);
+  void flush();
+
+  void deallocate(const hpx_parcel_t* p);
+  int send(hpx_parcel_t* p, hpx_parcel_t* ssync);
+
+  void pin(const void *base, size_t bytes, void *key);
+  void unpin(const void *base, size_t bytes);
+
+  int init(void **collective);
+  int sync(void *in, size_t in_size, void* out, void *collective);
+
+ private:
+  using Transport = libhpx::network::isir::MPITransport;
+  using ParcelQueue = libhpx::util::TwoLockQueue<hpx_parcel_t*>;
+
+  /// The state for one lane, which is equivalent to a funneled network.
+  struct Lane : public util::Aligned<HPX_CACHELINE_SIZE> {
+    Lane(const config_t *cfg, GAS *gas);
+    ~Lane();
+
+    /// Move the parcels from the send queue into the isend buffer.
+    void sendAll();
+
+    ParcelQueue  sends;
+    Transport    xport;
+    ISendBuffer isends;
+    IRecvBuffer irecvs;
+    std::mutex    lock;
+  };
+
+  /// Select the lane for the current worker.
+  Lane& lane() const;
+
+  /// Progress a lane if nobody else is doing so.
+  void progress(Lane& lane);
+
+  std::vector<std::unique_ptr<Lane>> lanes_;
+  std::atomic<unsigned> next_;                  //!< the next lane to sweep
+  ParcelQueue recvs_;
+};
+} // namespace isir
+} // namespace network
+} // namespace libhpx
+
+#endif // LIBHPX_NETWORK_ISIR_THREADED_NETWORK_H
@@ -17,6 +17,10 @@
 #include <libhpx/debug.h>
 #include <libhpx/parcel.h>
 
+/// The tag used for messages that are received through the preposted eager
+/// ring. Size-encoding tags are never 0 because they include the parcel header.
+static const int ISIR_EAGER_TAG = 0;
+
 static inline uint32_t isir_prefix_size(void) {
   return offsetof(hpx_parcel_t, action);
 }
@@ -32,6 +32,8 @@
 #include "libhpx/Network.h"
 #include <libhpx/padding.h>
 #include <libhpx/parcel.h>
+#include "libhpx/ParcelCache.h"
+#include "libhpx/Scheduler.h"
 #include <libhpx/Topology.h>
 #include "libhpx/Worker.h"
 #include <hpx/hpx.h>
@@ -46,6 +48,7 @@
 
 namespace {
 using libhpx::self;
+using libhpx::network::ParcelCache;
 using libhpx::scheduler::Thread;
 }
 
@@ -61,6 +64,15 @@ static int _delete_launch_through_parcel_handler(hpx_parcel_t *p) {
 static LIBHPX_ACTION(HPX_DEFAULT, 0, _delete_launch_through_parcel,
                      _delete_launch_through_parcel_handler, HPX_POINTER);
 
+/// Allocate the memory for a parcel, using the local parcel cache if possible.
+static hpx_parcel_t *_allocate(size_t size) {
+  void *p = ParcelCache::Allocate(size);
+  if (!p) {
+    p = as_memalign(AS_REGISTERED, HPX_CACHELINE_SIZE, size);
+  }
+  return static_cast<hpx_parcel_t *>(p);
+}
+
 /// Serialize and bless a parcel before sending or copying it.
 void parcel_prepare(hpx_parcel_t *p) {
   parcel_state_t state = parcel_get_state(p);
@@ -93,7 +105,8 @@ parcel_state_t parcel_exchange_state(hpx_parcel_t *p, parcel_state_t state) {
 void parcel_pin(hpx_parcel_t *p) {
   parcel_state_t state = parcel_get_state(p);
   dbg_assert_str(parcel_serialized(state), "cannot pin out-of-place parcels\n");
-  dbg_assert_str(!parcel_nested(state), "cannot pin nested parcels\n");
+  dbg_assert_str(!parcel_nested(state) || parcel_coalesced(state),
+                 "cannot pin nested parcels\n");
   dbg_assert_str(!parcel_retained(state), "cannot pin retained parcels\n");
   parcel_set_state(p, state | PARCEL_PINNED);
 }
@@ -120,6 +133,45 @@ void parcel_release(hpx_parcel_t *p) {
   parcel_set_state(p, state & ~PARCEL_RETAINED);
 }
 
+void parcel_coalesce(void *payload, uint32_t offset, const hpx_parcel_t *p) {
+  dbg_assert(parcel_serialized(parcel_get_state(p)) || p->size == 0);
+  dbg_assert(offset % PARCEL_COALESCED_HEADER == 0);
+  char *record = static_cast<char*>(payload) + offset;
+  memcpy(record + PARCEL_COALESCED_HEADER, p, parcel_size(p));
+}
+
+void parcel_launch_coalesced(hpx_parcel_t *parent) {
+  parcel_state_t state = parcel_get_state(parent);
+  dbg_assert_str(parcel_serialized(state),
+                 "cannot launch out-of-place coalesced parcels\n");
+  dbg_assert(!parcel_nested(state) && !parcel_coalesced(state));
+
+  char *payload = static_cast<char*>(hpx_parcel_get_data(parent));
+  char *end = payload + parent->size;
+
+  // The parent holds one reference for itself and one for each of the
+  // coalesced parcels, and we have to count them before launching any of them.
+  uint32_t refs = 1;
+  for (char *i = payload + PARCEL_COALESCED_HEADER; i < end; ++refs) {
+    auto p = reinterpret_cast<hpx_parcel_t*>(i + PARCEL_COALESCED_HEADER);
+    i += parcel_coalesced_size(p);
+  }
+  dbg_assert(refs < UINT32_MAX);
+  __atomic_store_n(reinterpret_cast<uint32_t*>(payload), refs,
+                   __ATOMIC_RELAXED);
+  parcel_set_state(parent, state | PARCEL_COALESCED);
+
+  for (char *i = payload + PARCEL_COALESCED_HEADER; i < end; ) {
+    auto p = reinterpret_cast<hpx_parcel_t*>(i + PARCEL_COALESCED_HEADER);
+    *reinterpret_cast<hpx_parcel_t**>(i) = parent;
+    i += parcel_coalesced_size(p);
+    p->thread = nullptr;
+    p->next = nullptr;
+    parcel_set_state(p, PARCEL_SERIALIZED | PARCEL_NESTED | PARCEL_COALESCED);
+    parcel_launch(p);
+  }
+}
+
 void parcel_launch(hpx_parcel_t *p) {
   dbg_assert(p->action);
 
@@ -146,9 +198,16 @@ void parcel_launch(hpx_parcel_t *p) {
   if (target == here->rank) {
     // instrument local "receives"
     EVENT_PARCEL_RECV(p->id, p->action, p->size, p->src, p->target);
-    self->spawn(p);
+    if (self) {
+      self->spawn(p);
+    }
+    else {
+      here->sched->spawn(p);
+    }
   }
   else {
+    // the cached affinity decision is only meaningful at this locality
+    p->affinity = 0;
     int e = here->net->send(p, NULL);
 #ifdef HAVE_APEX
     apex_send(p->id, p->size, target);
@@ -188,7 +247,7 @@ void parcel_init(hpx_addr_t target, hpx_action_t action, hpx_addr_t c_target,
   p->next     = nullptr;
   p->src      = here->rank;
   p->size     = len;
-  p->offset   = 0;
+  p->affinity = 0;
   p->action   = action;
   p->c_action = c_action;
   p->target   = target;
@@ -227,7 +286,7 @@ hpx_parcel_t *parcel_alloc(size_t payload) {
     size += _BYTES(8, size);
   }
 
-  auto p = static_cast<hpx_parcel_t *>(as_memalign(AS_REGISTERED, HPX_CACHELINE_SIZE, size));
+  hpx_parcel_t *p = _allocate(size);
   dbg_assert_str(p, "parcel: failed to allocate %zu registered bytes.\n", size);
 #ifdef ENABLE_INSTRUMENTATION
   *(uint64_t*)&p->padding = UINT64_C(0);        // initialize read-only padding
@@ -252,7 +311,7 @@ hpx_parcel_t *parcel_new(hpx_addr_t target, hpx_action_t action,
 hpx_parcel_t *parcel_clone(const hpx_parcel_t *p) {
   dbg_assert(parcel_serialized(parcel_get_state(p)) || p->size == 0);
   size_t n = parcel_size(p);
-  auto clone = static_cast<hpx_parcel_t *>(as_memalign(AS_REGISTERED, HPX_CACHELINE_SIZE, n));
+  hpx_parcel_t *clone = _allocate(n);
   memcpy(clone, p, n);
   clone->thread = nullptr;
   clone->next = nullptr;
@@ -271,6 +330,21 @@ void parcel_delete(hpx_parcel_t *p) {
     return;
   }
 
+  if (unlikely(parcel_pinned(state))) {
+    state &= ~PARCEL_PINNED;
+    state = parcel_exchange_state(p, state);
+  }
+
+  if (unlikely(parcel_pinned(state))) {
+    return;
+  }
+
+  if (unlikely(parcel_nested(state) && parcel_coalesced(state))) {
+    char *record = reinterpret_cast<char*>(p) - PARCEL_COALESCED_HEADER;
+    parcel_delete(*reinterpret_cast<hpx_parcel_t**>(record));
+    return;
+  }
+
   if (unlikely(parcel_nested(state))) {
     size_t n = parcel_size(p);
     auto parent = reinterpret_cast<hpx_parcel_t*>((char*)p - sizeof(*p));
@@ -282,13 +356,11 @@ void parcel_delete(hpx_parcel_t *p) {
     return;
   }
 
-  if (unlikely(parcel_pinned(state))) {
-    state &= ~PARCEL_PINNED;
-    state = parcel_exchange_state(p, state);
-  }
-
-  if (unlikely(parcel_pinned(state))) {
-    return;
+  if (unlikely(parcel_coalesced(state))) {
+    auto refs = reinterpret_cast<uint32_t*>(&p->buffer);
+    if (__atomic_sub_fetch(refs, 1, __ATOMIC_ACQ_REL)) {
+      return;
+    }
   }
 
   if (parcel_block_allocated(state)) {
@@ -298,7 +370,9 @@ void parcel_delete(hpx_parcel_t *p) {
   }
 
   EVENT_PARCEL_DELETE(p->id, p->action);
-  as_free(AS_REGISTERED, p);
+  if (!ParcelCache::Deallocate(p)) {
+    as_free(AS_REGISTERED, p);
+  }
 }
 
 Thread* parcel_set_thread(hpx_parcel_t *p, Thread *next) {
@@ -17,7 +17,7 @@
 #include "libhpx/Network.h"
 #include "Commands.h"
 #include "Peer.h"
-#include "PhotonTransport.h"
+#include "Transport.h"
 #include "libhpx/GAS.h"
 #include "libhpx/parcel.h"
 #include "libhpx/ParcelStringOps.h"
@@ -24,7 +24,7 @@
 namespace {
 using libhpx::network::pwc::EagerBlock;
 using libhpx::network::pwc::InplaceBlock;
-using libhpx::network::pwc::PhotonTransport;
+using libhpx::network::pwc::Transport;
 }
 
 EagerBlock::EagerBlock()
@@ -37,7 +37,7 @@ EagerBlock::EagerBlock()
 EagerBlock::EagerBlock(size_t capacity, char* buffer)
     : end_(buffer + capacity),
       next_(buffer),
-      key_(PhotonTransport::FindKey(buffer, capacity))
+      key_(Transport::FindKey(buffer, capacity))
 {
 }
 
@@ -84,13 +84,13 @@ EagerBlock::put(unsigned rank, const hpx_parcel_t* p, size_t& n)
     return false;
   }
 
-  PhotonTransport::Op op;
+  Transport::Op op;
   op.rank = rank;
   op.n = n;
   op.dest = dest;
   op.dest_key = &key_;
   op.src = p;
-  op.src_key = PhotonTransport::FindKeyRef(p, n);
+  op.src_key = Transport::FindKeyRef(p, n);
   op.lop = Command::DeleteParcel(p);
   op.rop = Command::RecvParcel(static_cast<hpx_parcel_t*>(dest));
 
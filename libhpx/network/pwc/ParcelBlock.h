@@ -14,7 +14,7 @@
 #ifndef LIBHPX_NETWORK_PWC_PARCEL_BLOCK_H
 #define LIBHPX_NETWORK_PWC_PARCEL_BLOCK_H
 
-#include "PhotonTransport.h"
+#include "Transport.h"
 #include "libhpx/padding.h"
 #include "libhpx/parcel.h"
 #include <cstddef>
@@ -112,7 +112,7 @@ class EagerBlock {
 
   const char* end_;                        //<! The end of the buffer
   char* next_;                             //<! The next pointer
-  PhotonTransport::Key key_;               //<! The rdma key covering the buffer
+  Transport::Key key_;                     //<! The rdma key covering the buffer
 };
 
 /// An eager buffer where the buffer is allocated adjacent to the buffer.
@@ -23,9 +23,9 @@
 
 namespace {
 using libhpx::network::pwc::Command;
-using libhpx::network::pwc::PhotonTransport;
+using libhpx::network::pwc::Transport;
 using libhpx::network::pwc::Peer;
-using Op = libhpx::network::pwc::PhotonTransport::Op;
+using Op = libhpx::network::pwc::Transport::Op;
 template <typename T> using Remote = libhpx::network::pwc::Remote<T>;
 }
 
@@ -128,7 +128,7 @@ Peer::reload(size_t n, size_t eagerSize)
   op.dest = remoteSend_.addr;
   op.dest_key = &remoteSend_.key;
   op.src = recv_;
-  op.src_key = PhotonTransport::FindKeyRef(recv_, eagerSize);
+  op.src_key = Transport::FindKeyRef(recv_, eagerSize);
   op.lop = Command::Nop();
   op.rop = Command::ReloadReply();
 
@@ -145,7 +145,7 @@ Peer::put(hpx_addr_t to, const void *lva, size_t n, const Command& lcmd,
   op.dest = heapSegment_.addr + gpa_to_offset(to);
   op.dest_key = &heapSegment_.key;
   op.src = lva;
-  op.src_key = PhotonTransport::FindKeyRef(lva, n);
+  op.src_key = Transport::FindKeyRef(lva, n);
   op.lop = lcmd;
   op.rop = rcmd;
   dbg_check( op.put() );
@@ -159,7 +159,7 @@ Peer::get(void *lva, hpx_addr_t from, size_t n, const Command& lcmd,
   op.rank = rank_;
   op.n = n;
   op.dest = lva;
-  op.dest_key = PhotonTransport::FindKeyRef(lva, n);
+  op.dest_key = Transport::FindKeyRef(lva, n);
   op.src = heapSegment_.addr + gpa_to_offset(from);
   op.src_key = &heapSegment_.key;
   op.lop = lcmd;
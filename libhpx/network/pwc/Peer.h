@@ -16,7 +16,7 @@
 
 #include "CircularBuffer.h"
 #include "ParcelBlock.h"
-#include "PhotonTransport.h"
+#include "Transport.h"
 #include "libhpx/config.h"
 #include "libhpx/padding.h"
 #include "libhpx/parcel.h"
@@ -35,8 +35,8 @@ namespace pwc {
 /// address that we have stored for the requesting rank.
 template <typename T>
 struct Remote {
-  T                  *addr;
-  PhotonTransport::Key key;
+  T             *addr;
+  Transport::Key key;
 };
 
 class Peer {
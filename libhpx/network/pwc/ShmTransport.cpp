@@ -0,0 +1,410 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "ShmTransport.h"
+#include "../shm/Bootstrap.h"
+#include "registered.h"
+#include "libhpx/debug.h"
+#include "libhpx/libhpx.h"
+#include "libhpx/locality.h"
+#include "libhpx/boot/Network.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/uio.h>
+#endif
+
+namespace {
+using libhpx::network::pwc::ShmTransport;
+using libhpx::network::pwc::Command;
+using libhpx::network::shm::GatherPids;
+using libhpx::network::shm::MapSegment;
+using libhpx::network::shm::ProbeCMA;
+using Op = libhpx::network::pwc::ShmTransport::Op;
+using Key = libhpx::network::pwc::ShmTransport::Key;
+
+/// The process-wide state for the emulated transport.
+class Emulator {
+ public:
+  Emulator(const config_t *cfg, int rank, int ranks);
+  ~Emulator();
+
+  /// Copy bytes to or from a peer's address space.
+  /// @{
+  void write(int rank, void *to, const void *from, size_t n) const;
+  void read(int rank, void *to, const void *from, size_t n) const;
+  /// @}
+
+  /// Queue a local completion.
+  void local(const Command& command);
+
+  /// Write a remote completion into @p rank's ledger.
+  void remote(int rank, const Command& command);
+
+  /// Dequeue a local completion.
+  int test(Command *command, int *remaining);
+
+  /// Dequeue a remote completion.
+  int probe(Command *command, int *remaining, int rank, int *src);
+
+ private:
+  /// The control block for one ledger, followed by its entries in the segment.
+  ///
+  /// The head and tail are monotonic entry counters. Only the receiver writes
+  /// the head and only the sender writes the tail.
+  struct Ring {
+    alignas(HPX_CACHELINE_SIZE) std::atomic<uint64_t> head;
+    alignas(HPX_CACHELINE_SIZE) std::atomic<uint64_t> tail;
+  };
+
+  /// Find the ledger that @p src uses to complete commands at @p dst.
+  Ring* ring(int src, int dst) const;
+
+  /// Move all of our pending remote completions into the overflow queue.
+  ///
+  /// This must be called with the ledger lock held.
+  void drain();
+
+  /// Pop a remote completion from @p src's ledger.
+  ///
+  /// This must be called with the ledger lock held.
+  bool pop(int src, Command *command);
+
+  const int                           rank_;
+  const int                          ranks_;
+  uint64_t                        capacity_;
+  char*                            segment_;
+  size_t                             bytes_;
+  std::vector<pid_t>                  pids_;
+  std::unique_ptr<std::mutex[]>      sends_;    //!< one per destination ledger
+  std::mutex                        ledger_;    //!< serializes our ledgers
+  std::deque<std::pair<int, Command>> overflow_;
+  int                                 next_;    //!< the next ledger to probe
+  std::mutex                           evq_;
+  std::deque<Command>               events_;
+};
+
+std::unique_ptr<Emulator> _emulator;
+
+/// Every registered range shares the same empty key.
+const Key _key = {};
+}
+
+Emulator::Emulator(const config_t *cfg, int rank, int ranks)
+    : rank_(rank),
+      ranks_(ranks),
+      capacity_(HPX_PAGE_SIZE / sizeof(uint64_t)),
+      segment_(nullptr),
+      bytes_(0),
+      pids_(ranks),
+      sends_(new std::mutex[ranks]),
+      ledger_(),
+      overflow_(),
+      next_(0),
+      evq_(),
+      events_()
+{
+  auto& boot = *here->boot;
+
+  // Use the largest power of 2 entries that fits in the configured ring size.
+  while (capacity_ * 2 * sizeof(uint64_t) <= cfg->shm_ringsize) {
+    capacity_ *= 2;
+  }
+
+  pids_ = GatherPids(boot, "PWC SHM transport");
+
+  size_t stride = sizeof(Ring) + capacity_ * sizeof(uint64_t);
+  bytes_ = size_t(ranks_) * ranks_ * stride;
+  segment_ = MapSegment(boot, "libhpx-pwc", pids_[0], bytes_);
+
+  // The emulation implements every put and get with cross-memory attach.
+  if (!ProbeCMA(boot, pids_)) {
+    dbg_error("PWC SHM transport requires cross-memory attach, which needs "
+              "ptrace permission between the ranks\n");
+  }
+
+  log_net("PWC SHM transport mapped %zu bytes, %" PRIu64 " entry ledgers\n",
+          bytes_, capacity_);
+}
+
+Emulator::~Emulator()
+{
+  munmap(segment_, bytes_);
+}
+
+Emulator::Ring*
+Emulator::ring(int src, int dst) const
+{
+  size_t i = size_t(src) * ranks_ + dst;
+  size_t bytes = sizeof(Ring) + capacity_ * sizeof(uint64_t);
+  return reinterpret_cast<Ring*>(segment_ + i * bytes);
+}
+
+void
+Emulator::write(int rank, void *to, const void *from, size_t n) const
+{
+  if (rank == rank_) {
+    memcpy(to, from, n);
+    return;
+  }
+
+  // The kernel may transfer less than we asked for, so loop until we're done.
+#ifdef __linux__
+  for (size_t i = 0; i < n; ) {
+    auto bytes = const_cast<char*>(static_cast<const char*>(from));
+    struct iovec local = { bytes + i, n - i };
+    struct iovec remote = { static_cast<char*>(to) + i, n - i };
+    ssize_t e = process_vm_writev(pids_[rank], &local, 1, &remote, 1, 0);
+    if (e <= 0) {
+      dbg_error("could not write %zu bytes to rank %d (%d)\n", n - i, rank,
+                errno);
+    }
+    i += e;
+  }
+#else
+  dbg_error("PWC SHM transport cross-memory attach is unavailable\n");
+#endif
+}
+
+void
+Emulator::read(int rank, void *to, const void *from, size_t n) const
+{
+  if (rank == rank_) {
+    memcpy(to, from, n);
+    return;
+  }
+
+#ifdef __linux__
+  for (size_t i = 0; i < n; ) {
+    auto bytes = const_cast<char*>(static_cast<const char*>(from));
+    struct iovec local = { static_cast<char*>(to) + i, n - i };
+    struct iovec remote = { bytes + i, n - i };
+    ssize_t e = process_vm_readv(pids_[rank], &local, 1, &remote, 1, 0);
+    if (e <= 0) {
+      dbg_error("could not read %zu bytes from rank %d (%d)\n", n - i, rank,
+                errno);
+    }
+    i += e;
+  }
+#else
+  dbg_error("PWC SHM transport cross-memory attach is unavailable\n");
+#endif
+}
+
+void
+Emulator::local(const Command& command)
+{
+  std::lock_guard<std::mutex> _(evq_);
+  events_.push_back(command);
+}
+
+void
+Emulator::remote(int rank, const Command& command)
+{
+  std::lock_guard<std::mutex> _(sends_[rank]);
+  Ring* r = ring(rank_, rank);
+  uint64_t tail = r->tail.load(std::memory_order_relaxed);
+
+  // If the ledger is full we wait for the peer to make room. The peer may be
+  // waiting for room in one of our ledgers, so we drain them while we wait.
+  while (tail - r->head.load(std::memory_order_acquire) >= capacity_) {
+    if (auto _ = std::unique_lock<std::mutex>(ledger_, std::try_to_lock)) {
+      drain();
+    }
+    sched_yield();
+  }
+
+  auto entries = reinterpret_cast<uint64_t*>(r + 1);
+  entries[tail & (capacity_ - 1)] = Command::Pack(command);
+  r->tail.store(tail + 1, std::memory_order_release);
+}
+
+bool
+Emulator::pop(int src, Command *command)
+{
+  Ring* r = ring(src, rank_);
+  uint64_t head = r->head.load(std::memory_order_relaxed);
+  if (head == r->tail.load(std::memory_order_acquire)) {
+    return false;
+  }
+
+  auto entries = reinterpret_cast<const uint64_t*>(r + 1);
+  *command = Command::Unpack(entries[head & (capacity_ - 1)]);
+  r->head.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+void
+Emulator::drain()
+{
+  Command command;
+  for (int i = 0; i < ranks_; ++i) {
+    while (pop(i, &command)) {
+      overflow_.emplace_back(i, command);
+    }
+  }
+}
+
+int
+Emulator::test(Command *command, int *remaining)
+{
+  std::lock_guard<std::mutex> _(evq_);
+  int flag = !events_.empty();
+  if (flag) {
+    *command = events_.front();
+    events_.pop_front();
+  }
+  if (remaining) {
+    *remaining = events_.size();
+  }
+  return flag;
+}
+
+int
+Emulator::probe(Command *command, int *remaining, int rank, int *src)
+{
+  std::lock_guard<std::mutex> _(ledger_);
+  if (remaining) {
+    *remaining = 0;
+  }
+
+  // Completions that we drained while waiting for a ledger come first, so
+  // that we preserve the order of the completions from each rank.
+  for (auto i = overflow_.begin(), e = overflow_.end(); i != e; ++i) {
+    if (rank == ShmTransport::ANY_SOURCE || rank == i->first) {
+      *src = i->first;
+      *command = i->second;
+      overflow_.erase(i);
+      return 1;
+    }
+  }
+
+  if (rank != ShmTransport::ANY_SOURCE) {
+    *src = rank;
+    return pop(rank, command);
+  }
+
+  // Probe the ledgers round-robin so that no rank is starved.
+  for (int i = 0; i < ranks_; ++i) {
+    int j = (next_ + i) % ranks_;
+    if (pop(j, command)) {
+      next_ = (j + 1) % ranks_;
+      *src = j;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+void
+ShmTransport::Initialize(const config_t *cfg, int rank, int ranks)
+{
+  if (_emulator) {
+    return;
+  }
+
+  _emulator.reset(new Emulator(cfg, rank, ranks));
+  registered_allocator_init();
+}
+
+const Key *
+ShmTransport::FindKeyRef(const void *addr, size_t n)
+{
+  return &_key;
+}
+
+void
+ShmTransport::FindKey(const void *addr, size_t n, Key *key)
+{
+  *key = _key;
+}
+
+Key
+ShmTransport::FindKey(const void *addr, size_t n)
+{
+  return _key;
+}
+
+void
+ShmTransport::Pin(const void *base, size_t n, Key *key)
+{
+  static constexpr auto LEVEL= HPX_LOG_NET | HPX_LOG_MEMORY;
+  log_level(LEVEL, "pinned segment (%p, %zu)\n", base, n);
+  if (key) {
+    *key = _key;
+  }
+}
+
+void
+ShmTransport::Unpin(const void *base, size_t n)
+{
+  static constexpr auto LEVEL= HPX_LOG_NET | HPX_LOG_MEMORY;
+  log_level(LEVEL, "unpinned the segment (%p, %zu)\n", base, n);
+}
+
+int
+ShmTransport::Op::cmd()
+{
+  if (rop) {
+    _emulator->remote(rank, rop);
+  }
+  if (lop) {
+    _emulator->local(lop);
+  }
+  return LIBHPX_OK;
+}
+
+int
+ShmTransport::Op::put()
+{
+  // The write is synchronous, so both the local buffer and the remote data are
+  // complete once it returns.
+  _emulator->write(rank, dest, src, n);
+  return cmd();
+}
+
+int
+ShmTransport::Op::get()
+{
+  _emulator->read(rank, dest, src, n);
+  return cmd();
+}
+
+int
+ShmTransport::Test(Command *op, int *remaining, int id, int *src)
+{
+  *src = here->rank;
+  return _emulator->test(op, remaining);
+}
+
+int
+ShmTransport::Probe(Command *op, int *remaining, int rank, int *src)
+{
+  return _emulator->probe(op, remaining, rank, src);
+}
@@ -0,0 +1,78 @@
+// ==================================================================-*- C++ -*-
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifndef LIBHPX_NETWORK_PWC_SHM_TRANSPORT_H
+#define LIBHPX_NETWORK_PWC_SHM_TRANSPORT_H
+
+#include "Commands.h"
+#include "libhpx/config.h"
+
+namespace libhpx {
+namespace network {
+namespace pwc {
+
+/// A PhotonTransport-compatible transport for localities on a single node.
+///
+/// Puts and gets are performed synchronously with cross-memory attach
+/// (process_vm_writev and process_vm_readv), so any address in a peer's address
+/// space is accessible and the keys are empty. Remote completions are written
+/// into a single-producer single-consumer ledger ring for each ordered pair of
+/// ranks in a shared memory segment, and local completions are queued in the
+/// sending process. This lets the PWC network run unchanged without RDMA
+/// hardware.
+class ShmTransport {
+ public:
+  static constexpr int ANY_SOURCE = -1;
+
+  /// Cross-memory attach doesn't need registration, so keys are empty.
+  struct Key {
+  };
+
+  struct alignas(HPX_CACHELINE_SIZE) Op {
+    unsigned                        rank;
+    const unsigned               PADDING;
+    Command                          lop;
+    Command                          rop;
+    size_t                             n;
+    void*                           dest;
+    const ShmTransport::Key*    dest_key;
+    const void*                      src;
+    const ShmTransport::Key*     src_key;
+
+    Op() : rank(), PADDING(), lop(), rop(), n(), dest(nullptr),
+           dest_key(nullptr), src(nullptr), src_key(nullptr) {
+    }
+
+    int cmd();
+    int put();
+    int get();
+  };
+
+  static void Initialize(const config_t *config, int rank, int ranks);
+
+  static int Test(Command *op, int *remaining, int id, int *src);
+  static int Probe(Command *op, int *remaining, int rank, int *src);
+
+  static void Pin(const void *base, size_t bytes, Key *key);
+  static void Unpin(const void *base, size_t bytes);
+
+  static const Key* FindKeyRef(const void *addr, size_t n);
+  static void FindKey(const void *addr, size_t n, Key *key);
+  static Key FindKey(const void *addr, size_t n);
+};
+
+} // namespace pwc
+} // namespace network
+} // namespace libhpx
+
+#endif // LIBHPX_NETWORK_PWC_SHM_TRANSPORT_H
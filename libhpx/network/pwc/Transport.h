@@ -0,0 +1,41 @@
+// ==================================================================-*- C++ -*-
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifndef LIBHPX_NETWORK_PWC_TRANSPORT_H
+#define LIBHPX_NETWORK_PWC_TRANSPORT_H
+
+/// @file  libhpx/network/pwc/Transport.h
+///
+/// Select the put-with-completion transport that the PWC network is built on.
+/// Photon is used when it is available, otherwise the network is built on the
+/// shared-memory emulation (--enable-pwc-shm).
+
+#ifdef HAVE_PHOTON
+# include "PhotonTransport.h"
+#else
+# include "ShmTransport.h"
+#endif
+
+namespace libhpx {
+namespace network {
+namespace pwc {
+#ifdef HAVE_PHOTON
+using Transport = PhotonTransport;
+#else
+using Transport = ShmTransport;
+#endif
+} // namespace pwc
+} // namespace network
+} // namespace libhpx
+
+#endif // LIBHPX_NETWORK_PWC_TRANSPORT_H
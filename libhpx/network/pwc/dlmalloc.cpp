@@ -16,20 +16,20 @@
 #endif
 
 #include "registered.h"
-#include "PhotonTransport.h"
+#include "Transport.h"
 #include "libhpx/debug.h"
 #include "libhpx/memory.h"
 #include "libhpx/system.h"
 
 namespace {
-using libhpx::network::pwc::PhotonTransport;
+using libhpx::network::pwc::Transport;
 }
 
 extern "C" void*
 dl_mmap_wrapper(size_t length)
 {
   if (void *base = system_mmap_huge_pages(NULL, NULL, length, 1)) {
-    PhotonTransport::Pin(base, length, NULL);
+    Transport::Pin(base, length, NULL);
     log_mem("mapped %zu registered bytes at %p\n", length, base);
     return base;
   }
@@ -42,7 +42,7 @@ extern "C" void
 dl_munmap_wrapper(void *ptr, size_t length)
 {
   if (length) {
-    PhotonTransport::Unpin(ptr, length);
+    Transport::Unpin(ptr, length);
     system_munmap_huge_pages(NULL, ptr, length);
   }
 }
@@ -23,7 +23,7 @@
 /// registration pain for frequent chunk allocation/deallocation patterns.
 
 #include "registered.h"
-#include "PhotonTransport.h"
+#include "Transport.h"
 #include "libhpx/debug.h"
 #include "libhpx/memory.h"
 #include "libhpx/system.h"
@@ -31,7 +31,7 @@
 #include <cstring>
 
 namespace {
-using libhpx::network::pwc::PhotonTransport;
+using libhpx::network::pwc::Transport;
 }
 
 static libhpx::util::LRUCache _chunks(8);
@@ -40,7 +40,7 @@ static bool
 _registered_chunk_free(void *chunk, size_t n, bool committed, unsigned arena)
 {
   _chunks.put(chunk, n, [n](void* chunk, size_t bytes) {
-      PhotonTransport::Unpin(chunk, bytes);
+      Transport::Unpin(chunk, bytes);
       system_munmap_huge_pages(nullptr, chunk, bytes);
     });
   return 0;
@@ -54,7 +54,7 @@ _registered_chunk_alloc(void *addr, size_t n, size_t align, bool *zero,
   dbg_assert(commit);
   void *chunk = _chunks.get(n, [=]() {
       void* chunk = system_mmap_huge_pages(nullptr, addr, n, align);
-      PhotonTransport::Pin(chunk, n, nullptr);
+      Transport::Pin(chunk, n, nullptr);
       return chunk;
     });
   if (!chunk) {
@@ -66,7 +66,7 @@ _registered_chunk_alloc(void *addr, size_t n, size_t align, bool *zero,
   // LRU cache because we don't want to keep returning this same chunk if it's a
   // problem.
   if (addr && addr != chunk) {
-    PhotonTransport::Unpin(chunk, n);
+    Transport::Unpin(chunk, n);
     system_munmap_huge_pages(nullptr, chunk, n);
     return nullptr;
   }
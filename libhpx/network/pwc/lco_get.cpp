@@ -24,10 +24,10 @@
 namespace {
 using libhpx::self;
 using libhpx::network::pwc::Command;
-using libhpx::network::pwc::PhotonTransport;
+using libhpx::network::pwc::Transport;
 using libhpx::network::pwc::PWCNetwork;
-using Op = libhpx::network::pwc::PhotonTransport::Op;
-using Key = libhpx::network::pwc::PhotonTransport::Key;
+using Op = libhpx::network::pwc::Transport::Op;
+using Key = libhpx::network::pwc::Transport::Key;
 }
 
 /// This acts as a parcel_suspend transfer to allow _pwc_lco_get_request_handler
@@ -68,7 +68,7 @@ _get_reply(_pwc_lco_get_request_args_t *args, const void *ref, Command remote)
   op.dest = args->out;
   op.dest_key = &args->key;
   op.src = ref;
-  op.src_key = PhotonTransport::FindKeyRef(ref, args->n);
+  op.src_key = Transport::FindKeyRef(ref, args->n);
   op.lop = Command();                          // set in _get_reply_continuation
   op.rop = remote;
   dbg_assert_str(op.src_key, "LCO reference must point to registered memory\n");
@@ -149,7 +149,7 @@ _get_reply_getref(_pwc_lco_get_request_args_t *args, hpx_addr_t lco)
   hpx_lco_release(lco, ref);
 
   // Wake the remote getter up.
-  PhotonTransport::Op op;
+  Transport::Op op;
   op.rank = args->rank;
   op.lop = Command::Nop();
   op.rop = Command::ResumeParcel(args->p);
@@ -233,12 +233,12 @@ PWCNetwork::get(hpx_addr_t lco, size_t n, void *out, int reset)
 
   // If the output buffer is already registered, then we just need to copy the
   // key into the args structure, otherwise we need to register the region.
-  auto *key = PhotonTransport::FindKeyRef(out, n);
+  auto *key = Transport::FindKeyRef(out, n);
   if (key) {
     env.request.key = *key;
   }
   else {
-    PhotonTransport::Pin(out, n, &env.request.key);
+    Transport::Pin(out, n, &env.request.key);
   }
 
   // Perform the get operation synchronously.
@@ -247,7 +247,7 @@ PWCNetwork::get(hpx_addr_t lco, size_t n, void *out, int reset)
   // If we registered the output buffer dynamically, then we need to de-register
   // it now.
   if (!key) {
-    PhotonTransport::Unpin(out, n);
+    Transport::Unpin(out, n);
   }
   return HPX_SUCCESS;
 }
@@ -24,7 +24,7 @@
 namespace {
 using libhpx::self;
 using libhpx::network::pwc::Command;
-using libhpx::network::pwc::PhotonTransport;
+using libhpx::network::pwc::Transport;
 using libhpx::network::pwc::PWCNetwork;
 }
 
@@ -43,7 +43,7 @@ _pwc_lco_wait_handler(struct hpx_parcel *p, int reset)
     dbg_error("Cannot yet return an error from a remote wait operation\n");
   }
 
-  PhotonTransport::Op op;
+  Transport::Op op;
   op.rank = curr->src;
   op.lop = Command::Nop();
   op.rop = Command::ResumeParcel(p);
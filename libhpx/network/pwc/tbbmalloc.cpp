@@ -16,7 +16,7 @@
 #endif
 
 #include "registered.h"
-#include "PhotonTransport.h"
+#include "Transport.h"
 #include "libhpx/debug.h"
 #include "libhpx/memory.h"
 #include "libhpx/system.h"
@@ -26,7 +26,7 @@
 
 namespace {
 using namespace rml;
-using libhpx::network::pwc::PhotonTransport;
+using libhpx::network::pwc::Transport;
 }
 
 static void *
@@ -37,7 +37,7 @@ _registered_chunk_alloc(intptr_t pool_id, size_t &bytes)
   if (!chunk) {
     dbg_error("failed to mmap %zu bytes anywhere in memory\n", bytes);
   }
-  PhotonTransport::Pin(chunk, bytes, nullptr);
+  Transport::Pin(chunk, bytes, nullptr);
   return chunk;
 }
 
@@ -45,7 +45,7 @@ static int
 _registered_chunk_free(intptr_t pool_id, void* raw_ptr, size_t raw_bytes)
 {
   assert(pool_id == AS_REGISTERED);
-  PhotonTransport::Unpin(raw_ptr, raw_bytes);
+  Transport::Unpin(raw_ptr, raw_bytes);
   system_munmap_huge_pages(nullptr, raw_ptr, raw_bytes);
   return 0;
 }
@@ -0,0 +1,147 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "Bootstrap.h"
+#include "libhpx/debug.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/prctl.h>
+#include <sys/uio.h>
+#endif
+
+namespace {
+using BootNetwork = libhpx::boot::Network;
+
+/// The bytes of the host name that we compare to find co-located ranks.
+constexpr size_t HOST_NAME_LENGTH = 256;
+
+#ifdef __linux__
+/// Try to read a value from our neighbor's address space.
+bool
+TryRead(const BootNetwork& boot, const std::vector<pid_t>& pids,
+        const std::vector<int*>& probes)
+{
+  int rank = boot.getRank();
+  int ranks = boot.getNRanks();
+  int peer = (rank + 1) % ranks;
+  int value = -1;
+  struct iovec local = { &value, sizeof(value) };
+  struct iovec remote = { probes[peer], sizeof(value) };
+  ssize_t e = process_vm_readv(pids[peer], &local, 1, &remote, 1, 0);
+  int ok = (e == sizeof(value) && value == peer);
+
+  std::vector<int> oks(ranks);
+  boot.allgather(&ok, &oks[0], sizeof(ok));
+  return std::all_of(oks.begin(), oks.end(), [](int i) { return i; });
+}
+#endif
+}
+
+std::vector<pid_t>
+libhpx::network::shm::GatherPids(const BootNetwork& boot, const char* what)
+{
+  int ranks = boot.getNRanks();
+  std::vector<pid_t> pids(ranks);
+  pid_t pid = getpid();
+  boot.allgather(&pid, &pids[0], sizeof(pid));
+
+  // gethostid() isn't unique across nodes on many clusters, so compare host
+  // names instead.
+  char host[HOST_NAME_LENGTH] = {0};
+  if (gethostname(host, sizeof(host) - 1)) {
+    dbg_error("could not get the host name (%d)\n", errno);
+  }
+  std::vector<char> hosts(size_t(ranks) * sizeof(host));
+  boot.allgather(host, &hosts[0], sizeof(host));
+  for (int i = 0; i < ranks; ++i) {
+    if (strncmp(&hosts[i * sizeof(host)], host, sizeof(host))) {
+      dbg_error("%s requires all ranks on one node (rank %d)\n", what, i);
+    }
+  }
+  return pids;
+}
+
+char*
+libhpx::network::shm::MapSegment(const BootNetwork& boot, const char* prefix,
+                                 pid_t root, size_t bytes)
+{
+  char name[64];
+  snprintf(name, sizeof(name), "/%s-%d", prefix, int(root));
+
+  int rank = boot.getRank();
+  int fd = -1;
+  if (rank == 0) {
+    fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+      dbg_error("could not create shared segment %s (%d)\n", name, errno);
+    }
+    if (ftruncate(fd, bytes)) {
+      dbg_error("could not size shared segment %s (%d)\n", name, errno);
+    }
+  }
+  boot.barrier();
+  if (rank != 0) {
+    fd = shm_open(name, O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+      dbg_error("could not open shared segment %s (%d)\n", name, errno);
+    }
+  }
+
+  void* base = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (base == MAP_FAILED) {
+    dbg_error("could not map shared segment %s (%d)\n", name, errno);
+  }
+  close(fd);
+  boot.barrier();
+  if (rank == 0) {
+    shm_unlink(name);
+  }
+  return static_cast<char*>(base);
+}
+
+bool
+libhpx::network::shm::ProbeCMA(const BootNetwork& boot,
+                               const std::vector<pid_t>& pids)
+{
+#ifdef __linux__
+  int rank = boot.getRank();
+  int probe = rank;
+  std::vector<int*> probes(boot.getNRanks());
+  int* addr = &probe;
+  boot.allgather(&addr, &probes[0], sizeof(addr));
+
+  bool ok = TryRead(boot, pids, probes);
+# ifdef PR_SET_PTRACER
+  if (!ok && boot.getNRanks() == 2) {
+    prctl(PR_SET_PTRACER, pids[1 - rank], 0, 0, 0);
+    ok = TryRead(boot, pids, probes);
+    if (!ok) {
+      prctl(PR_SET_PTRACER, 0, 0, 0, 0);
+    }
+  }
+# endif
+  return ok;
+#else
+  return false;
+#endif
+}
@@ -0,0 +1,74 @@
+// ==================================================================-*- C++ -*-
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifndef LIBHPX_NETWORK_SHM_BOOTSTRAP_H
+#define LIBHPX_NETWORK_SHM_BOOTSTRAP_H
+
+/// @file  libhpx/network/shm/Bootstrap.h
+///
+/// The bootstrap shared by the SHM network and the emulated PWC transport,
+/// which both map a single shared segment between all of the ranks on a node
+/// and use cross-memory attach to copy directly between address spaces.
+
+#include "libhpx/boot/Network.h"
+#include <cstddef>
+#include <vector>
+#include <sys/types.h>
+
+namespace libhpx {
+namespace network {
+namespace shm {
+
+/// Gather the process ids of all of the ranks.
+///
+/// This also checks that all of the ranks share our host, and fails with an
+/// error naming @p what if they don't.
+///
+/// @param       boot The bootstrap network.
+/// @param       what The name of the network for error messages.
+///
+/// @returns          The process ids, indexed by rank.
+std::vector<pid_t> GatherPids(const boot::Network& boot, const char* what);
+
+/// Create and map a shared segment.
+///
+/// Rank 0 creates the segment, everyone else opens it once it exists, and then
+/// rank 0 unlinks it so that it doesn't outlive the job. This is collective.
+///
+/// @param       boot The bootstrap network.
+/// @param     prefix The prefix for the segment name.
+/// @param       root The process id of rank 0, which makes the name unique.
+/// @param      bytes The size of the segment.
+///
+/// @returns          The base of the mapped segment.
+char* MapSegment(const boot::Network& boot, const char* prefix, pid_t root,
+                 size_t bytes);
+
+/// Check if cross-memory attach works between all of the ranks.
+///
+/// Cross-memory attach is subject to ptrace permissions. We check if we can
+/// read from a neighbor as things stand, and if we can't and our only peer is
+/// the one that needs access, declare it as our ptracer and try again. We
+/// never open ptrace up to arbitrary processes. This is collective.
+///
+/// @param       boot The bootstrap network.
+/// @param       pids The process ids from GatherPids().
+///
+/// @returns          true if every rank can read from its peers.
+bool ProbeCMA(const boot::Network& boot, const std::vector<pid_t>& pids);
+
+} // namespace shm
+} // namespace network
+} // namespace libhpx
+
+#endif // LIBHPX_NETWORK_SHM_BOOTSTRAP_H
@@ -0,0 +1,557 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "ShmNetwork.h"
+#include "Bootstrap.h"
+#include "libhpx/debug.h"
+#include "libhpx/events.h"
+#include "libhpx/gpa.h"
+#include "libhpx/libhpx.h"
+#include "libhpx/parcel.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/uio.h>
+#endif
+
+namespace {
+using libhpx::network::ParcelLCOOps;
+using libhpx::network::ParcelStringOps;
+using libhpx::network::shm::ShmNetwork;
+using libhpx::network::shm::GatherPids;
+using libhpx::network::shm::MapSegment;
+using libhpx::network::shm::ProbeCMA;
+using BootNetwork = libhpx::boot::Network;
+
+/// The part of the parcel that we actually transfer.
+constexpr size_t PREFIX = offsetof(hpx_parcel_t, action);
+
+size_t
+transferBytes(const hpx_parcel_t *p)
+{
+  return parcel_size(p) - PREFIX;
+}
+
+/// Allocate a parcel to receive a transfer of @p bytes from @p src.
+hpx_parcel_t*
+allocateRecv(uint32_t bytes, int src)
+{
+  uint32_t size = bytes + PREFIX - sizeof(hpx_parcel_t);
+  hpx_parcel_t *p = parcel_alloc(size);
+  p->thread = nullptr;
+  p->next = nullptr;
+  p->src = src;
+  p->size = size;
+  p->state = PARCEL_SERIALIZED;
+  return p;
+}
+}
+
+ShmNetwork::ShmNetwork(const config_t *cfg, const BootNetwork& boot, GAS *gas)
+    : Network(),
+      ParcelStringOps(),
+      ParcelLCOOps(),
+      util::Aligned<HPX_CACHELINE_SIZE>(),
+      gas_(*gas),
+      rank_(boot.getRank()),
+      ranks_(boot.getNRanks()),
+      capacity_(std::max(cfg->shm_ringsize & ~(HPX_CACHELINE_SIZE - 1),
+                         size_t(HPX_PAGE_SIZE))),
+      eager_(capacity_ / 4),
+      pgas_(gas->type() == HPX_GAS_PGAS),
+      cma_(false),
+      segment_(nullptr),
+      bytes_(0),
+      pids_(ranks_),
+      heaps_(ranks_),
+      peers_(ranks_),
+      pending_(0),
+      sends_(),
+      recvs_(),
+      lock_()
+{
+  static_assert(sizeof(Header) == 16, "unexpected record header size");
+
+  pids_ = GatherPids(boot, "SHM network");
+
+  char* heap = nullptr;
+  if (pgas_) {
+    heap = static_cast<char*>(gas->pinHeap(*this, nullptr));
+  }
+  boot.allgather(&heap, &heaps_[0], sizeof(heap));
+
+  bytes_ = size_t(ranks_) * ranks_ * (sizeof(Ring) + capacity_);
+  segment_ = MapSegment(boot, "libhpx-shm", pids_[0], bytes_);
+
+  // If cross-memory attach isn't available then large parcels are copied
+  // through the rings in fragments, and memget and memput use parcels.
+  cma_ = ProbeCMA(boot, pids_);
+
+  log_net("SHM network mapped %zu bytes with %zu byte rings (cma %d)\n",
+          bytes_, size_t(capacity_), cma_);
+}
+
+ShmNetwork::~ShmNetwork()
+{
+  for (auto& peer : peers_) {
+    for (auto& send : peer.sends) {
+      parcel_delete(send.first);
+    }
+    if (peer.recv) {
+      parcel_delete(peer.recv);
+    }
+  }
+  while (hpx_parcel_t *p = sends_.dequeue()) {
+    parcel_delete(p);
+  }
+  while (hpx_parcel_t *p = recvs_.dequeue()) {
+    parcel_delete(p);
+  }
+  munmap(segment_, bytes_);
+}
+
+int
+ShmNetwork::type() const
+{
+  return HPX_NETWORK_SHM;
+}
+
+ShmNetwork::Ring*
+ShmNetwork::ring(int src, int dst) const
+{
+  size_t i = size_t(src) * ranks_ + dst;
+  return reinterpret_cast<Ring*>(segment_ + i * (sizeof(Ring) + capacity_));
+}
+
+uint64_t
+ShmNetwork::RecordSize(const Header& header)
+{
+  uint64_t bytes = sizeof(Header);
+  if (header.type == EAGER || header.type == FRAGMENT || header.type == PAD) {
+    bytes += header.bytes;
+  }
+  return (bytes + sizeof(Header) - 1) & ~(sizeof(Header) - 1);
+}
+
+bool
+ShmNetwork::write(int dst, const Header& header, const void *data)
+{
+  Ring* r = ring(rank_, dst);
+  char* buffer = reinterpret_cast<char*>(r + 1);
+  uint64_t record = RecordSize(header);
+  uint64_t tail = r->tail.load(std::memory_order_relaxed);
+  uint64_t head = r->head.load(std::memory_order_acquire);
+
+  // Records are contiguous, so if this one doesn't fit before the end of the
+  // ring we have to pad out the remainder.
+  uint64_t offset = tail % capacity_;
+  uint64_t pad = (capacity_ - offset < record) ? capacity_ - offset : 0;
+  if (capacity_ - (tail - head) < pad + record) {
+    return false;
+  }
+
+  if (pad) {
+    Header* h = reinterpret_cast<Header*>(buffer + offset);
+    h->type = PAD;
+    h->bytes = uint32_t(pad - sizeof(Header));
+    h->addr = 0;
+    tail += pad;
+    offset = 0;
+  }
+
+  Header* h = reinterpret_cast<Header*>(buffer + offset);
+  *h = header;
+  if (header.type == EAGER || header.type == FRAGMENT) {
+    std::memcpy(h + 1, data, header.bytes);
+  }
+  r->tail.store(tail + record, std::memory_order_release);
+  return true;
+}
+
+void
+ShmNetwork::read(int src, hpx_parcel_t **stack)
+{
+  Ring* r = ring(src, rank_);
+  const char* buffer = reinterpret_cast<const char*>(r + 1);
+  uint64_t head = r->head.load(std::memory_order_relaxed);
+  uint64_t tail = r->tail.load(std::memory_order_acquire);
+  if (head == tail) {
+    return;
+  }
+
+  for (; head != tail; ) {
+    auto h = reinterpret_cast<const Header*>(buffer + head % capacity_);
+    hpx_parcel_t *p = nullptr;
+    switch (h->type) {
+     case PAD:
+      break;
+
+     case EAGER:
+      p = allocateRecv(h->bytes, src);
+      std::memcpy(&p->action, h + 1, h->bytes);
+      break;
+
+     case RENDEZVOUS:
+      p = allocateRecv(h->bytes, src);
+      readFrom(src, &p->action, reinterpret_cast<char*>(h->addr) + PREFIX,
+               h->bytes);
+      peers_[src].acks.push_back(h->addr);
+      break;
+
+     case FRAGMENT: {
+      Peer& peer = peers_[src];
+      if (!peer.recv) {
+        peer.recv = allocateRecv(uint32_t(h->addr), src);
+        peer.recvd = 0;
+      }
+      char* to = reinterpret_cast<char*>(&peer.recv->action) + peer.recvd;
+      std::memcpy(to, h + 1, h->bytes);
+      peer.recvd += h->bytes;
+      if (peer.recvd == h->addr) {
+        p = peer.recv;
+        peer.recv = nullptr;
+      }
+      break;
+     }
+
+     case ACK: {
+      hpx_parcel_t *q = reinterpret_cast<hpx_parcel_t*>(h->addr);
+      hpx_parcel_t *ssync = q->next;
+      q->next = nullptr;
+      parcel_delete(q);
+      while (hpx_parcel_t *s = parcel_stack_pop(&ssync)) {
+        parcel_stack_push(stack, s);
+      }
+      --pending_;
+      break;
+     }
+
+     default:
+      dbg_error("unexpected SHM record type %u from %d\n", h->type, src);
+    }
+
+    if (p) {
+      log_net("received a %u-byte payload from %d\n", p->size, src);
+      EVENT_PARCEL_RECV(p->id, p->action, p->size, p->src, p->target);
+      parcel_stack_push(stack, p);
+    }
+    head += RecordSize(*h);
+  }
+
+  r->head.store(head, std::memory_order_release);
+}
+
+bool
+ShmNetwork::trySend(int dst, hpx_parcel_t *p, hpx_parcel_t *ssync)
+{
+  Header h;
+  h.bytes = uint32_t(transferBytes(p));
+  if (RecordSize(Header{EAGER, h.bytes, 0}) <= eager_) {
+    h.type = EAGER;
+    h.addr = 0;
+    if (!write(dst, h, &p->action)) {
+      return false;
+    }
+    parcel_delete(p);
+    if (ssync) {
+      recvs_.enqueue(ssync);
+    }
+    return true;
+  }
+
+  if (!cma_) {
+    return trySendFragments(dst, p, ssync);
+  }
+
+  // The receiver will read the parcel out of our address space and ack it, so
+  // we keep it, and its ssync continuation, until then.
+  h.type = RENDEZVOUS;
+  h.addr = reinterpret_cast<uint64_t>(p);
+  if (!write(dst, h, nullptr)) {
+    return false;
+  }
+  p->next = ssync;
+  ++pending_;
+  return true;
+}
+
+bool
+ShmNetwork::trySendFragments(int dst, hpx_parcel_t *p, hpx_parcel_t *ssync)
+{
+  Peer& peer = peers_[dst];
+  const char* data = reinterpret_cast<const char*>(&p->action);
+  uint32_t total = uint32_t(transferBytes(p));
+  uint32_t max = eager_ - sizeof(Header);
+  while (peer.sent < total) {
+    uint32_t n = std::min(max, total - peer.sent);
+    if (!write(dst, Header{FRAGMENT, n, total}, data + peer.sent)) {
+      return false;
+    }
+    peer.sent += n;
+  }
+
+  peer.sent = 0;
+  parcel_delete(p);
+  if (ssync) {
+    recvs_.enqueue(ssync);
+  }
+  return true;
+}
+
+void
+ShmNetwork::sendAll()
+{
+  while (hpx_parcel_t *p = sends_.dequeue()) {
+    hpx_parcel_t *ssync = p->next;
+    p->next = nullptr;
+    int dst = gas_.ownerOf(p->target);
+    peers_[dst].sends.emplace_back(p, ssync);
+  }
+
+  for (int i = 0; i < ranks_; ++i) {
+    Peer& peer = peers_[i];
+
+    auto ack = peer.acks.begin();
+    for (; ack != peer.acks.end(); ++ack) {
+      if (!write(i, Header{ACK, 0, *ack}, nullptr)) {
+        break;
+      }
+    }
+    peer.acks.erase(peer.acks.begin(), ack);
+
+    while (!peer.sends.empty()) {
+      auto& send = peer.sends.front();
+      if (!trySend(i, send.first, send.second)) {
+        break;
+      }
+      peer.sends.pop_front();
+    }
+  }
+}
+
+void
+ShmNetwork::poll()
+{
+  sendAll();
+  hpx_parcel_t *chain = nullptr;
+  for (int i = 0; i < ranks_; ++i) {
+    if (i != rank_) {
+      read(i, &chain);
+    }
+  }
+  if (chain) {
+    recvs_.enqueue(chain);
+  }
+
+  // Reading may have generated acks, and freed up space in the rings.
+  sendAll();
+}
+
+void
+ShmNetwork::progress(int)
+{
+  if (auto _ = std::unique_lock<std::mutex>(lock_, std::try_to_lock)) {
+    poll();
+  }
+}
+
+hpx_parcel_t*
+ShmNetwork::probe(int)
+{
+  return recvs_.dequeue();
+}
+
+void
+ShmNetwork::flush()
+{
+  std::lock_guard<std::mutex> _(lock_);
+  for (;;) {
+    poll();
+    bool empty = (pending_ == 0);
+    for (auto& peer : peers_) {
+      empty = empty && peer.sends.empty() && peer.acks.empty();
+    }
+    if (empty) {
+      return;
+    }
+    sched_yield();
+  }
+}
+
+int
+ShmNetwork::send(hpx_parcel_t *p, hpx_parcel_t *ssync)
+{
+  // Use the unused parcel-next pointer to get the ssync continuation parcels
+  // through the concurrent queue, along with the primary parcel.
+  p->next = ssync;
+  sends_.enqueue(p);
+  return 0;
+}
+
+void
+ShmNetwork::deallocate(const hpx_parcel_t* p)
+{
+  dbg_error("SHM network has no network-managed parcels\n");
+}
+
+void
+ShmNetwork::pin(const void *base, size_t n, void *key)
+{
+}
+
+void
+ShmNetwork::unpin(const void* base, size_t n)
+{
+}
+
+int
+ShmNetwork::init(void **)
+{
+  return LIBHPX_OK;
+}
+
+int
+ShmNetwork::sync(void *in, size_t in_size, void* out, void *collective)
+{
+  dbg_error("SHM network does not support network collectives\n");
+}
+
+bool
+ShmNetwork::useCMA() const
+{
+  return (cma_ && pgas_);
+}
+
+void
+ShmNetwork::readFrom(int rank, void *to, const void *from, size_t n) const
+{
+#ifdef __linux__
+  char* dest = static_cast<char*>(to);
+  const char* src = static_cast<const char*>(from);
+  while (n) {
+    struct iovec local = { dest, n };
+    struct iovec remote = { const_cast<char*>(src), n };
+    ssize_t e = process_vm_readv(pids_[rank], &local, 1, &remote, 1, 0);
+    if (e <= 0) {
+      dbg_error("could not read %zu bytes from rank %d (%d)\n", n, rank, errno);
+    }
+    dest += e;
+    src += e;
+    n -= e;
+  }
+#else
+  dbg_error("SHM network cross-memory attach is unavailable\n");
+#endif
+}
+
+void
+ShmNetwork::writeTo(int rank, void *to, const void *from, size_t n) const
+{
+#ifdef __linux__
+  char* dest = static_cast<char*>(to);
+  const char* src = static_cast<const char*>(from);
+  while (n) {
+    struct iovec local = { const_cast<char*>(src), n };
+    struct iovec remote = { dest, n };
+    ssize_t e = process_vm_writev(pids_[rank], &local, 1, &remote, 1, 0);
+    if (e <= 0) {
+      dbg_error("could not write %zu bytes to rank %d (%d)\n", n, rank, errno);
+    }
+    dest += e;
+    src += e;
+    n -= e;
+  }
+#else
+  dbg_error("SHM network cross-memory attach is unavailable\n");
+#endif
+}
+
+void
+ShmNetwork::memget(void *to, hpx_addr_t from, size_t n, hpx_addr_t lsync,
+                   hpx_addr_t rsync)
+{
+  if (!useCMA()) {
+    ParcelStringOps::memget(to, from, n, lsync, rsync);
+    return;
+  }
+
+  int rank = gpa_to_rank(from);
+  readFrom(rank, to, heaps_[rank] + gpa_to_offset(from), n);
+  hpx_lco_set(lsync, 0, NULL, HPX_NULL, HPX_NULL);
+  hpx_lco_set(rsync, 0, NULL, HPX_NULL, HPX_NULL);
+}
+
+void
+ShmNetwork::memget(void *to, hpx_addr_t from, size_t n, hpx_addr_t lsync)
+{
+  if (!useCMA()) {
+    ParcelStringOps::memget(to, from, n, lsync);
+    return;
+  }
+  memget(to, from, n, lsync, HPX_NULL);
+}
+
+void
+ShmNetwork::memget(void *to, hpx_addr_t from, size_t n)
+{
+  if (!useCMA()) {
+    ParcelStringOps::memget(to, from, n);
+    return;
+  }
+  memget(to, from, n, HPX_NULL, HPX_NULL);
+}
+
+void
+ShmNetwork::memput(hpx_addr_t to, const void *from, size_t n, hpx_addr_t lsync,
+                   hpx_addr_t rsync)
+{
+  if (!useCMA()) {
+    ParcelStringOps::memput(to, from, n, lsync, rsync);
+    return;
+  }
+
+  int rank = gpa_to_rank(to);
+  writeTo(rank, heaps_[rank] + gpa_to_offset(to), from, n);
+  hpx_lco_set(lsync, 0, NULL, HPX_NULL, HPX_NULL);
+  hpx_lco_set(rsync, 0, NULL, HPX_NULL, HPX_NULL);
+}
+
+void
+ShmNetwork::memput(hpx_addr_t to, const void *from, size_t n, hpx_addr_t rsync)
+{
+  if (!useCMA()) {
+    ParcelStringOps::memput(to, from, n, rsync);
+    return;
+  }
+  memput(to, from, n, HPX_NULL, rsync);
+}
+
+void
+ShmNetwork::memput(hpx_addr_t to, const void *from, size_t n)
+{
+  if (!useCMA()) {
+    ParcelStringOps::memput(to, from, n);
+    return;
+  }
+  memput(to, from, n, HPX_NULL, HPX_NULL);
+}
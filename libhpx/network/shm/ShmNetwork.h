@@ -0,0 +1,187 @@
+// ==================================================================-*- C++ -*-
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifndef LIBHPX_NETWORK_SHM_SHM_NETWORK_H
+#define LIBHPX_NETWORK_SHM_SHM_NETWORK_H
+
+#include "libhpx/Network.h"
+#include "libhpx/ParcelLCOOps.h"
+#include "libhpx/ParcelStringOps.h"
+#include "libhpx/boot/Network.h"
+#include "libhpx/util/Aligned.h"
+#include "libhpx/util/TwoLockQueue.h"
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <sys/types.h>
+
+namespace libhpx {
+namespace network {
+namespace shm {
+
+/// A network for multiple localities that share a single node.
+///
+/// All of the localities map a single shared memory segment that holds a
+/// single-producer single-consumer byte ring for each ordered pair of ranks.
+/// Small parcels are copied through the rings. Large parcels are sent as a
+/// rendezvous record that the receiver uses to read the parcel directly out of
+/// the sender's address space with cross-memory attach (process_vm_readv), so
+/// that they are only copied once. The same mechanism implements single-copy
+/// memget and memput for the PGAS heap. When cross-memory attach isn't
+/// permitted, large parcels are copied through the rings in fragments and
+/// memget and memput fall back to parcels.
+///
+/// Like the funneled ISIR network, all of the rings are serviced by whichever
+/// thread holds the progress lock, and send() only enqueues the parcel.
+class ShmNetwork final : public Network, public ParcelStringOps,
+                         public ParcelLCOOps,
+                         public util::Aligned<HPX_CACHELINE_SIZE>
+{
+ public:
+  ShmNetwork(const config_t *cfg, const boot::Network& boot, GAS *gas);
+  ~ShmNetwork();
+
+  int type() const;
+  void progress(int);
+  hpx_parcel_t* probe(int);
+  void flush();
+
+  void deallocate(const hpx_parcel_t* p);
+  int send(hpx_parcel_t* p, hpx_parcel_t* ssync);
+
+  void pin(const void *base, size_t bytes, void *key);
+  void unpin(const void *base, size_t bytes);
+
+  int init(void **collective);
+  int sync(void *in, size_t in_size, void* out, void *collective);
+
+  void memget(void *to, hpx_addr_t from, size_t n, hpx_addr_t lsync,
+              hpx_addr_t rsync);
+  void memget(void *to, hpx_addr_t from, size_t n, hpx_addr_t lsync);
+  void memget(void *to, hpx_addr_t from, size_t n);
+  void memput(hpx_addr_t to, const void *from, size_t n, hpx_addr_t lsync,
+              hpx_addr_t rsync);
+  void memput(hpx_addr_t to, const void *from, size_t n, hpx_addr_t rsync);
+  void memput(hpx_addr_t to, const void *from, size_t n);
+
+ private:
+  using ParcelQueue = libhpx::util::TwoLockQueue<hpx_parcel_t*>;
+
+  /// The record types that we write into the rings.
+  enum : uint32_t {
+    PAD,                                        //!< skip to the ring start
+    EAGER,                                      //!< an inline parcel
+    RENDEZVOUS,                                 //!< a parcel to read with CMA
+    ACK,                                        //!< a rendezvous is complete
+    FRAGMENT                                    //!< part of an inline parcel
+  };
+
+  /// Every record is prefixed by a header and padded to the header alignment.
+  ///
+  /// The addr field is the sender's parcel for RENDEZVOUS and ACK records, and
+  /// the total bytes of the parcel for FRAGMENT records.
+  struct Header {
+    uint32_t  type;                             //!< the record type
+    uint32_t bytes;                             //!< the payload bytes
+    uint64_t  addr;                             //!< the sender's parcel
+  };
+
+  /// The control block for one ring, followed by its data in the segment.
+  ///
+  /// The head and tail are monotonic byte counters. Only the receiver writes
+  /// the head and only the sender writes the tail.
+  struct Ring {
+    alignas(HPX_CACHELINE_SIZE) std::atomic<uint64_t> head;
+    alignas(HPX_CACHELINE_SIZE) std::atomic<uint64_t> tail;
+  };
+
+  /// The local state for each peer.
+  ///
+  /// The fragments of a parcel are written in order, with nothing but acks
+  /// between them, so we only need to track one partial send and one partial
+  /// receive per peer.
+  struct Peer {
+    std::deque<std::pair<hpx_parcel_t*, hpx_parcel_t*>> sends;
+    std::vector<uint64_t> acks;
+    uint32_t sent = 0;                          //!< bytes of sends.front()
+    hpx_parcel_t* recv = nullptr;               //!< the partial receive
+    uint32_t recvd = 0;                         //!< bytes of recv
+  };
+
+  /// Find the ring that @p src uses to send to @p dst.
+  Ring* ring(int src, int dst) const;
+
+  /// The number of ring bytes used by a record.
+  static uint64_t RecordSize(const Header& header);
+
+  /// Try to write a record into the ring for @p dst.
+  ///
+  /// @param     header The record header.
+  /// @param       data The inline data for an EAGER or FRAGMENT record.
+  ///
+  /// @returns          false if the ring doesn't have room for the record.
+  bool write(int dst, const Header& header, const void *data);
+
+  /// Process all of the records that @p src has written to us.
+  ///
+  /// @param      stack A stack to push the received parcels onto.
+  void read(int src, hpx_parcel_t **stack);
+
+  /// Try to send a single parcel to @p dst.
+  bool trySend(int dst, hpx_parcel_t *p, hpx_parcel_t *ssync);
+
+  /// Try to finish sending a large parcel to @p dst through the ring.
+  ///
+  /// This writes as many fragments as fit, and records its progress in the
+  /// peer so that it can resume when the ring drains.
+  bool trySendFragments(int dst, hpx_parcel_t *p, hpx_parcel_t *ssync);
+
+  /// Write as many of the pending acks and sends as possible.
+  void sendAll();
+
+  /// Service the rings, this must be called with the lock held.
+  void poll();
+
+  /// Check to see if we can use cross-memory attach for memget and memput.
+  bool useCMA() const;
+
+  /// Copy bytes to or from a peer's address space.
+  /// @{
+  void readFrom(int rank, void *to, const void *from, size_t n) const;
+  void writeTo(int rank, void *to, const void *from, size_t n) const;
+  /// @}
+
+  const GAS&           gas_;
+  const int           rank_;
+  const int          ranks_;
+  const uint64_t  capacity_;
+  const uint32_t     eager_;
+  const bool          pgas_;
+  bool                 cma_;
+  char*            segment_;
+  size_t             bytes_;
+  std::vector<pid_t>  pids_;
+  std::vector<char*> heaps_;
+  std::vector<Peer>  peers_;
+  int              pending_;                    //!< outstanding rendezvous
+  ParcelQueue        sends_;
+  ParcelQueue        recvs_;
+  std::mutex          lock_;
+};
+
+} // namespace shm
+} // namespace network
+} // namespace libhpx
+
+#endif // LIBHPX_NETWORK_SHM_SHM_NETWORK_H
@@ -20,6 +20,7 @@
 #include "libhpx/debug.h"
 #include "libhpx/memory.h"
 #include "libhpx/Network.h"
+#include <algorithm>
 #include <cstring>
 #ifdef HAVE_APEX
 #include <sys/time.h>
@@ -42,16 +43,22 @@ Scheduler::Scheduler(const config_t* cfg)
       nextTlsId_(0),
       code_(HPX_SUCCESS),
       nActive_(cfg->threads),
+      nParked_(0),
       spmdCount_(0),
       nWorkers_(cfg->threads),
       nTarget_(cfg->threads),
+      nLimit_(cfg->threads),
+      nextRR_(0),
+      wakeFanout_(cfg->sched_wakefanout),
+      pollers_(cfg->progress_thread ? 0 : 1),
+      elastic_(cfg->sched_elastic),
       epoch_(0),
       spmd_(0),
       nsWait_(cfg->progress_period),
       output_(nullptr),
       workers_(nWorkers_)
 {
-  Thread::SetStackSize(cfg->stacksize);
+  Thread::InitStacks(cfg->stacksize);
 
   // This thread can allocate even though it's not a scheduler thread.
   as_join(AS_REGISTERED);
@@ -67,6 +74,7 @@ Scheduler::~Scheduler()
       delete w;
     }
   }
+  Thread::FiniStacks();
   as_leave();
 }
 
@@ -92,11 +100,17 @@ Scheduler::start(int spmd, hpx_action_t act, void *out, int n, va_list *args)
     workers_[0]->pushMail(p);
   }
 
-  // switch the state and then start all the workers
+  // switch the state and then start the target workers, the rest are woken
+  // so that they forward anything left in their queues
   setCode(HPX_SUCCESS);
   setState(RUN);
-  for (auto&& w : workers_) {
-    w->start();
+  for (int i = 0, e = nWorkers_, n = getNTarget(); i < e; ++i) {
+    if (i < n) {
+      workers_[i]->start();
+    }
+    else {
+      workers_[i]->stop();
+    }
   }
 
   // wait for someone to stop the scheduler
@@ -134,26 +148,98 @@ Scheduler::start(int spmd, hpx_action_t act, void *out, int n, va_list *args)
 void
 Scheduler::wait(std::unique_lock<std::mutex>&& lock)
 {
+  int limit = getLimit();
 #ifdef HAVE_APEX
+  limit = std::min(apex_get_thread_cap(), limit);
+#endif
+  limit = std::max(limit, 1);
+  resize((elastic_) ? elasticTarget(limit) : limit);
+  stopped_.wait_for(lock, nsWait_);
+}
+
+int
+Scheduler::elasticTarget(int limit)
+{
+  int n = getNTarget();
+  if (limit < n) {
+    return limit;
+  }
+
+  uint64_t depth = 0;
+  uint64_t steals = 0;
+  uint64_t failed = 0;
+  for (int i = 0; i < n; ++i) {
+    depth += workers_[i]->getQueueDepth();
+    workers_[i]->takeStealCounts(steals, failed);
+  }
+
+  if (n < limit && uint64_t(n * ELASTIC_GROW_DEPTH) < depth) {
+    return n + 1;
+  }
+
+  if (1 < n && !depth && steals &&
+      uint64_t(ELASTIC_SHRINK_PERCENT) * steals < 100 * failed) {
+    return n - 1;
+  }
+
+  return n;
+}
+
+void
+Scheduler::resize(int n)
+{
   using std::min;
   using std::max;
-  int prev = nTarget_;
-  nTarget_ = min(apex_get_thread_cap(), nWorkers_);
-  if (prev != nTarget_) {
-    log_sched("apex adjusting from %d to %d workers\n", prev, nTarget_);
+  int prev = getNTarget();
+  if (prev == n) {
+    return;
   }
-  for (int i = min(prev, nTarget_), e = max(prev, nTarget_); i < e; ++i) {
+
+  log_sched("adjusting from %d to %d workers\n", prev, n);
+  nTarget_.store(n, std::memory_order_release);
+  for (int i = min(prev, n), e = max(prev, n); i < e; ++i) {
     dbg_assert(workers_[i]);
-    if (nTarget_ < prev) {
+    if (n < prev) {
       workers_[i]->stop();
     }
     else {
       workers_[i]->start();
     }
   }
-#endif
+}
 
-  stopped_.wait_for(lock, nsWait_);
+int
+Scheduler::setLimit(int n)
+{
+  n = std::max(1, std::min(n, nWorkers_));
+  std::lock_guard<std::mutex> _(lock_);
+  nLimit_.store(n, std::memory_order_relaxed);
+  stopped_.notify_all();
+  return n;
+}
+
+void
+Scheduler::unparkSlow(int id)
+{
+  // Stopped workers are never parked, so only look at the running ones.
+  int e = getNTarget();
+  for (int i = 1, n = wakeFanout_; i <= e && 0 < n; ++i) {
+    if (workers_[(id + i) % e]->unpark()) {
+      --n;
+    }
+  }
+}
+
+void
+Scheduler::spawn(hpx_parcel_t* p)
+{
+  dbg_assert(p);
+  int n = getNTarget();
+  int affinity = Worker::GetAffinity(p);
+  if (affinity < 0 || n <= affinity) {
+    affinity = nextRR_.fetch_add(1, std::memory_order_relaxed) % n;
+  }
+  workers_[affinity]->pushMail(p);
 }
 
 void
@@ -0,0 +1,200 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "StackPool.h"
+#include "libhpx/debug.h"
+#include "libhpx/locality.h"
+#include "libhpx/Network.h"
+#include "libhpx/Topology.h"
+#include <sys/mman.h>
+#include <errno.h>
+#include <mutex>
+#include <new>
+
+#ifndef MAP_NORESERVE
+# define MAP_NORESERVE 0
+#endif
+
+#ifndef MAP_ANONYMOUS
+# define MAP_ANONYMOUS MAP_ANON
+#endif
+
+namespace {
+using libhpx::scheduler::StackPool;
+}
+
+size_t StackPool::Bytes_ = 0;
+size_t StackPool::Guard_ = 0;
+bool StackPool::Release_ = true;
+StackPool::Node* StackPool::Nodes_ = nullptr;
+int StackPool::NNodes_ = 0;
+
+void
+StackPool::Init(size_t bytes, bool guard)
+{
+  dbg_assert(!Nodes_);
+  dbg_assert((bytes & (HPX_PAGE_SIZE - 1)) == 0);
+  Bytes_ = bytes;
+  Guard_ = (guard) ? HPX_PAGE_SIZE : 0;
+#ifdef HAVE_PHOTON
+  // Photon registers the slabs with the NIC, which keeps the physical pages
+  // pinned, so releasing them would leave the registration pointing at pages
+  // that the stack no longer maps.
+  Release_ = !(here->net && here->net->type() == HPX_NETWORK_PWC);
+#else
+  Release_ = true;
+#endif
+  NNodes_ = (here->topology->nnodes > 0) ? here->topology->nnodes : 1;
+  Nodes_ = new Node[NNodes_]();
+}
+
+void
+StackPool::Fini()
+{
+  size_t stride = Guard_ + Bytes_;
+  size_t bytes = SLAB_STACKS * stride + Guard_;
+  for (int i = 0; i < NNodes_; ++i) {
+    for (void* slab : Nodes_[i].slabs) {
+      Unpin(static_cast<char*>(slab));
+      if (munmap(slab, bytes)) {
+        log_error("failed to unmap stack slab %p (%d)\n", slab, errno);
+      }
+    }
+  }
+  delete [] Nodes_;
+  Nodes_ = nullptr;
+  NNodes_ = 0;
+}
+
+void*
+StackPool::Allocate(int node)
+{
+  if (node < 0 || NNodes_ <= node) {
+    node = 0;
+  }
+
+  Node& pool = Nodes_[node];
+  std::lock_guard<TatasLock<short>> _(pool.lock);
+  if (!pool.free) {
+    Refill(pool, node);
+  }
+
+  Stack* stack = pool.free;
+  pool.free = stack->next;
+  return stack;
+}
+
+void
+StackPool::Deallocate(void* stack, int node)
+{
+  if (node < 0 || NNodes_ <= node) {
+    node = 0;
+  }
+
+  // Release everything but the top page, which is the only page that an
+  // unused stack is guaranteed to touch. The freelist node lives at the bottom
+  // of the stack, so we have to do this before pushing it.
+  if (Release_ && Bytes_ > HPX_PAGE_SIZE) {
+    if (madvise(stack, Bytes_ - HPX_PAGE_SIZE, MADV_DONTNEED)) {
+      log_sched("failed to release stack pages at %p (%d)\n", stack, errno);
+    }
+  }
+
+  Node& pool = Nodes_[node];
+  std::lock_guard<TatasLock<short>> _(pool.lock);
+  Stack* s = static_cast<Stack*>(stack);
+  s->next = pool.free;
+  pool.free = s;
+}
+
+void
+StackPool::Refill(Node& pool, int node)
+{
+  // Each stack is preceded by a guard page (if we're using them), and the last
+  // stack is followed by one so that each stack is guarded on both sides.
+  size_t stride = Guard_ + Bytes_;
+  size_t bytes = SLAB_STACKS * stride + Guard_;
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+  void* slab = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, flags, -1, 0);
+  if (slab == MAP_FAILED) {
+    log_error("failed to map %zu bytes of stacks (%d)\n", bytes, errno);
+    throw std::bad_alloc();
+  }
+
+  // Bind the slab before any of its pages are touched, so that they're
+  // committed on the right node.
+  if (here->topology->numa_nodes && 1 < NNodes_) {
+    auto obj = here->topology->numa_nodes[node];
+    if (libhpx_hwloc_set_area_membind(here->topology->hwloc_topology, slab,
+                                      bytes, obj->cpuset,
+                                      LIBHPX_HWLOC_MEMBIND_BIND, 0)) {
+      log_sched("could not bind stacks at %p to node %d\n", slab, node);
+    }
+  }
+
+  char* base = static_cast<char*>(slab);
+  if (Guard_) {
+    for (int i = 0; i <= SLAB_STACKS; ++i) {
+      if (mprotect(base + i * stride, Guard_, PROT_NONE)) {
+        dbg_error("Mprotect error: %d (EACCES %d, EINVAL %d, ENOMEM %d)\n",
+                  errno, EACCES, EINVAL, ENOMEM);
+      }
+    }
+  }
+
+  // Thread the stacks so that they are allocated in address order. This
+  // commits the page at the base of each stack, which the thread header will
+  // occupy anyway.
+  for (int i = SLAB_STACKS - 1; i >= 0; --i) {
+    Stack* stack = reinterpret_cast<Stack*>(base + i * stride + Guard_);
+    stack->next = pool.free;
+    pool.free = stack;
+  }
+
+  Pin(base);
+  pool.slabs.push_back(slab);
+  log_sched("mapped %d %zu byte stacks for node %d at %p\n", SLAB_STACKS,
+            Bytes_, node, slab);
+}
+
+void
+StackPool::Pin(char* slab)
+{
+  // Lightweight stacks are implicitly registered for memget/memput, but the
+  // network can't register the guard pages.
+  if (!Guard_) {
+    here->net->pin(slab, SLAB_STACKS * Bytes_, nullptr);
+    return;
+  }
+
+  for (int i = 0; i < SLAB_STACKS; ++i) {
+    here->net->pin(slab + i * (Guard_ + Bytes_) + Guard_, Bytes_, nullptr);
+  }
+}
+
+void
+StackPool::Unpin(char* slab)
+{
+  if (!Guard_) {
+    here->net->unpin(slab, SLAB_STACKS * Bytes_);
+    return;
+  }
+
+  for (int i = 0; i < SLAB_STACKS; ++i) {
+    here->net->unpin(slab + i * (Guard_ + Bytes_) + Guard_, Bytes_);
+  }
+}
@@ -0,0 +1,111 @@
+// ==================================================================-*- C++ -*-
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#ifndef LIBHPX_SCHEDULER_STACK_POOL_H
+#define LIBHPX_SCHEDULER_STACK_POOL_H
+
+#include "TatasLock.h"
+#include "hpx/hpx.h"
+#include <cstddef>
+#include <vector>
+
+namespace libhpx {
+namespace scheduler {
+
+/// A per-NUMA-node pool of lightweight thread stacks.
+///
+/// Stacks are carved out of slabs of virtual memory that are reserved with
+/// mmap(MAP_NORESERVE) and bound to their NUMA node, so physical pages are
+/// only committed, on the right node, when a thread actually touches them. This
+/// makes it cheap to configure large stacks for the occasional deep thread.
+///
+/// When stack protection is enabled every stack is separated from its
+/// neighbors by a PROT_NONE guard page. The guard pages are protected once,
+/// when the slab is mapped, so recycling a stack never costs an mprotect().
+///
+/// Stacks that are returned to the pool release their committed pages, other
+/// than the top page, back to the operating system. Workers cache stacks
+/// locally and only return them to the pool in bulk, so this is off the
+/// critical path.
+///
+/// Lightweight stacks are implicitly registered for memget and memput, so each
+/// slab is pinned with the network when it is mapped. Networks that pin by
+/// faulting in pages will commit the slab at that point, and stacks are not
+/// released back to the operating system when the network registers memory
+/// with the NIC.
+class StackPool {
+ public:
+  /// Initialize the pool.
+  ///
+  /// @param      bytes The usable size of each stack, a multiple of the page
+  ///                   size.
+  /// @param      guard true if the stacks should be separated by guard pages.
+  static void Init(size_t bytes, bool guard);
+
+  /// Unmap all of the stacks.
+  ///
+  /// This must be called after all of the stacks have been returned.
+  static void Fini();
+
+  /// Allocate a stack.
+  ///
+  /// @param       node The NUMA node that the stack should be allocated on.
+  ///
+  /// @returns          The lowest address of the stack.
+  ///
+  /// @throws std::bad_alloc if the pool could not reserve more memory.
+  static void* Allocate(int node);
+
+  /// Return a stack to the pool.
+  ///
+  /// @param      stack The stack, as returned from Allocate().
+  /// @param       node The node that was passed to Allocate().
+  static void Deallocate(void* stack, int node);
+
+ private:
+  static constexpr int SLAB_STACKS = 16;
+
+  /// The freelist node that overlays a free stack.
+  struct Stack {
+    Stack* next;
+  };
+
+  /// The pool for a single NUMA node.
+  struct Node {
+    TatasLock<short> lock;                      //!< protects the fields
+    Stack* free;                                //!< free stacks
+    std::vector<void*> slabs;                   //!< the mapped slabs
+  };
+
+  /// Map a new slab and thread its stacks onto the node's freelist.
+  ///
+  /// The caller must hold the node's lock.
+  static void Refill(Node& pool, int node);
+
+  /// Register and deregister a slab's stacks with the network.
+  /// @{
+  static void Pin(char* slab);
+  static void Unpin(char* slab);
+  /// @}
+
+  static size_t    Bytes_;                      //!< usable bytes per stack
+  static size_t    Guard_;                      //!< guard bytes per stack
+  static bool    Release_;                      //!< release freed stacks
+  static Node*     Nodes_;                      //!< the per-node pools
+  static int      NNodes_;                      //!< the number of pools
+};
+
+} // namespace scheduler
+} // namespace libhpx
+
+#endif // LIBHPX_SCHEDULER_STACK_POOL_H
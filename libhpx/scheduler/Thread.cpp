@@ -16,20 +16,18 @@
 #endif
 
 #include "Thread.h"
+#include "StackPool.h"
 #include "libhpx/debug.h"
 #include "libhpx/memory.h"
 #include "libhpx/process.h"
 #include "libhpx/Scheduler.h"
 #include <valgrind/valgrind.h>
-#include <sys/mman.h>
-#include <errno.h>
 
 namespace {
 using libhpx::scheduler::Thread;
 }
 
 size_t Thread::Size_;
-size_t Thread::Buffer_;
 
 Thread::Thread(hpx_parcel_t* p, Entry f)
     : sp_(nullptr),
@@ -61,98 +59,67 @@ Thread::~Thread()
   assert(canary_ == CANARY_ && "Stack corrupted (try --hpx-dbg-mprotectstacks");
 }
 
-void
-Thread::ProtectBoundaryPages(void *base, int prot) {
-  if (!ProtectStacks()) {
-    return;
-  }
-
-  if ((uintptr_t)base & (HPX_PAGE_SIZE - 1)) {
-    dbg_error("stack must be page aligned for mprotect\n");
-  }
-
-  void *end = static_cast<char*>(base) + HPX_PAGE_SIZE + Size_;
-  int e1 = mprotect(base, HPX_PAGE_SIZE, prot);
-  int e2 = mprotect(end, HPX_PAGE_SIZE, prot);
-
-  if (e1 || e2) {
-    dbg_error("Mprotect error: %d (EACCES %d, EINVAL %d, ENOMEM %d)\n", errno,
-              EACCES, EINVAL, ENOMEM);
-  }
-}
-
-/// The operator new is responsible for allocating a thread, protecting its
-/// boundary pages, if necessary, and informing valgrind that we're going to
-/// context switch to its stack to suppress false positives. This requires some
-/// C-style pointer manipulation.
+/// The operator new is responsible for allocating a thread from the stack pool
+/// and informing valgrind that we're going to context switch to its stack to
+/// suppress false positives.
 ///
-/// We're going to store the valgrind stack ID *outside* of the thread structure
-/// because we don't want it to be initialized by the constructor, so we use the
-/// minimum address of the allocated buffer for that. When we're protecting
-/// stacks that minimum is on the write-protected page, but if we're not
-/// protecting stacks then we shift the returned buffer by 16 bytes (this is
-/// standard allocator-style metadata functionality).
+/// We're going to store the valgrind stack ID and the stack's NUMA node
+/// *outside* of the thread structure because we don't want them to be
+/// initialized by the constructor, so we use the 16 bytes at the top of the
+/// stack for that. The Thread header itself lives at the base of the stack.
 void*
 Thread::operator new(size_t bytes)
 {
-  // Allocate an appropriately sized and aligned buffer;
-  size_t align = (ProtectStacks()) ? HPX_PAGE_SIZE : 16;
-  size_t n = (ProtectStacks()) ? Buffer_ : Size_;
-  void* base = as_memalign(AS_REGISTERED, align, n);
-  if (!base) {
-    throw std::bad_alloc();
-  }
-
-  // Register the stack, storing the valgrind ID at the beginning of the
-  // buffer.
-  auto* id = static_cast<int*>(base);
-  auto* begin = static_cast<char*>(base);
-  *id = VALGRIND_STACK_REGISTER(begin, begin + n);
-
-  // Protect the boundary pages.
-  ProtectBoundaryPages(base, PROT_NONE);
-
-  // Return the pointer into the correct part of the buffer.
-  return begin + align;
+  Worker* w = self;
+  int node = (w) ? w->getNumaNode() : 0;
+  auto* base = static_cast<char*>(StackPool::Allocate(node));
+
+  // Register the stack, storing the valgrind ID and node at the top.
+  auto* meta = reinterpret_cast<int*>(base + Size_ - 16);
+  meta[0] = VALGRIND_STACK_REGISTER(base, base + Size_);
+  meta[1] = node;
+  return base;
 }
 
 /// The delete operator gets the pointer that was returned from operator new(),
-/// and it needs to unprotect the boundary pages, and deregister the stack with
-/// valgrind. The registered stack ID was stored at the base addres of the
-/// allocated buffer.
+/// and it needs to deregister the stack with valgrind and return it to the
+/// pool that it came from.
 void
 Thread::operator delete(void* ptr)
 {
-  // Adjust the pointer so that it points at the actual base of the buffer.
-  size_t align = (ProtectStacks()) ? HPX_PAGE_SIZE : 16;
-  ptr = static_cast<char*>(ptr) - align;
-
-  // Unprotect boundary and deregister stack.
-  ProtectBoundaryPages(ptr, PROT_READ | PROT_WRITE);
-  VALGRIND_STACK_DEREGISTER(*static_cast<int*>(ptr));
-  as_free(AS_REGISTERED, ptr);
+  auto* base = static_cast<char*>(ptr);
+  auto* meta = reinterpret_cast<int*>(base + Size_ - 16);
+  VALGRIND_STACK_DEREGISTER(meta[0]);
+  StackPool::Deallocate(ptr, meta[1]);
 }
 
 void
 Thread::SetStackSize(int bytes)
 {
   assert(bytes > 0);
-  if (!ProtectStacks()) {
-    Size_ = bytes & ~15;
-    Buffer_ = bytes & ~15;
-  }
-  else {
-    // allocate boundary pages when we want to protect the stack
-    int pages = ceil_div_32(bytes, HPX_PAGE_SIZE);
-    Size_ = pages * HPX_PAGE_SIZE;
-    Buffer_ = Size_ + 2 * HPX_PAGE_SIZE;
-  }
+
+  // Stacks are mapped directly, so they are always page granularity.
+  int pages = ceil_div_32(bytes, HPX_PAGE_SIZE);
+  Size_ = pages * HPX_PAGE_SIZE;
 
   if (Size_ != unsigned(bytes)) {
     log_sched("Adjusted stack size to %zu bytes\n", Size_);
   }
 }
 
+void
+Thread::InitStacks(int bytes)
+{
+  SetStackSize(bytes);
+  StackPool::Init(Size_, ProtectStacks());
+}
+
+void
+Thread::FiniStacks()
+{
+  StackPool::Fini();
+}
+
 hpx_parcel_t*
 Thread::generateContinue(int n, va_list* args)
 {
@@ -215,13 +182,6 @@ Thread::ProtectStacks(void)
   return false;
 #endif
 
-#ifdef HAVE_HUGETLBFS
-  if (here->config->dbg_mprotectstacks) {
-    log_error("cannot mprotect stacks when using huge pages\n");
-  }
-  return false;
-#endif
-
   dbg_assert(here && here->config);
   return here->config->dbg_mprotectstacks;
 }
@@ -229,8 +189,6 @@ Thread::ProtectStacks(void)
 char*
 Thread::top()
 {
-  // When we are not protecting stacks we used 16 bytes to store the stack ID
-  // for valgrind.
-  size_t shift = (ProtectStacks()) ? 0 : 16;
-  return reinterpret_cast<char*>(this) + Size_ - shift;
+  // The top 16 bytes store the valgrind stack ID and the stack's NUMA node.
+  return reinterpret_cast<char*>(this) + Size_ - 16;
 }
@@ -110,17 +110,22 @@ class Thread {
   void invokeContinue(int n, va_list* args);
   void invokeContinue();
 
-  /// Sets the protection for the bottom and top pages (uses Size_).
-  ///
-  /// @param         base The base address.
-  /// @param         prot The new permissions.
-  static void ProtectBoundaryPages(void* base, int prot);
-
   /// Sets the size of a stack.
   ///
   /// All of the stacks in the system need to have the same size.
   static void SetStackSize(int bytes);
 
+  /// Set the stack size and initialize the stack pool.
+  ///
+  /// Stacks are reserved in virtual memory and committed on demand, so a
+  /// large stack size only costs physical memory for threads that use it.
+  static void InitStacks(int bytes);
+
+  /// Release the stack pool.
+  ///
+  /// This must be called after all of the threads have been deleted.
+  static void FiniStacks();
+
   /// Do any architecture-specific initialization for the worker.
   static void InitArch(Worker*);
 
@@ -145,7 +150,6 @@ class Thread {
  private:
   static constexpr unsigned CANARY_ = 0xA55AA55A;
   static size_t Size_;                          //!< The size of stacks.
-  static size_t Buffer_;                        //!< The size of buffers.
 
   void* sp_;                     //!< checkpointed stack pointer
   hpx_parcel_t* parcel_;         //!< the progenitor parcel
@@ -18,6 +18,7 @@
 #include "libhpx/Worker.h"
 #include "Condition.h"
 #include "Thread.h"
+#include "arch/common/asm.h"
 #include "lco/LCO.h"
 #include "libhpx/action.h"
 #include "libhpx/debug.h"
@@ -31,6 +32,8 @@
 #include "libhpx/Topology.h"
 #include "libhpx/system.h"
 #include "libhpx/util/math.h"
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 #ifdef HAVE_URCU
 # include <urcu-qsbr.h>
@@ -42,8 +45,6 @@ using libhpx::Worker;
 using libhpx::scheduler::Condition;
 using libhpx::scheduler::LCO;
 using libhpx::scheduler::Thread;
-LIBHPX_ACTION(HPX_INTERRUPT, 0, StealHalf, Worker::StealHalfHandler,
-              HPX_POINTER);
 }
 
 /// Storage for the thread-local worker pointer.
@@ -59,12 +60,17 @@ Worker::Worker(int id)
       bst(nullptr),
       system_(nullptr),
       current_(nullptr),
+      task_(nullptr),
       threads_(nullptr),
       lock_(),
       running_(),
       state_(STOP),
       workId_(0),
+      parked_(false),
+      steals_(0),
+      failedSteals_(0),
       queues_(),
+      priority_(),
       inbox_(),
       thread_([this]() { enter(); })
 {
@@ -76,6 +82,10 @@ Worker::~Worker() {
     parcel_delete(p);
   }
 
+  while (hpx_parcel_t* p = popPriority()) {
+    parcel_delete(p);
+  }
+
   while (hpx_parcel_t* p = popLIFO()) {
     parcel_delete(p);
   }
@@ -97,10 +107,21 @@ Worker::pushLIFO(hpx_parcel_t* p)
 #elif defined(ENABLE_INSTRUMENTATION)
   EVENT_GAS_ACCESS(p->src, here->rank, p->target, p->size);
 #endif
-  uint64_t size = queues_[workId_].push(p);
-  if (workFirst_ >= 0) {
-    workFirst_ = (here->config->sched_wfthreshold < size);
+  if (action_is_priority(p->action)) {
+    priority_.push(p);
+  }
+  else {
+    uint64_t size = queues_[workId_].push(p);
+    if (workFirst_ >= 0) {
+      workFirst_ = (here->config->sched_wfthreshold < size);
+    }
   }
+
+  // p is now stealable, so make sure that someone is awake to steal it. The
+  // fence orders the push before the parked-count load in unpark(), pairing
+  // with the fence in park().
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  here->sched->unpark(id_);
 }
 
 hpx_parcel_t*
@@ -115,6 +136,23 @@ Worker::popLIFO()
   return p;
 }
 
+hpx_parcel_t*
+Worker::popPriority()
+{
+  hpx_parcel_t *p = priority_.pop();
+  dbg_assert(!p || p != current_);
+  INST_IF (p) {
+    EVENT_SCHED_POP_LIFO(p->id);
+  }
+  return p;
+}
+
+Worker::Deque&
+Worker::queueFor(const hpx_parcel_t* p)
+{
+  return (action_is_priority(p->action)) ? priority_ : queues_[workId_];
+}
+
 hpx_parcel_t *
 Worker::handleNetwork()
 {
@@ -130,29 +168,34 @@ Worker::handleNetwork()
     pushLIFO(p);
   }
 
+  if (hpx_parcel_t *p = popPriority()) {
+    return p;
+  }
   return popLIFO();
 }
 
 hpx_parcel_t*
 Worker::handleMail()
 {
-  hpx_parcel_t *parcels = inbox_.dequeue();
+  hpx_parcel_t *parcels = inbox_.popAll();
   if (!parcels) {
     return NULL;
   }
 
   hpx_parcel_t *prev = parcel_stack_pop(&parcels);
-  do {
-    hpx_parcel_t *next = NULL;
-    while ((next = parcel_stack_pop(&parcels))) {
-      dbg_assert(next != current_);
-      EVENT_SCHED_MAIL(prev->id);
-      log_sched("got mail %p\n", prev);
-      pushLIFO(prev);
-      prev = next;
-    }
-  } while ((parcels = inbox_.dequeue()));
-  dbg_assert(prev);
+  while (hpx_parcel_t *next = parcel_stack_pop(&parcels)) {
+    dbg_assert(next != current_);
+    EVENT_SCHED_MAIL(prev->id);
+    log_sched("got mail %p\n", prev);
+    pushLIFO(prev);
+    prev = next;
+  }
+
+  // Don't let the parcel we kept jump ahead of priority mail.
+  if (!action_is_priority(prev->action) && priority_.size()) {
+    pushLIFO(prev);
+    return popPriority();
+  }
   return prev;
 }
 
@@ -204,15 +247,23 @@ Worker::unbind(hpx_parcel_t* p)
 void
 Worker::schedule(Continuation& f)
 {
+  if (unlikely(current_ == task_)) {
+    dbg_error("HPX_TASK %s attempted to block, tasks must run to completion\n",
+              actions[current_->action].key);
+  }
+
   EVENT_SCHED_BEGIN();
   if (state_ != RUN) {
     transfer(system_, f);
   }
+  else if (hpx_parcel_t *p = popPriority()) {
+    handoff(p, f);
+  }
   else if (hpx_parcel_t *p = handleMail()) {
-    transfer(p, f);
+    handoff(p, f);
   }
   else if (hpx_parcel_t *p = popLIFO()) {
-    transfer(p, f);
+    handoff(p, f);
   }
   else {
     transfer(system_, f);
@@ -303,6 +354,23 @@ Worker::sleep()
 {
   std::unique_lock<std::mutex> _(lock_);
   while (state_ == STOP) {
+    // If the scheduler is still running then we were stopped to reduce the
+    // number of running workers. Forward our work and keep checking for mail,
+    // since we may still be sent parcels that were addressed to us.
+    if (here->sched->getState() == Scheduler::RUN) {
+      _.unlock();
+      drain();
+      _.lock();
+      if (state_ != STOP) {
+        break;
+      }
+      auto period = std::chrono::microseconds(here->config->sched_parkperiod);
+      here->sched->subActive();
+      running_.wait_for(_, period);
+      here->sched->addActive();
+      continue;
+    }
+
     while (hpx_parcel_t *p = queues_[1 - workId_].pop()) {
       pushLIFO(p);
     }
@@ -318,6 +386,28 @@ Worker::sleep()
   }
 }
 
+void
+Worker::drain()
+{
+  hpx_parcel_t* parcels = inbox_.popAll();
+  while (hpx_parcel_t* p = priority_.pop()) {
+    parcel_stack_push(&parcels, p);
+  }
+  for (auto&& queue : queues_) {
+    while (hpx_parcel_t* p = queue.pop()) {
+      parcel_stack_push(&parcels, p);
+    }
+  }
+
+  Scheduler* sched = here->sched;
+  while (hpx_parcel_t* p = parcel_stack_pop(&parcels)) {
+    int n = sched->getNTarget();
+    int id = (id_ + 1 + rand(n)) % n;
+    log_sched("forwarding %p to worker %d\n", p, id);
+    sched->getWorker(id)->pushMail(p);
+  }
+}
+
 void
 Worker::checkpoint(hpx_parcel_t *p, Continuation& f, void *sp)
 {
@@ -364,43 +454,221 @@ Worker::transfer(hpx_parcel_t *p, Continuation& f)
   }
 }
 
+int
+Worker::handleIdle(int spins)
+{
+#ifdef HAVE_URCU
+  rcu_quiescent_state();
+#endif
+
+  int budget = here->config->sched_spinbudget;
+  if (budget < 0 || spins < budget) {
+    int log = std::min(spins, IDLE_BACKOFF_LOG_LIMIT);
+    for (int i = 0, e = 1 << log; i < e; ++i) {
+      pause_nop();
+    }
+    return spins + 1;
+  }
+
+  park();
+  return 0;
+}
+
+void
+Worker::park()
+{
+  std::unique_lock<std::mutex> _(lock_);
+  if (!here->sched->addParked()) {
+    return;
+  }
+  parked_.store(true, std::memory_order_seq_cst);
+
+  // Check for mail or local work one last time now that we're visible as
+  // parked, otherwise we could miss the wakeup for work that was published
+  // concurrently with our last pass through the schedule loop.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (state_ == RUN && inbox_.empty() && !priority_.size() &&
+      !queues_[0].size() && !queues_[1].size()) {
+    auto period = std::chrono::microseconds(here->config->sched_parkperiod);
+    running_.wait_for(_, period);
+  }
+
+  here->sched->subParked();
+  parked_.store(false, std::memory_order_release);
+}
+
+bool
+Worker::canBlock() const
+{
+  return (current_ != system_ && current_ != task_ &&
+          !action_is_interrupt(current_->action) &&
+          !current_->thread->inLCO());
+}
+
+bool
+Worker::IsStackless(const hpx_parcel_t* p)
+{
+  return (p->thread == nullptr && action_is_task(p->action));
+}
+
+void
+Worker::dispatch(hpx_parcel_t* p, Continuation& f)
+{
+  dbg_assert(current_ == system_);
+  if (IsStackless(p)) {
+    executeTask(p);
+  }
+  else {
+    transfer(p, f);
+  }
+}
+
+void
+Worker::handoff(hpx_parcel_t* p, Continuation& f)
+{
+  if (IsStackless(p) && current_ != system_) {
+    queueFor(p).push(p);
+    transfer(system_, f);
+  }
+  else {
+    transfer(p, f);
+  }
+}
+
+void
+Worker::executeTask(hpx_parcel_t* p)
+{
+  dbg_assert(current_ == system_ && !task_);
+
+  // Give the task a stack header so that the thread interface (continuations,
+  // tls, etc.) works the same way it does for lightweight threads.
+  Thread thread(p);
+  parcel_set_thread(p, &thread);
+  current_ = p;
+  task_ = p;
+
+  EVENT_THREAD_RUN(p);
+  int status = HPX_SUCCESS;
+  try {
+    status = action_exec_parcel(p->action, p);
+  } catch (const int &nonLocal) {
+    status = nonLocal;
+  }
+
+  switch (status) {
+   case HPX_RESEND:
+    EVENT_PARCEL_RESEND(p->id, p->action, p->size, p->src);
+    break;
+
+   case HPX_ABANDON:
+    break;
+
+   case HPX_SUCCESS:
+    thread.invokeContinue();
+    break;
+
+   case HPX_LCO_ERROR:
+    // rewrite to lco_error and continue the error status
+    p->c_action = lco_error;
+    _hpx_thread_continue(2, &status, sizeof(status));
+    break;
+
+   case HPX_ERROR:
+   default:
+    dbg_error("task produced unexpected error %s.\n", hpx_strerror(status));
+  }
+  EVENT_THREAD_END(p);
+
+  task_ = nullptr;
+  current_ = system_;
+  parcel_set_thread(p, nullptr);
+
+  // Now that we're back to running the system thread any local spawns that
+  // these operations trigger are processed normally.
+  switch (status) {
+   case HPX_RESEND:
+    parcel_launch(p);
+    return;
+   case HPX_ABANDON:
+    return;
+   default:
+    parcel_delete(p);
+    return;
+  }
+}
+
 void
 Worker::run()
 {
   std::function<void(hpx_parcel_t*)> null([](hpx_parcel_t*){});
+  int spins = 0;
   while (state_ ==  RUN) {
-    if (hpx_parcel_t *p = handleMail()) {
-      transfer(p, null);
+    if (hpx_parcel_t *p = popPriority()) {
+      dispatch(p, null);
+    }
+    else if (hpx_parcel_t *p = handleMail()) {
+      dispatch(p, null);
     }
     else if (hpx_parcel_t *p = popLIFO()) {
-      transfer(p, null);
+      dispatch(p, null);
     }
     else if (hpx_parcel_t *p = handleEpoch()) {
-      transfer(p, null);
+      dispatch(p, null);
     }
     else if (hpx_parcel_t *p = handleNetwork()) {
-      transfer(p, null);
+      dispatch(p, null);
     }
     else if (hpx_parcel_t *p = handleSteal()) {
-      transfer(p, null);
+      dispatch(p, null);
     }
     else {
-#ifdef HAVE_URCU
-      rcu_quiescent_state();
-#endif
+      spins = handleIdle(spins);
+      continue;
     }
+    spins = 0;
   }
 }
 
+int
+Worker::GetAffinity(hpx_parcel_t* p)
+{
+  // The cached value is 0 if we haven't found an affinity yet, and is
+  // otherwise the affinity + 2.
+  if (p->affinity) {
+    return p->affinity - 2;
+  }
+
+  // Don't cache negative results, so that affinity that is set while a thread
+  // is running is still honored when the thread is resumed.
+  if (!here->gas->hasAffinity()) {
+    return -1;
+  }
+
+  int affinity = here->gas->getAffinity(p->target);
+  if (0 <= affinity) {
+    p->affinity = affinity + 2;
+  }
+  return affinity;
+}
+
+void
+Worker::SetAffinity(hpx_parcel_t* p, int worker)
+{
+  dbg_assert(0 <= worker && worker < UINT16_MAX - 2);
+  p->affinity = uint16_t(worker + 2);
+}
+
 void
 Worker::spawn(hpx_parcel_t* p)
 {
   dbg_assert(p);
   dbg_assert(actions[p->action].handler != NULL);
 
-  // If the target has affinity then send the parcel to that worker.
-  int affinity = here->gas->getAffinity(p->target);
-  if (0 <= affinity && affinity != id_) {
+  // If the target has affinity then send the parcel to that worker, as long as
+  // it is running.
+  int affinity = GetAffinity(p);
+  if (0 <= affinity && affinity != id_ &&
+      affinity < here->sched->getNTarget()) {
     here->sched->getWorker(affinity)->pushMail(p);
     return;
   }
@@ -425,9 +693,9 @@ Worker::spawn(hpx_parcel_t* p)
     return;
   }
 
-  // If we are currently running an interrupt, then we can't work-first since we
-  // don't have our own stack to suspend.
-  if (action_is_interrupt(current_->action)) {
+  // If we are currently running an interrupt or a stackless task, then we can't
+  // work-first since we don't have our own stack to suspend.
+  if (action_is_interrupt(current_->action) || current_ == task_) {
     pushLIFO(p);
     return;
   }
@@ -445,27 +713,55 @@ Worker::spawn(hpx_parcel_t* p)
   self->EVENT_THREAD_RESUME(current_);          // re-read self
 }
 
-int
-Worker::StealHalfHandler(Worker* src)
-{
-  if (hpx_parcel_t* half = self->stealHalf()) {
-    src->pushMail(half);
-  }
-  return HPX_SUCCESS;
-}
-
 hpx_parcel_t*
 Worker::stealFrom(Worker* victim) {
-  hpx_parcel_t *p = victim->queues_[victim->workId_].steal();
+  steals_.fetch_add(1, std::memory_order_relaxed);
+
+  // Priority work is latency sensitive, so take it before anything else.
+  if (hpx_parcel_t *p = victim->priority_.steal()) {
+    lastVictim_ = victim;
+    EVENT_SCHED_STEAL(p->id, victim->getId());
+    return p;
+  }
+
+  // Try to take half of the victim's work, so that we don't keep coming back
+  // to the same victim when it's working on a wide spawn tree.
+  Deque& queue = victim->queues_[victim->workId_];
+  size_t half = queue.size() / 2;
+  unsigned n = (half < STEAL_BATCH_LIMIT) ? half : STEAL_BATCH_LIMIT;
+  if (n == 0) {
+    n = 1;
+  }
+
+  hpx_parcel_t *batch[STEAL_BATCH_LIMIT];
+  unsigned k = queue.stealBatch(batch, n);
+  hpx_parcel_t *p = (k) ? batch[0] : nullptr;
   lastVictim_ = (p) ? victim : nullptr;
+  if (!p) {
+    failedSteals_.fetch_add(1, std::memory_order_relaxed);
+  }
   EVENT_SCHED_STEAL((p) ? p->id : 0, victim->getId());
+
+  // Run the oldest parcel we stole and keep the rest for later. These parcels
+  // were already accounted for when they were spawned, so push them directly
+  // rather than through pushLIFO(), and wake helpers once for the whole batch.
+  for (unsigned i = 1; i < k; ++i) {
+    queueFor(batch[i]).push(batch[i]);
+  }
+  if (1 < k) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    here->sched->unpark(id_);
+  }
   return p;
 }
 
 hpx_parcel_t*
-Worker::stealRandom()
+Worker::stealRandom(int n)
 {
-  int n = here->sched->getNWorkers();
+  if (n <= 1) {
+    return nullptr;
+  }
+
   int id;
   do {
     id = rand(n);
@@ -473,40 +769,34 @@ Worker::stealRandom()
   return stealFrom(here->sched->getWorker(id));
 }
 
-hpx_parcel_t*
-Worker::stealRandomNode()
+/// Pick a random running worker, other than this one, on a NUMA node.
+///
+/// This scans the node's cpus starting at a random offset, so it terminates
+/// even when none of them have a running worker.
+///
+/// @param       node The NUMA node to pick the victim from.
+/// @param          e The number of running workers.
+///
+/// @returns          The victim's id, or -1 if the node has no candidates.
+int
+Worker::randomVictim(int node, int e)
 {
-  int   n = here->topology->cpus_per_node;
-  int cpu = rand(n);
-  int  id = here->topology->numa_to_cpus[numaNode_][cpu];
-  while (id == id_) {
-    cpu = rand(n);
-    id = here->topology->numa_to_cpus[numaNode_][cpu];
+  int n = here->topology->cpus_per_node;
+  int start = rand(n);
+  for (int i = 0; i < n; ++i) {
+    int id = here->topology->numa_to_cpus[node][(start + i) % n];
+    if (id != id_ && id < e) {
+      return id;
+    }
   }
-  return stealFrom(here->sched->getWorker(id));
+  return -1;
 }
 
 hpx_parcel_t*
-Worker::stealHalf()
+Worker::stealRandomNode(int n)
 {
-  int qsize = queues_[workId_].size();
-  if (qsize < MAGIC_STEAL_HALF_THRESHOLD) {
-    return nullptr;
-  }
-
-  hpx_parcel_t *parcels = nullptr;
-  for (int i = 0, e = qsize / 2; i < e; ++i) {
-    hpx_parcel_t *p = popLIFO();
-    if (!p) {
-      break;
-    }
-    if (p->action == StealHalf) {
-      parcel_delete(p);
-      continue;
-    }
-    parcel_stack_push(&parcels, p);
-  }
-  return parcels;
+  int id = randomVictim(numaNode_, n);
+  return (0 <= id) ? stealFrom(here->sched->getWorker(id)) : nullptr;
 }
 
 /// Hierarchical work-stealing policy.
@@ -518,38 +808,38 @@ Worker::stealHalf()
 ///    the same numa domain.
 /// 2. if failed, try to steal randomly from the same numa domain.
 /// 3. if failed, repeat step 2.
-/// 4. if failed, try to steal half randomly from across the numa domain.
+/// 4. if failed, try to steal randomly from across the numa domain.
 /// 5. if failed, go idle.
 ///
 hpx_parcel_t*
-Worker::stealHierarchical()
+Worker::stealHierarchical(int n)
 {
   // disable hierarchical stealing if the worker threads are not
   // bound, or if the system is not hierarchical.
   if (here->config->thread_affinity == HPX_THREAD_AFFINITY_NONE) {
-    return stealRandom();
+    return stealRandom(n);
   }
 
   if (here->topology->numa_to_cpus == NULL) {
-    return stealRandom();
+    return stealRandom(n);
   }
 
   dbg_assert(numaNode_ >= 0);
 
   // step 1
-  if (lastVictim_) {
+  if (lastVictim_ && lastVictim_->getId() < n) {
     if (hpx_parcel_t* p = stealFrom(lastVictim_)) {
       return p;
     }
   }
 
   // step 2
-  if (hpx_parcel_t* p = stealRandomNode()) {
+  if (hpx_parcel_t* p = stealRandomNode(n)) {
     return p;
   }
 
   // step 3
-  if (hpx_parcel_t* p = stealRandomNode()) {
+  if (hpx_parcel_t* p = stealRandomNode(n)) {
     return p;
   }
 
@@ -559,25 +849,17 @@ Worker::stealHierarchical()
     nn = rand(here->topology->nnodes);
   }
 
-  int        idx = rand(here->topology->cpus_per_node);
-  int        cpu = here->topology->numa_to_cpus[nn][idx];
-  Worker* victim = here->sched->getWorker(cpu);
-  Worker*    src = this;
-  hpx_parcel_t* p = action_new_parcel(StealHalf, // action
-                                      HPX_HERE,  // target
-                                      0,         // c_action
-                                      0,         // c_taget
-                                      1,         // n args
-                                      &src);     // reply
-  parcel_prepare(p);
-  victim->pushMail(p);
-  return NULL;
+  int id = randomVictim(nn, n);
+  return (0 <= id) ? stealFrom(here->sched->getWorker(id)) : stealRandom(n);
 }
 
 hpx_parcel_t*
 Worker::handleSteal()
 {
-  if (here->sched->getNWorkers() == 1) {
+  // Read the number of running workers once, it can shrink concurrently and
+  // the policies rely on there being another worker to steal from.
+  int n = here->sched->getNTarget();
+  if (n <= 1) {
     return NULL;
   }
 
@@ -587,9 +869,9 @@ Worker::handleSteal()
       log_dflt("invalid scheduling policy, defaulting to random..");
     case HPX_SCHED_POLICY_DEFAULT:
     case HPX_SCHED_POLICY_RANDOM:
-     return stealRandom();
+     return stealRandom(n);
     case HPX_SCHED_POLICY_HIER:
-     return stealHierarchical();
+     return stealHierarchical(n);
   }
 }
 
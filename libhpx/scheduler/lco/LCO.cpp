@@ -44,10 +44,10 @@ static LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED, _lco_wait, LCO::WaitHandler,
 
 LIBHPX_ACTION(HPX_INTERRUPT, HPX_PINNED, hpx_lco_delete_action,
               LCO::DeleteHandler, HPX_POINTER);
-LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED | HPX_MARSHALLED, hpx_lco_set_action,
-              LCO::SetHandler, HPX_POINTER, HPX_POINTER, HPX_SIZE_T);
-LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED | HPX_MARSHALLED, lco_error,
-              LCO::ErrorHandler, HPX_POINTER, HPX_POINTER, HPX_SIZE_T);
+LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED | HPX_MARSHALLED | HPX_PRIORITY,
+              hpx_lco_set_action, LCO::SetHandler, HPX_POINTER, HPX_POINTER, HPX_SIZE_T);
+LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED | HPX_MARSHALLED | HPX_PRIORITY,
+              lco_error, LCO::ErrorHandler, HPX_POINTER, HPX_POINTER, HPX_SIZE_T);
 LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED, hpx_lco_reset_action,
               LCO::ResetHandler, HPX_POINTER);
 LIBHPX_ACTION(HPX_DEFAULT, HPX_PINNED | HPX_MARSHALLED, lco_attach,
@@ -20,9 +20,12 @@
 #include <libhpx/debug.h>
 #include <libhpx/libhpx.h>
 #include <libhpx/locality.h>
+#include <libhpx/memory.h>
 #include <libhpx/system.h>
 #include <libhpx/Topology.h>
+#include <libhpx/Worker.h>
 #include <hwloc.h>
+#include <algorithm>
 
 int system_set_worker_affinity(int id, libhpx_thread_affinity_t policy) {
   int resource;
@@ -56,6 +59,68 @@ int system_set_worker_affinity(int id, libhpx_thread_affinity_t policy) {
                             cpuset, LIBHPX_HWLOC_CPUBIND_THREAD);
 }
 
+int system_set_progress_affinity(int cpu) {
+  if (cpu < 0) {
+    return LIBHPX_OK;
+  }
+
+  if (here->topology->ncpus <= cpu) {
+    log_error("progress cpu %d is out of range (%d cpus)\n", cpu,
+              here->topology->ncpus);
+    return LIBHPX_ERROR;
+  }
+
+  libhpx_hwloc_cpuset_t cpuset = here->topology->cpus[cpu]->cpuset;
+  return libhpx_hwloc_set_cpubind(here->topology->hwloc_topology,
+                                  cpuset, LIBHPX_HWLOC_CPUBIND_THREAD);
+}
+
+int system_set_gas_membind(void *addr, size_t bytes, uint64_t offset,
+                           libhpx_gas_numa_t policy) {
+  const libhpx::Topology *topo = here->topology;
+  if (policy == HPX_GAS_NUMA_NONE || !topo->numa_nodes || topo->nnodes < 2) {
+    return LIBHPX_OK;
+  }
+
+  switch (policy) {
+   case HPX_GAS_NUMA_INTERLEAVE:
+    return libhpx_hwloc_set_area_membind(topo->hwloc_topology, addr, bytes,
+                                         topo->allowed_cpus,
+                                         LIBHPX_HWLOC_MEMBIND_INTERLEAVE, 0);
+   case HPX_GAS_NUMA_LOCAL: {
+    // Off of a worker we leave the range to first-touch placement.
+    const libhpx::Worker *w = libhpx::self;
+    if (!w) {
+      return LIBHPX_OK;
+    }
+    libhpx_hwloc_obj_t node = topo->numa_nodes[w->getNumaNode()];
+    return libhpx_hwloc_set_area_membind(topo->hwloc_topology, addr, bytes,
+                                         node->cpuset,
+                                         LIBHPX_HWLOC_MEMBIND_BIND, 0);
+   }
+   case HPX_GAS_NUMA_BLOCK:
+    break;
+   default:
+    log_error("unknown gas numa policy\n");
+    return LIBHPX_ERROR;
+  }
+
+  // Deal the chunks out to the nodes round-robin, by heap offset, so that
+  // every rank places the same offsets on the same nodes.
+  size_t chunk = as_bytes_per_chunk();
+  char *base = static_cast<char*>(addr);
+  for (size_t i = 0; i < bytes; i += chunk) {
+    int node = ((offset + i) / chunk) % topo->nnodes;
+    size_t n = std::min(chunk, bytes - i);
+    if (libhpx_hwloc_set_area_membind(topo->hwloc_topology, base + i, n,
+                                      topo->numa_nodes[node]->cpuset,
+                                      LIBHPX_HWLOC_MEMBIND_BIND, 0)) {
+      return LIBHPX_ERROR;
+    }
+  }
+  return LIBHPX_OK;
+}
+
 /// Return the weight of the bitmap that represents the CPUs we are
 ///  allowed to run on. This bitmap is set in libhpx/system/topology.c.
 int system_get_available_cores(void) {
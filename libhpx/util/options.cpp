@@ -30,6 +30,7 @@
 #include "libhpx/util/Env.h"
 #include "hpx/hpx.h"
 #include <cassert>
+#include <cinttypes>
 #include <ctype.h>
 #include <cstdlib>
 #include <cstring>
@@ -340,15 +341,22 @@ void config_print(const config_t *cfg, FILE *f) {
   fprintf(f, "General\n");
   fprintf(f, "  heapsize\t\t%zu\n", cfg->heapsize);
   fprintf(f, "  gas\t\t\t\"%s\"\n", HPX_GAS_TO_STRING[cfg->gas]);
+  fprintf(f, "  gas numa\t\t\"%s\"\n", HPX_GAS_NUMA_TO_STRING[cfg->gas_numa]);
   fprintf(f, "  boot\t\t\t\"%s\"\n", HPX_BOOT_TO_STRING[cfg->boot]);
   fprintf(f, "  transport\t\t\"%s\"\n", HPX_TRANSPORT_TO_STRING[cfg->transport]);
   fprintf(f, "  network\t\t\"%s\"\n", HPX_NETWORK_TO_STRING[cfg->network]);
+  fprintf(f, "  progress thread\t%d\n", cfg->progress_thread);
+  fprintf(f, "  progress cpu\t\t%d\n", cfg->progress_cpu);
 
   fprintf(f, "\nScheduler\n");
   fprintf(f, "  threads\t\t%d\n", cfg->threads);
   fprintf(f, "  stacksize\t\t%u\n", cfg->stacksize);
   fprintf(f, "  wfthreshold\t\t%u\n", cfg->sched_wfthreshold);
   fprintf(f, "  stackcachelimit\t%u\n", cfg->sched_stackcachelimit);
+  fprintf(f, "  spinbudget\t\t%d\n", cfg->sched_spinbudget);
+  fprintf(f, "  parkperiod\t\t%" PRIu64 "\n", cfg->sched_parkperiod);
+  fprintf(f, "  wakefanout\t\t%d\n", cfg->sched_wakefanout);
+  fprintf(f, "  elastic\t\t%d\n", cfg->sched_elastic);
 
   fprintf(f, "\nLogging\n");
   fprintf(f, "  level\t\t\t");
@@ -443,6 +451,16 @@ void config_print(const config_t *cfg, FILE *f) {
   fprintf(f, "  testwindow\t\t%u\n", cfg->isir_testwindow);
   fprintf(f, "  sendlimit\t\t%u\n", cfg->isir_sendlimit);
   fprintf(f, "  recvlimit\t\t%u\n", cfg->isir_recvlimit);
+  fprintf(f, "  threaded\t\t%d\n", cfg->isir_threaded);
+  fprintf(f, "  lanes\t\t\t%u\n", cfg->isir_lanes);
+  fprintf(f, "  eagerring\t\t%u\n", cfg->isir_eagerring);
+  fprintf(f, "  eagersize\t\t%u\n", cfg->isir_eagersize);
+  fprintf(f, "  credits\t\t%u\n", cfg->isir_credits);
+#endif
+
+#ifdef HAVE_SHM
+  fprintf(f, "\nShared memory\n");
+  fprintf(f, "  ringsize\t\t%zu\n", cfg->shm_ringsize);
 #endif
 
 #ifdef HAVE_PHOTON
@@ -460,11 +478,21 @@ void config_print(const config_t *cfg, FILE *f) {
   fprintf(f, "  ethdev\t\t\"%s\"\n", cfg->photon_ethdev);
   fprintf(f, "  ibdev\t\t\t\"%s\"\n", cfg->photon_ibdev);
 #endif
+  fprintf(f, "\nParcel string operations\n");
+  fprintf(f, "  chunksize\t\t%zu\n", cfg->network_chunksize);
+  fprintf(f, "  chunkwindow\t\t%u\n", cfg->network_chunkwindow);
+
   fprintf(f, "\nOptimization\n");
   fprintf(f, "  smp\t\t\t%d\n", cfg->opt_smp);
+  fprintf(f, "  parcel_cachesize\t%zu\n", cfg->parcel_cachesize);
+  fprintf(f, "  parcel_compression\t%d\n", cfg->parcel_compression);
+  fprintf(f, "  compression_minsize\t%zu\n", cfg->parcel_compression_minsize);
+  fprintf(f, "  compression_ratio\t%d\n", cfg->parcel_compression_ratio);
 
   fprintf(f, "\nCoalescing parameters\n");
   fprintf(f, " Coalescing buffer size\t\t%d\n", cfg->coalescing_buffersize);
+  fprintf(f, " Coalescing buffer bytes\t%zu\n", cfg->coalescing_bytes);
+  fprintf(f, " Coalescing timeout (us)\t%" PRIu64 "\n", cfg->coalescing_timeout);
 
 
   fprintf(f, "------------------------\n");
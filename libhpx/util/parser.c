@@ -39,9 +39,10 @@ const char *hpx_options_t_help[] = {
   "      --hpx-version             print HPX version  (default=off)",
   "      --hpx-heapsize=bytes      set HPX per-PE global heap size",
   "      --hpx-gas=type            type of Global Address Space (GAS)  (possible\n                                  values=\"default\", \"smp\", \"pgas\",\n                                  \"agas\")",
-  "      --hpx-boot=type           HPX bootstrap method to use  (possible\n                                  values=\"default\", \"smp\", \"mpi\",\n                                  \"pmi\")",
+  "      --hpx-boot=type           HPX bootstrap method to use  (possible\n                                  values=\"default\", \"smp\", \"mpi\",\n                                  \"pmi\", \"fork\")",
+  "      --hpx-boot-ranks=localities\n                                number of localities to start with\n                                  --hpx-boot=fork",
   "      --hpx-transport=type      type of transport to use  (possible\n                                  values=\"default\", \"mpi\", \"photon\")",
-  "      --hpx-network=type        type of network to use  (possible\n                                  values=\"default\", \"smp\", \"pwc\",\n                                  \"isir\")",
+  "      --hpx-network=type        type of network to use  (possible\n                                  values=\"default\", \"smp\", \"pwc\",\n                                  \"isir\", \"shm\")",
   "      --hpx-configfile=file     HPX runtime configuration file",
   "\nScheduler Options:",
   "      --hpx-threads=threads     number of scheduler threads",
@@ -50,10 +51,19 @@ const char *hpx_options_t_help[] = {
   "      --hpx-sched-policy=policy work-stealing policy for the HPX scheduler\n                                  (possible values=\"default\", \"random\",\n                                  \"hier\")",
   "      --hpx-sched-wfthreshold=tasks\n                                bound on help-first tasks before work-first\n                                  scheduling",
   "      --hpx-sched-stackcachelimit=stacks\n                                bound on the number of stacks to cache",
+  "      --hpx-sched-spinbudget=iterations\n                                empty schedule iterations before an idle worker\n                                  parks, -1 to never park",
+  "      --hpx-sched-parkperiod=microseconds\n                                bound on how long a parked worker sleeps before\n                                  polling again",
+  "      --hpx-sched-wakefanout=workers\n                                number of parked workers to wake when new work\n                                  is spawned",
+  "      --hpx-sched-elastic       grow and shrink the number of running workers\n                                  with the load  (default=off)",
   "\nNetwork Options:",
   "      --hpx-progress-period=nanoseconds\n                                async network progess period",
+  "      --hpx-progress-thread     drive the network from a dedicated progress\n                                  thread instead of the workers  (default=off)",
+  "      --hpx-progress-cpu=cpu    cpu to bind the progress thread to (-1 to leave\n                                  it unbound)",
+  "      --hpx-network-chunksize=bytes\n                                split parcel-based memget and memput larger than\n                                  this into pipelined chunks (0 to disable)",
+  "      --hpx-network-chunkwindow=chunks\n                                number of memget or memput chunks in flight at\n                                  once",
   "\nGAS Options:",
   "      --hpx-gas-affinity=type   GAS affinity implementation  (possible\n                                  values=\"none\", \"urcu\", \"cuckoo\")",
+  "      --hpx-gas-numa=policy     NUMA placement policy for the global heap \n                                  (possible values=\"none\", \"interleave\",\n                                  \"local\", \"block\")",
   "\nLog options:",
   "      --hpx-log-at=localities   filter by locality, -1 for all (default none)",
   "      --hpx-log-level[=levels]  set the logging level  (possible\n                                  values=\"default\", \"boot\", \"sched\",\n                                  \"gas\", \"lco\", \"net\", \"trans\",\n                                  \"parcel\", \"action\", \"config\",\n                                  \"memory\", \"coll\", \"all\" default=`all')",
@@ -74,6 +84,13 @@ const char *hpx_options_t_help[] = {
   "      --hpx-isir-testwindow=requests\n                                number of ISIR requests to test in progress\n                                  loop",
   "      --hpx-isir-sendlimit=requests\n                                ISIR network send limit",
   "      --hpx-isir-recvlimit=requests\n                                ISIR network recv limit",
+  "      --hpx-isir-threaded       use MPI_THREAD_MULTIPLE and let workers drive\n                                  the network concurrently  (default=off)",
+  "      --hpx-isir-lanes=lanes    number of independent ISIR lanes in threaded\n                                  mode, ranks use the smallest value (0 for one\n                                  per worker)",
+  "      --hpx-isir-eagerring=buffers\n                                number of preposted ISIR eager receive buffers\n                                  (0 to probe for every message)",
+  "      --hpx-isir-eagersize=bytes\n                                largest ISIR message that is received through\n                                  the eager ring",
+  "      --hpx-isir-credits=requests\n                                number of queued ISIR sends to each peer per\n                                  lane, lightweight threads wait for the window\n                                  (0 for unlimited)",
+  "\nSHM Network Options:",
+  "      --hpx-shm-ringsize=bytes  size of the parcel ring between each pair of\n                                  localities",
   "\nPWC Network Options:",
   "      --hpx-pwc-parcelbuffersize=bytes\n                                set the size of p2p recv buffers for parcel\n                                  sends",
   "      --hpx-pwc-parceleagerlimit=bytes\n                                set the largest eager parcel size (header\n                                  inclusive)",
@@ -102,7 +119,12 @@ const char *hpx_options_t_help[] = {
   "\nOptimization:",
   "      --hpx-opt-smp[=0 off]     optimize for SMP execution",
   "      --hpx-parcel-compression  enable parcel compression  (default=off)",
+  "      --hpx-parcel-compression-minsize=bytes\n                                smallest parcel that compression is tried on",
+  "      --hpx-parcel-compression-ratio=percent\n                                largest compressed size, as a percentage of the\n                                  original, that is worth sending",
+  "      --hpx-parcel-cachesize=bytes\n                                registered memory reserved for the per-worker\n                                  parcel caches",
   "      --hpx-coalescing-buffersize=Integer\n                                set coalescing buffer size",
+  "      --hpx-coalescing-bytes=bytes\n                                capacity of each coalesced parcel",
+  "      --hpx-coalescing-timeout=microseconds\n                                longest a parcel waits in a coalescing buffer",
     0
 };
 
@@ -151,12 +173,13 @@ free_cmd_list(void)
 
 
 const char *hpx_option_parser_hpx_gas_values[] = {"default", "smp", "pgas", "agas", 0}; /*< Possible values for hpx-gas. */
-const char *hpx_option_parser_hpx_boot_values[] = {"default", "smp", "mpi", "pmi", 0}; /*< Possible values for hpx-boot. */
+const char *hpx_option_parser_hpx_boot_values[] = {"default", "smp", "mpi", "pmi", "fork", 0}; /*< Possible values for hpx-boot. */
 const char *hpx_option_parser_hpx_transport_values[] = {"default", "mpi", "photon", 0}; /*< Possible values for hpx-transport. */
-const char *hpx_option_parser_hpx_network_values[] = {"default", "smp", "pwc", "isir", 0}; /*< Possible values for hpx-network. */
+const char *hpx_option_parser_hpx_network_values[] = {"default", "smp", "pwc", "isir", "shm", 0}; /*< Possible values for hpx-network. */
 const char *hpx_option_parser_hpx_thread_affinity_values[] = {"default", "hwthread", "core", "numa", "none", 0}; /*< Possible values for hpx-thread-affinity. */
 const char *hpx_option_parser_hpx_sched_policy_values[] = {"default", "random", "hier", 0}; /*< Possible values for hpx-sched-policy. */
 const char *hpx_option_parser_hpx_gas_affinity_values[] = {"none", "urcu", "cuckoo", 0}; /*< Possible values for hpx-gas-affinity. */
+const char *hpx_option_parser_hpx_gas_numa_values[] = {"none", "interleave", "local", "block", 0}; /*< Possible values for hpx-gas-numa. */
 const char *hpx_option_parser_hpx_log_level_values[] = {"default", "boot", "sched", "gas", "lco", "net", "trans", "parcel", "action", "config", "memory", "coll", "all", 0}; /*< Possible values for hpx-log-level. */
 const char *hpx_option_parser_hpx_dbg_waitonsig_values[] = {"segv", "abrt", "fpe", "ill", "bus", "iot", "sys", "trap", "all", 0}; /*< Possible values for hpx-dbg-waitonsig. */
 const char *hpx_option_parser_hpx_trace_backend_values[] = {"default", "file", "console", "stats", 0}; /*< Possible values for hpx-trace-backend. */
@@ -176,6 +199,7 @@ void clear_given (struct hpx_options_t *args_info)
   args_info->hpx_heapsize_given = 0 ;
   args_info->hpx_gas_given = 0 ;
   args_info->hpx_boot_given = 0 ;
+  args_info->hpx_boot_ranks_given = 0 ;
   args_info->hpx_transport_given = 0 ;
   args_info->hpx_network_given = 0 ;
   args_info->hpx_configfile_given = 0 ;
@@ -185,8 +209,17 @@ void clear_given (struct hpx_options_t *args_info)
   args_info->hpx_sched_policy_given = 0 ;
   args_info->hpx_sched_wfthreshold_given = 0 ;
   args_info->hpx_sched_stackcachelimit_given = 0 ;
+  args_info->hpx_sched_spinbudget_given = 0 ;
+  args_info->hpx_sched_parkperiod_given = 0 ;
+  args_info->hpx_sched_wakefanout_given = 0 ;
+  args_info->hpx_sched_elastic_given = 0 ;
   args_info->hpx_progress_period_given = 0 ;
+  args_info->hpx_progress_thread_given = 0 ;
+  args_info->hpx_progress_cpu_given = 0 ;
+  args_info->hpx_network_chunksize_given = 0 ;
+  args_info->hpx_network_chunkwindow_given = 0 ;
   args_info->hpx_gas_affinity_given = 0 ;
+  args_info->hpx_gas_numa_given = 0 ;
   args_info->hpx_log_at_given = 0 ;
   args_info->hpx_log_level_given = 0 ;
   args_info->hpx_dbg_waitat_given = 0 ;
@@ -203,6 +236,12 @@ void clear_given (struct hpx_options_t *args_info)
   args_info->hpx_isir_testwindow_given = 0 ;
   args_info->hpx_isir_sendlimit_given = 0 ;
   args_info->hpx_isir_recvlimit_given = 0 ;
+  args_info->hpx_isir_threaded_given = 0 ;
+  args_info->hpx_isir_lanes_given = 0 ;
+  args_info->hpx_isir_eagerring_given = 0 ;
+  args_info->hpx_isir_eagersize_given = 0 ;
+  args_info->hpx_isir_credits_given = 0 ;
+  args_info->hpx_shm_ringsize_given = 0 ;
   args_info->hpx_pwc_parcelbuffersize_given = 0 ;
   args_info->hpx_pwc_parceleagerlimit_given = 0 ;
   args_info->hpx_coll_network_given = 0 ;
@@ -227,7 +266,12 @@ void clear_given (struct hpx_options_t *args_info)
   args_info->hpx_photon_usercq_given = 0 ;
   args_info->hpx_opt_smp_given = 0 ;
   args_info->hpx_parcel_compression_given = 0 ;
+  args_info->hpx_parcel_compression_minsize_given = 0 ;
+  args_info->hpx_parcel_compression_ratio_given = 0 ;
+  args_info->hpx_parcel_cachesize_given = 0 ;
   args_info->hpx_coalescing_buffersize_given = 0 ;
+  args_info->hpx_coalescing_bytes_given = 0 ;
+  args_info->hpx_coalescing_timeout_given = 0 ;
 }
 
 static
@@ -241,6 +285,7 @@ void clear_args (struct hpx_options_t *args_info)
   args_info->hpx_gas_orig = NULL;
   args_info->hpx_boot_arg = hpx_boot__NULL;
   args_info->hpx_boot_orig = NULL;
+  args_info->hpx_boot_ranks_orig = NULL;
   args_info->hpx_transport_arg = hpx_transport__NULL;
   args_info->hpx_transport_orig = NULL;
   args_info->hpx_network_arg = hpx_network__NULL;
@@ -255,9 +300,19 @@ void clear_args (struct hpx_options_t *args_info)
   args_info->hpx_sched_policy_orig = NULL;
   args_info->hpx_sched_wfthreshold_orig = NULL;
   args_info->hpx_sched_stackcachelimit_orig = NULL;
+  args_info->hpx_sched_spinbudget_orig = NULL;
+  args_info->hpx_sched_parkperiod_orig = NULL;
+  args_info->hpx_sched_wakefanout_orig = NULL;
+  args_info->hpx_sched_elastic_flag = 0;
   args_info->hpx_progress_period_orig = NULL;
+  args_info->hpx_progress_thread_flag = 0;
+  args_info->hpx_progress_cpu_orig = NULL;
+  args_info->hpx_network_chunksize_orig = NULL;
+  args_info->hpx_network_chunkwindow_orig = NULL;
   args_info->hpx_gas_affinity_arg = hpx_gas_affinity__NULL;
   args_info->hpx_gas_affinity_orig = NULL;
+  args_info->hpx_gas_numa_arg = hpx_gas_numa__NULL;
+  args_info->hpx_gas_numa_orig = NULL;
   args_info->hpx_log_at_arg = NULL;
   args_info->hpx_log_at_orig = NULL;
   args_info->hpx_log_level_arg = NULL;
@@ -282,6 +337,12 @@ void clear_args (struct hpx_options_t *args_info)
   args_info->hpx_isir_testwindow_orig = NULL;
   args_info->hpx_isir_sendlimit_orig = NULL;
   args_info->hpx_isir_recvlimit_orig = NULL;
+  args_info->hpx_isir_threaded_flag = 0;
+  args_info->hpx_isir_lanes_orig = NULL;
+  args_info->hpx_isir_eagerring_orig = NULL;
+  args_info->hpx_isir_eagersize_orig = NULL;
+  args_info->hpx_isir_credits_orig = NULL;
+  args_info->hpx_shm_ringsize_orig = NULL;
   args_info->hpx_pwc_parcelbuffersize_orig = NULL;
   args_info->hpx_pwc_parceleagerlimit_orig = NULL;
   args_info->hpx_coll_network_flag = 0;
@@ -313,7 +374,12 @@ void clear_args (struct hpx_options_t *args_info)
   args_info->hpx_photon_usercq_orig = NULL;
   args_info->hpx_opt_smp_orig = NULL;
   args_info->hpx_parcel_compression_flag = 0;
+  args_info->hpx_parcel_compression_minsize_orig = NULL;
+  args_info->hpx_parcel_compression_ratio_orig = NULL;
+  args_info->hpx_parcel_cachesize_orig = NULL;
   args_info->hpx_coalescing_buffersize_orig = NULL;
+  args_info->hpx_coalescing_bytes_orig = NULL;
+  args_info->hpx_coalescing_timeout_orig = NULL;
   
 }
 
@@ -327,70 +393,91 @@ void init_args_info(struct hpx_options_t *args_info)
   args_info->hpx_heapsize_help = hpx_options_t_help[4] ;
   args_info->hpx_gas_help = hpx_options_t_help[5] ;
   args_info->hpx_boot_help = hpx_options_t_help[6] ;
-  args_info->hpx_transport_help = hpx_options_t_help[7] ;
-  args_info->hpx_network_help = hpx_options_t_help[8] ;
-  args_info->hpx_configfile_help = hpx_options_t_help[9] ;
-  args_info->hpx_threads_help = hpx_options_t_help[11] ;
-  args_info->hpx_thread_affinity_help = hpx_options_t_help[12] ;
-  args_info->hpx_stacksize_help = hpx_options_t_help[13] ;
-  args_info->hpx_sched_policy_help = hpx_options_t_help[14] ;
-  args_info->hpx_sched_wfthreshold_help = hpx_options_t_help[15] ;
-  args_info->hpx_sched_stackcachelimit_help = hpx_options_t_help[16] ;
-  args_info->hpx_progress_period_help = hpx_options_t_help[18] ;
-  args_info->hpx_gas_affinity_help = hpx_options_t_help[20] ;
-  args_info->hpx_log_at_help = hpx_options_t_help[22] ;
+  args_info->hpx_boot_ranks_help = hpx_options_t_help[7] ;
+  args_info->hpx_transport_help = hpx_options_t_help[8] ;
+  args_info->hpx_network_help = hpx_options_t_help[9] ;
+  args_info->hpx_configfile_help = hpx_options_t_help[10] ;
+  args_info->hpx_threads_help = hpx_options_t_help[12] ;
+  args_info->hpx_thread_affinity_help = hpx_options_t_help[13] ;
+  args_info->hpx_stacksize_help = hpx_options_t_help[14] ;
+  args_info->hpx_sched_policy_help = hpx_options_t_help[15] ;
+  args_info->hpx_sched_wfthreshold_help = hpx_options_t_help[16] ;
+  args_info->hpx_sched_stackcachelimit_help = hpx_options_t_help[17] ;
+  args_info->hpx_sched_spinbudget_help = hpx_options_t_help[18] ;
+  args_info->hpx_sched_parkperiod_help = hpx_options_t_help[19] ;
+  args_info->hpx_sched_wakefanout_help = hpx_options_t_help[20] ;
+  args_info->hpx_sched_elastic_help = hpx_options_t_help[21] ;
+  args_info->hpx_progress_period_help = hpx_options_t_help[23] ;
+  args_info->hpx_progress_thread_help = hpx_options_t_help[24] ;
+  args_info->hpx_progress_cpu_help = hpx_options_t_help[25] ;
+  args_info->hpx_network_chunksize_help = hpx_options_t_help[26] ;
+  args_info->hpx_network_chunkwindow_help = hpx_options_t_help[27] ;
+  args_info->hpx_gas_affinity_help = hpx_options_t_help[29] ;
+  args_info->hpx_gas_numa_help = hpx_options_t_help[30] ;
+  args_info->hpx_log_at_help = hpx_options_t_help[32] ;
   args_info->hpx_log_at_min = 0;
   args_info->hpx_log_at_max = 0;
-  args_info->hpx_log_level_help = hpx_options_t_help[23] ;
+  args_info->hpx_log_level_help = hpx_options_t_help[33] ;
   args_info->hpx_log_level_min = 0;
   args_info->hpx_log_level_max = 0;
-  args_info->hpx_dbg_waitat_help = hpx_options_t_help[25] ;
+  args_info->hpx_dbg_waitat_help = hpx_options_t_help[35] ;
   args_info->hpx_dbg_waitat_min = 0;
   args_info->hpx_dbg_waitat_max = 0;
-  args_info->hpx_dbg_waitonabort_help = hpx_options_t_help[26] ;
-  args_info->hpx_dbg_waitonsig_help = hpx_options_t_help[27] ;
+  args_info->hpx_dbg_waitonabort_help = hpx_options_t_help[36] ;
+  args_info->hpx_dbg_waitonsig_help = hpx_options_t_help[37] ;
   args_info->hpx_dbg_waitonsig_min = 0;
   args_info->hpx_dbg_waitonsig_max = 0;
-  args_info->hpx_dbg_mprotectstacks_help = hpx_options_t_help[28] ;
-  args_info->hpx_dbg_syncfree_help = hpx_options_t_help[29] ;
-  args_info->hpx_trace_backend_help = hpx_options_t_help[31] ;
-  args_info->hpx_trace_at_help = hpx_options_t_help[32] ;
+  args_info->hpx_dbg_mprotectstacks_help = hpx_options_t_help[38] ;
+  args_info->hpx_dbg_syncfree_help = hpx_options_t_help[39] ;
+  args_info->hpx_trace_backend_help = hpx_options_t_help[41] ;
+  args_info->hpx_trace_at_help = hpx_options_t_help[42] ;
   args_info->hpx_trace_at_min = 0;
   args_info->hpx_trace_at_max = 0;
-  args_info->hpx_trace_classes_help = hpx_options_t_help[33] ;
+  args_info->hpx_trace_classes_help = hpx_options_t_help[43] ;
   args_info->hpx_trace_classes_min = 0;
   args_info->hpx_trace_classes_max = 0;
-  args_info->hpx_trace_dir_help = hpx_options_t_help[34] ;
-  args_info->hpx_trace_buffersize_help = hpx_options_t_help[35] ;
-  args_info->hpx_trace_off_help = hpx_options_t_help[36] ;
-  args_info->hpx_isir_testwindow_help = hpx_options_t_help[38] ;
-  args_info->hpx_isir_sendlimit_help = hpx_options_t_help[39] ;
-  args_info->hpx_isir_recvlimit_help = hpx_options_t_help[40] ;
-  args_info->hpx_pwc_parcelbuffersize_help = hpx_options_t_help[42] ;
-  args_info->hpx_pwc_parceleagerlimit_help = hpx_options_t_help[43] ;
-  args_info->hpx_coll_network_help = hpx_options_t_help[45] ;
-  args_info->hpx_photon_comporder_help = hpx_options_t_help[47] ;
-  args_info->hpx_photon_backend_help = hpx_options_t_help[48] ;
-  args_info->hpx_photon_coll_help = hpx_options_t_help[49] ;
-  args_info->hpx_photon_ibdev_help = hpx_options_t_help[50] ;
-  args_info->hpx_photon_ethdev_help = hpx_options_t_help[51] ;
-  args_info->hpx_photon_ibport_help = hpx_options_t_help[52] ;
-  args_info->hpx_photon_usecma_help = hpx_options_t_help[53] ;
-  args_info->hpx_photon_ibsrq_help = hpx_options_t_help[54] ;
-  args_info->hpx_photon_btethresh_help = hpx_options_t_help[55] ;
-  args_info->hpx_photon_fiprov_help = hpx_options_t_help[56] ;
-  args_info->hpx_photon_fidev_help = hpx_options_t_help[57] ;
-  args_info->hpx_photon_ledgersize_help = hpx_options_t_help[58] ;
-  args_info->hpx_photon_pwcbufsize_help = hpx_options_t_help[59] ;
-  args_info->hpx_photon_eagerbufsize_help = hpx_options_t_help[60] ;
-  args_info->hpx_photon_smallpwcsize_help = hpx_options_t_help[61] ;
-  args_info->hpx_photon_maxrd_help = hpx_options_t_help[62] ;
-  args_info->hpx_photon_defaultrd_help = hpx_options_t_help[63] ;
-  args_info->hpx_photon_numcq_help = hpx_options_t_help[64] ;
-  args_info->hpx_photon_usercq_help = hpx_options_t_help[65] ;
-  args_info->hpx_opt_smp_help = hpx_options_t_help[67] ;
-  args_info->hpx_parcel_compression_help = hpx_options_t_help[68] ;
-  args_info->hpx_coalescing_buffersize_help = hpx_options_t_help[69] ;
+  args_info->hpx_trace_dir_help = hpx_options_t_help[44] ;
+  args_info->hpx_trace_buffersize_help = hpx_options_t_help[45] ;
+  args_info->hpx_trace_off_help = hpx_options_t_help[46] ;
+  args_info->hpx_isir_testwindow_help = hpx_options_t_help[48] ;
+  args_info->hpx_isir_sendlimit_help = hpx_options_t_help[49] ;
+  args_info->hpx_isir_recvlimit_help = hpx_options_t_help[50] ;
+  args_info->hpx_isir_threaded_help = hpx_options_t_help[51] ;
+  args_info->hpx_isir_lanes_help = hpx_options_t_help[52] ;
+  args_info->hpx_isir_eagerring_help = hpx_options_t_help[53] ;
+  args_info->hpx_isir_eagersize_help = hpx_options_t_help[54] ;
+  args_info->hpx_isir_credits_help = hpx_options_t_help[55] ;
+  args_info->hpx_shm_ringsize_help = hpx_options_t_help[57] ;
+  args_info->hpx_pwc_parcelbuffersize_help = hpx_options_t_help[59] ;
+  args_info->hpx_pwc_parceleagerlimit_help = hpx_options_t_help[60] ;
+  args_info->hpx_coll_network_help = hpx_options_t_help[62] ;
+  args_info->hpx_photon_comporder_help = hpx_options_t_help[64] ;
+  args_info->hpx_photon_backend_help = hpx_options_t_help[65] ;
+  args_info->hpx_photon_coll_help = hpx_options_t_help[66] ;
+  args_info->hpx_photon_ibdev_help = hpx_options_t_help[67] ;
+  args_info->hpx_photon_ethdev_help = hpx_options_t_help[68] ;
+  args_info->hpx_photon_ibport_help = hpx_options_t_help[69] ;
+  args_info->hpx_photon_usecma_help = hpx_options_t_help[70] ;
+  args_info->hpx_photon_ibsrq_help = hpx_options_t_help[71] ;
+  args_info->hpx_photon_btethresh_help = hpx_options_t_help[72] ;
+  args_info->hpx_photon_fiprov_help = hpx_options_t_help[73] ;
+  args_info->hpx_photon_fidev_help = hpx_options_t_help[74] ;
+  args_info->hpx_photon_ledgersize_help = hpx_options_t_help[75] ;
+  args_info->hpx_photon_pwcbufsize_help = hpx_options_t_help[76] ;
+  args_info->hpx_photon_eagerbufsize_help = hpx_options_t_help[77] ;
+  args_info->hpx_photon_smallpwcsize_help = hpx_options_t_help[78] ;
+  args_info->hpx_photon_maxrd_help = hpx_options_t_help[79] ;
+  args_info->hpx_photon_defaultrd_help = hpx_options_t_help[80] ;
+  args_info->hpx_photon_numcq_help = hpx_options_t_help[81] ;
+  args_info->hpx_photon_usercq_help = hpx_options_t_help[82] ;
+  args_info->hpx_opt_smp_help = hpx_options_t_help[84] ;
+  args_info->hpx_parcel_compression_help = hpx_options_t_help[85] ;
+  args_info->hpx_parcel_compression_minsize_help = hpx_options_t_help[86] ;
+  args_info->hpx_parcel_compression_ratio_help = hpx_options_t_help[87] ;
+  args_info->hpx_parcel_cachesize_help = hpx_options_t_help[88] ;
+  args_info->hpx_coalescing_buffersize_help = hpx_options_t_help[89] ;
+  args_info->hpx_coalescing_bytes_help = hpx_options_t_help[90] ;
+  args_info->hpx_coalescing_timeout_help = hpx_options_t_help[91] ;
   
 }
 
@@ -523,6 +610,7 @@ hpx_option_parser_release (struct hpx_options_t *args_info)
   free_string_field (&(args_info->hpx_heapsize_orig));
   free_string_field (&(args_info->hpx_gas_orig));
   free_string_field (&(args_info->hpx_boot_orig));
+  free_string_field (&(args_info->hpx_boot_ranks_orig));
   free_string_field (&(args_info->hpx_transport_orig));
   free_string_field (&(args_info->hpx_network_orig));
   free_string_field (&(args_info->hpx_configfile_arg));
@@ -533,8 +621,15 @@ hpx_option_parser_release (struct hpx_options_t *args_info)
   free_string_field (&(args_info->hpx_sched_policy_orig));
   free_string_field (&(args_info->hpx_sched_wfthreshold_orig));
   free_string_field (&(args_info->hpx_sched_stackcachelimit_orig));
+  free_string_field (&(args_info->hpx_sched_spinbudget_orig));
+  free_string_field (&(args_info->hpx_sched_parkperiod_orig));
+  free_string_field (&(args_info->hpx_sched_wakefanout_orig));
   free_string_field (&(args_info->hpx_progress_period_orig));
+  free_string_field (&(args_info->hpx_progress_cpu_orig));
+  free_string_field (&(args_info->hpx_network_chunksize_orig));
+  free_string_field (&(args_info->hpx_network_chunkwindow_orig));
   free_string_field (&(args_info->hpx_gas_affinity_orig));
+  free_string_field (&(args_info->hpx_gas_numa_orig));
   free_multiple_field (args_info->hpx_log_at_given, (void *)(args_info->hpx_log_at_arg), &(args_info->hpx_log_at_orig));
   args_info->hpx_log_at_arg = 0;
   free_multiple_field (args_info->hpx_log_level_given, (void *)(args_info->hpx_log_level_arg), &(args_info->hpx_log_level_orig));
@@ -554,6 +649,11 @@ hpx_option_parser_release (struct hpx_options_t *args_info)
   free_string_field (&(args_info->hpx_isir_testwindow_orig));
   free_string_field (&(args_info->hpx_isir_sendlimit_orig));
   free_string_field (&(args_info->hpx_isir_recvlimit_orig));
+  free_string_field (&(args_info->hpx_isir_lanes_orig));
+  free_string_field (&(args_info->hpx_isir_eagerring_orig));
+  free_string_field (&(args_info->hpx_isir_eagersize_orig));
+  free_string_field (&(args_info->hpx_isir_credits_orig));
+  free_string_field (&(args_info->hpx_shm_ringsize_orig));
   free_string_field (&(args_info->hpx_pwc_parcelbuffersize_orig));
   free_string_field (&(args_info->hpx_pwc_parceleagerlimit_orig));
   free_string_field (&(args_info->hpx_photon_comporder_orig));
@@ -579,7 +679,12 @@ hpx_option_parser_release (struct hpx_options_t *args_info)
   free_string_field (&(args_info->hpx_photon_numcq_orig));
   free_string_field (&(args_info->hpx_photon_usercq_orig));
   free_string_field (&(args_info->hpx_opt_smp_orig));
+  free_string_field (&(args_info->hpx_parcel_compression_minsize_orig));
+  free_string_field (&(args_info->hpx_parcel_compression_ratio_orig));
+  free_string_field (&(args_info->hpx_parcel_cachesize_orig));
   free_string_field (&(args_info->hpx_coalescing_buffersize_orig));
+  free_string_field (&(args_info->hpx_coalescing_bytes_orig));
+  free_string_field (&(args_info->hpx_coalescing_timeout_orig));
   
   
 
@@ -669,6 +774,8 @@ hpx_option_parser_dump(FILE *outfile, struct hpx_options_t *args_info)
     write_into_file(outfile, "hpx-gas", args_info->hpx_gas_orig, hpx_option_parser_hpx_gas_values);
   if (args_info->hpx_boot_given)
     write_into_file(outfile, "hpx-boot", args_info->hpx_boot_orig, hpx_option_parser_hpx_boot_values);
+  if (args_info->hpx_boot_ranks_given)
+    write_into_file(outfile, "hpx-boot-ranks", args_info->hpx_boot_ranks_orig, 0);
   if (args_info->hpx_transport_given)
     write_into_file(outfile, "hpx-transport", args_info->hpx_transport_orig, hpx_option_parser_hpx_transport_values);
   if (args_info->hpx_network_given)
@@ -687,10 +794,28 @@ hpx_option_parser_dump(FILE *outfile, struct hpx_options_t *args_info)
     write_into_file(outfile, "hpx-sched-wfthreshold", args_info->hpx_sched_wfthreshold_orig, 0);
   if (args_info->hpx_sched_stackcachelimit_given)
     write_into_file(outfile, "hpx-sched-stackcachelimit", args_info->hpx_sched_stackcachelimit_orig, 0);
+  if (args_info->hpx_sched_spinbudget_given)
+    write_into_file(outfile, "hpx-sched-spinbudget", args_info->hpx_sched_spinbudget_orig, 0);
+  if (args_info->hpx_sched_parkperiod_given)
+    write_into_file(outfile, "hpx-sched-parkperiod", args_info->hpx_sched_parkperiod_orig, 0);
+  if (args_info->hpx_sched_wakefanout_given)
+    write_into_file(outfile, "hpx-sched-wakefanout", args_info->hpx_sched_wakefanout_orig, 0);
+  if (args_info->hpx_sched_elastic_given)
+    write_into_file(outfile, "hpx-sched-elastic", 0, 0 );
   if (args_info->hpx_progress_period_given)
     write_into_file(outfile, "hpx-progress-period", args_info->hpx_progress_period_orig, 0);
+  if (args_info->hpx_progress_thread_given)
+    write_into_file(outfile, "hpx-progress-thread", 0, 0 );
+  if (args_info->hpx_progress_cpu_given)
+    write_into_file(outfile, "hpx-progress-cpu", args_info->hpx_progress_cpu_orig, 0);
+  if (args_info->hpx_network_chunksize_given)
+    write_into_file(outfile, "hpx-network-chunksize", args_info->hpx_network_chunksize_orig, 0);
+  if (args_info->hpx_network_chunkwindow_given)
+    write_into_file(outfile, "hpx-network-chunkwindow", args_info->hpx_network_chunkwindow_orig, 0);
   if (args_info->hpx_gas_affinity_given)
     write_into_file(outfile, "hpx-gas-affinity", args_info->hpx_gas_affinity_orig, hpx_option_parser_hpx_gas_affinity_values);
+  if (args_info->hpx_gas_numa_given)
+    write_into_file(outfile, "hpx-gas-numa", args_info->hpx_gas_numa_orig, hpx_option_parser_hpx_gas_numa_values);
   write_multiple_into_file(outfile, args_info->hpx_log_at_given, "hpx-log-at", args_info->hpx_log_at_orig, 0);
   write_multiple_into_file(outfile, args_info->hpx_log_level_given, "hpx-log-level", args_info->hpx_log_level_orig, hpx_option_parser_hpx_log_level_values);
   write_multiple_into_file(outfile, args_info->hpx_dbg_waitat_given, "hpx-dbg-waitat", args_info->hpx_dbg_waitat_orig, 0);
@@ -717,6 +842,18 @@ hpx_option_parser_dump(FILE *outfile, struct hpx_options_t *args_info)
     write_into_file(outfile, "hpx-isir-sendlimit", args_info->hpx_isir_sendlimit_orig, 0);
   if (args_info->hpx_isir_recvlimit_given)
     write_into_file(outfile, "hpx-isir-recvlimit", args_info->hpx_isir_recvlimit_orig, 0);
+  if (args_info->hpx_isir_threaded_given)
+    write_into_file(outfile, "hpx-isir-threaded", 0, 0 );
+  if (args_info->hpx_isir_lanes_given)
+    write_into_file(outfile, "hpx-isir-lanes", args_info->hpx_isir_lanes_orig, 0);
+  if (args_info->hpx_isir_eagerring_given)
+    write_into_file(outfile, "hpx-isir-eagerring", args_info->hpx_isir_eagerring_orig, 0);
+  if (args_info->hpx_isir_eagersize_given)
+    write_into_file(outfile, "hpx-isir-eagersize", args_info->hpx_isir_eagersize_orig, 0);
+  if (args_info->hpx_isir_credits_given)
+    write_into_file(outfile, "hpx-isir-credits", args_info->hpx_isir_credits_orig, 0);
+  if (args_info->hpx_shm_ringsize_given)
+    write_into_file(outfile, "hpx-shm-ringsize", args_info->hpx_shm_ringsize_orig, 0);
   if (args_info->hpx_pwc_parcelbuffersize_given)
     write_into_file(outfile, "hpx-pwc-parcelbuffersize", args_info->hpx_pwc_parcelbuffersize_orig, 0);
   if (args_info->hpx_pwc_parceleagerlimit_given)
@@ -765,8 +902,18 @@ hpx_option_parser_dump(FILE *outfile, struct hpx_options_t *args_info)
     write_into_file(outfile, "hpx-opt-smp", args_info->hpx_opt_smp_orig, 0);
   if (args_info->hpx_parcel_compression_given)
     write_into_file(outfile, "hpx-parcel-compression", 0, 0 );
+  if (args_info->hpx_parcel_compression_minsize_given)
+    write_into_file(outfile, "hpx-parcel-compression-minsize", args_info->hpx_parcel_compression_minsize_orig, 0);
+  if (args_info->hpx_parcel_compression_ratio_given)
+    write_into_file(outfile, "hpx-parcel-compression-ratio", args_info->hpx_parcel_compression_ratio_orig, 0);
+  if (args_info->hpx_parcel_cachesize_given)
+    write_into_file(outfile, "hpx-parcel-cachesize", args_info->hpx_parcel_cachesize_orig, 0);
   if (args_info->hpx_coalescing_buffersize_given)
     write_into_file(outfile, "hpx-coalescing-buffersize", args_info->hpx_coalescing_buffersize_orig, 0);
+  if (args_info->hpx_coalescing_bytes_given)
+    write_into_file(outfile, "hpx-coalescing-bytes", args_info->hpx_coalescing_bytes_orig, 0);
+  if (args_info->hpx_coalescing_timeout_given)
+    write_into_file(outfile, "hpx-coalescing-timeout", args_info->hpx_coalescing_timeout_orig, 0);
   
 
   i = EXIT_SUCCESS;
@@ -1968,6 +2115,7 @@ hpx_option_parser_internal (
         { "hpx-heapsize",	1, NULL, 0 },
         { "hpx-gas",	1, NULL, 0 },
         { "hpx-boot",	1, NULL, 0 },
+        { "hpx-boot-ranks",	1, NULL, 0 },
         { "hpx-transport",	1, NULL, 0 },
         { "hpx-network",	1, NULL, 0 },
         { "hpx-configfile",	1, NULL, 0 },
@@ -1977,8 +2125,17 @@ hpx_option_parser_internal (
         { "hpx-sched-policy",	1, NULL, 0 },
         { "hpx-sched-wfthreshold",	1, NULL, 0 },
         { "hpx-sched-stackcachelimit",	1, NULL, 0 },
+        { "hpx-sched-spinbudget",	1, NULL, 0 },
+        { "hpx-sched-parkperiod",	1, NULL, 0 },
+        { "hpx-sched-wakefanout",	1, NULL, 0 },
+        { "hpx-sched-elastic",	0, NULL, 0 },
         { "hpx-progress-period",	1, NULL, 0 },
+        { "hpx-progress-thread",	0, NULL, 0 },
+        { "hpx-progress-cpu",	1, NULL, 0 },
+        { "hpx-network-chunksize",	1, NULL, 0 },
+        { "hpx-network-chunkwindow",	1, NULL, 0 },
         { "hpx-gas-affinity",	1, NULL, 0 },
+        { "hpx-gas-numa",	1, NULL, 0 },
         { "hpx-log-at",	1, NULL, 0 },
         { "hpx-log-level",	2, NULL, 0 },
         { "hpx-dbg-waitat",	1, NULL, 0 },
@@ -1995,6 +2152,12 @@ hpx_option_parser_internal (
         { "hpx-isir-testwindow",	1, NULL, 0 },
         { "hpx-isir-sendlimit",	1, NULL, 0 },
         { "hpx-isir-recvlimit",	1, NULL, 0 },
+        { "hpx-isir-threaded",	0, NULL, 0 },
+        { "hpx-isir-lanes",	1, NULL, 0 },
+        { "hpx-isir-eagerring",	1, NULL, 0 },
+        { "hpx-isir-eagersize",	1, NULL, 0 },
+        { "hpx-isir-credits",	1, NULL, 0 },
+        { "hpx-shm-ringsize",	1, NULL, 0 },
         { "hpx-pwc-parcelbuffersize",	1, NULL, 0 },
         { "hpx-pwc-parceleagerlimit",	1, NULL, 0 },
         { "hpx-coll-network",	0, NULL, 0 },
@@ -2019,7 +2182,12 @@ hpx_option_parser_internal (
         { "hpx-photon-usercq",	1, NULL, 0 },
         { "hpx-opt-smp",	2, NULL, 0 },
         { "hpx-parcel-compression",	0, NULL, 0 },
+        { "hpx-parcel-compression-minsize",	1, NULL, 0 },
+        { "hpx-parcel-compression-ratio",	1, NULL, 0 },
+        { "hpx-parcel-cachesize",	1, NULL, 0 },
         { "hpx-coalescing-buffersize",	1, NULL, 0 },
+        { "hpx-coalescing-bytes",	1, NULL, 0 },
+        { "hpx-coalescing-timeout",	1, NULL, 0 },
         { 0,  0, 0, 0 }
       };
 
@@ -2106,6 +2274,20 @@ hpx_option_parser_internal (
                 additional_error))
               goto failure;
           
+          }
+          /* number of localities to start with --hpx-boot=fork.  */
+          else if (strcmp (long_options[option_index].name, "hpx-boot-ranks") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_boot_ranks_arg), 
+                 &(args_info->hpx_boot_ranks_orig), &(args_info->hpx_boot_ranks_given),
+                &(local_args_info.hpx_boot_ranks_given), optarg, 0, 0, ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "hpx-boot-ranks", '-',
+                additional_error))
+              goto failure;
+          
           }
           /* type of transport to use.  */
           else if (strcmp (long_options[option_index].name, "hpx-transport") == 0)
@@ -2232,6 +2414,60 @@ hpx_option_parser_internal (
                 additional_error))
               goto failure;
           
+          }
+          /* empty schedule iterations before an idle worker parks, -1 to never park.  */
+          else if (strcmp (long_options[option_index].name, "hpx-sched-spinbudget") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_sched_spinbudget_arg), 
+                 &(args_info->hpx_sched_spinbudget_orig), &(args_info->hpx_sched_spinbudget_given),
+                &(local_args_info.hpx_sched_spinbudget_given), optarg, 0, 0, ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "hpx-sched-spinbudget", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* bound on how long a parked worker sleeps before polling again.  */
+          else if (strcmp (long_options[option_index].name, "hpx-sched-parkperiod") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_sched_parkperiod_arg), 
+                 &(args_info->hpx_sched_parkperiod_orig), &(args_info->hpx_sched_parkperiod_given),
+                &(local_args_info.hpx_sched_parkperiod_given), optarg, 0, 0, ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "hpx-sched-parkperiod", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* number of parked workers to wake when new work is spawned.  */
+          else if (strcmp (long_options[option_index].name, "hpx-sched-wakefanout") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_sched_wakefanout_arg), 
+                 &(args_info->hpx_sched_wakefanout_orig), &(args_info->hpx_sched_wakefanout_given),
+                &(local_args_info.hpx_sched_wakefanout_given), optarg, 0, 0, ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "hpx-sched-wakefanout", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* grow and shrink the number of running workers with the load.  */
+          else if (strcmp (long_options[option_index].name, "hpx-sched-elastic") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->hpx_sched_elastic_flag), 0, &(args_info->hpx_sched_elastic_given),
+                &(local_args_info.hpx_sched_elastic_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "hpx-sched-elastic", '-',
+                additional_error))
+              goto failure;
+          
           }
           /* async network progess period.  */
           else if (strcmp (long_options[option_index].name, "hpx-progress-period") == 0)
@@ -2246,6 +2482,60 @@ hpx_option_parser_internal (
                 additional_error))
               goto failure;
           
+          }
+          /* drive the network from a dedicated progress thread instead of the workers.  */
+          else if (strcmp (long_options[option_index].name, "hpx-progress-thread") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->hpx_progress_thread_flag), 0, &(args_info->hpx_progress_thread_given),
+                &(local_args_info.hpx_progress_thread_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "hpx-progress-thread", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* cpu to bind the progress thread to (-1 to leave it unbound).  */
+          else if (strcmp (long_options[option_index].name, "hpx-progress-cpu") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_progress_cpu_arg), 
+                 &(args_info->hpx_progress_cpu_orig), &(args_info->hpx_progress_cpu_given),
+                &(local_args_info.hpx_progress_cpu_given), optarg, 0, 0, ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "hpx-progress-cpu", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* split parcel-based memget and memput larger than this into pipelined chunks (0 to disable).  */
+          else if (strcmp (long_options[option_index].name, "hpx-network-chunksize") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_network_chunksize_arg), 
+                 &(args_info->hpx_network_chunksize_orig), &(args_info->hpx_network_chunksize_given),
+                &(local_args_info.hpx_network_chunksize_given), optarg, 0, 0, ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "hpx-network-chunksize", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* number of memget or memput chunks in flight at once.  */
+          else if (strcmp (long_options[option_index].name, "hpx-network-chunkwindow") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_network_chunkwindow_arg), 
+                 &(args_info->hpx_network_chunkwindow_orig), &(args_info->hpx_network_chunkwindow_given),
+                &(local_args_info.hpx_network_chunkwindow_given), optarg, 0, 0, ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "hpx-network-chunkwindow", '-',
+                additional_error))
+              goto failure;
+          
           }
           /* GAS affinity implementation.  */
           else if (strcmp (long_options[option_index].name, "hpx-gas-affinity") == 0)
@@ -2260,6 +2550,20 @@ hpx_option_parser_internal (
                 additional_error))
               goto failure;
           
+          }
+          /* NUMA placement policy for the global heap.  */
+          else if (strcmp (long_options[option_index].name, "hpx-gas-numa") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_gas_numa_arg), 
+                 &(args_info->hpx_gas_numa_orig), &(args_info->hpx_gas_numa_given),
+                &(local_args_info.hpx_gas_numa_given), optarg, hpx_option_parser_hpx_gas_numa_values, 0, ARG_ENUM,
+                check_ambiguity, override, 0, 0,
+                "hpx-gas-numa", '-',
+                additional_error))
+              goto failure;
+          
           }
           /* filter by locality, -1 for all (default none).  */
           else if (strcmp (long_options[option_index].name, "hpx-log-at") == 0)
@@ -2458,6 +2762,88 @@ hpx_option_parser_internal (
                 additional_error))
               goto failure;
           
+          }
+          /* use MPI_THREAD_MULTIPLE and let workers drive the network concurrently.  */
+          else if (strcmp (long_options[option_index].name, "hpx-isir-threaded") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->hpx_isir_threaded_flag), 0, &(args_info->hpx_isir_threaded_given),
+                &(local_args_info.hpx_isir_threaded_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "hpx-isir-threaded", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* number of independent ISIR lanes in threaded mode (0 for one per worker).  */
+          else if (strcmp (long_options[option_index].name, "hpx-isir-lanes") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_isir_lanes_arg), 
+                 &(args_info->hpx_isir_lanes_orig), &(args_info->hpx_isir_lanes_given),
+                &(local_args_info.hpx_isir_lanes_given), optarg, 0, 0, ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "hpx-isir-lanes", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* number of preposted ISIR eager receive buffers (0 to probe for every message).  */
+          else if (strcmp (long_options[option_index].name, "hpx-isir-eagerring") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_isir_eagerring_arg), 
+                 &(args_info->hpx_isir_eagerring_orig), &(args_info->hpx_isir_eagerring_given),
+                &(local_args_info.hpx_isir_eagerring_given), optarg, 0, 0, ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "hpx-isir-eagerring", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* largest ISIR message that is received through the eager ring.  */
+          else if (strcmp (long_options[option_index].name, "hpx-isir-eagersize") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_isir_eagersize_arg), 
+                 &(args_info->hpx_isir_eagersize_orig), &(args_info->hpx_isir_eagersize_given),
+                &(local_args_info.hpx_isir_eagersize_given), optarg, 0, 0, ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "hpx-isir-eagersize", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* number of outstanding ISIR sends to each peer (0 for unlimited).  */
+          else if (strcmp (long_options[option_index].name, "hpx-isir-credits") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_isir_credits_arg), 
+                 &(args_info->hpx_isir_credits_orig), &(args_info->hpx_isir_credits_given),
+                &(local_args_info.hpx_isir_credits_given), optarg, 0, 0, ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "hpx-isir-credits", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* size of the parcel ring between each pair of localities.  */
+          else if (strcmp (long_options[option_index].name, "hpx-shm-ringsize") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_shm_ringsize_arg), 
+                 &(args_info->hpx_shm_ringsize_orig), &(args_info->hpx_shm_ringsize_given),
+                &(local_args_info.hpx_shm_ringsize_given), optarg, 0, 0, ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "hpx-shm-ringsize", '-',
+                additional_error))
+              goto failure;
+          
           }
           /* set the size of p2p recv buffers for parcel sends.  */
           else if (strcmp (long_options[option_index].name, "hpx-pwc-parcelbuffersize") == 0)
@@ -2788,6 +3174,48 @@ hpx_option_parser_internal (
                 additional_error))
               goto failure;
           
+          }
+          /* smallest parcel that compression is tried on.  */
+          else if (strcmp (long_options[option_index].name, "hpx-parcel-compression-minsize") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_parcel_compression_minsize_arg), 
+                 &(args_info->hpx_parcel_compression_minsize_orig), &(args_info->hpx_parcel_compression_minsize_given),
+                &(local_args_info.hpx_parcel_compression_minsize_given), optarg, 0, 0, ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "hpx-parcel-compression-minsize", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* largest compressed size, as a percentage of the original, that is worth sending.  */
+          else if (strcmp (long_options[option_index].name, "hpx-parcel-compression-ratio") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_parcel_compression_ratio_arg), 
+                 &(args_info->hpx_parcel_compression_ratio_orig), &(args_info->hpx_parcel_compression_ratio_given),
+                &(local_args_info.hpx_parcel_compression_ratio_given), optarg, 0, 0, ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "hpx-parcel-compression-ratio", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* registered memory reserved for the per-worker parcel caches.  */
+          else if (strcmp (long_options[option_index].name, "hpx-parcel-cachesize") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_parcel_cachesize_arg), 
+                 &(args_info->hpx_parcel_cachesize_orig), &(args_info->hpx_parcel_cachesize_given),
+                &(local_args_info.hpx_parcel_cachesize_given), optarg, 0, 0, ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "hpx-parcel-cachesize", '-',
+                additional_error))
+              goto failure;
+          
           }
           /* set coalescing buffer size.  */
           else if (strcmp (long_options[option_index].name, "hpx-coalescing-buffersize") == 0)
@@ -2802,6 +3230,34 @@ hpx_option_parser_internal (
                 additional_error))
               goto failure;
           
+          }
+          /* capacity of each coalesced parcel.  */
+          else if (strcmp (long_options[option_index].name, "hpx-coalescing-bytes") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_coalescing_bytes_arg), 
+                 &(args_info->hpx_coalescing_bytes_orig), &(args_info->hpx_coalescing_bytes_given),
+                &(local_args_info.hpx_coalescing_bytes_given), optarg, 0, 0, ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "hpx-coalescing-bytes", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* longest a parcel waits in a coalescing buffer.  */
+          else if (strcmp (long_options[option_index].name, "hpx-coalescing-timeout") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->hpx_coalescing_timeout_arg), 
+                 &(args_info->hpx_coalescing_timeout_orig), &(args_info->hpx_coalescing_timeout_given),
+                &(local_args_info.hpx_coalescing_timeout_given), optarg, 0, 0, ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "hpx-coalescing-timeout", '-',
+                additional_error))
+              goto failure;
+          
           }
           
           break;
@@ -39,9 +39,9 @@ extern "C" {
 #endif
 
 enum enum_hpx_gas { hpx_gas__NULL = -1, hpx_gas_arg_default = 0, hpx_gas_arg_smp, hpx_gas_arg_pgas, hpx_gas_arg_agas };
-enum enum_hpx_boot { hpx_boot__NULL = -1, hpx_boot_arg_default = 0, hpx_boot_arg_smp, hpx_boot_arg_mpi, hpx_boot_arg_pmi };
+enum enum_hpx_boot { hpx_boot__NULL = -1, hpx_boot_arg_default = 0, hpx_boot_arg_smp, hpx_boot_arg_mpi, hpx_boot_arg_pmi, hpx_boot_arg_fork };
 enum enum_hpx_transport { hpx_transport__NULL = -1, hpx_transport_arg_default = 0, hpx_transport_arg_mpi, hpx_transport_arg_photon };
-enum enum_hpx_network { hpx_network__NULL = -1, hpx_network_arg_default = 0, hpx_network_arg_smp, hpx_network_arg_pwc, hpx_network_arg_isir };
+enum enum_hpx_network { hpx_network__NULL = -1, hpx_network_arg_default = 0, hpx_network_arg_smp, hpx_network_arg_pwc, hpx_network_arg_isir, hpx_network_arg_shm };
 enum enum_hpx_thread_affinity { hpx_thread_affinity__NULL = -1, hpx_thread_affinity_arg_default = 0, hpx_thread_affinity_arg_hwthread, hpx_thread_affinity_arg_core, hpx_thread_affinity_arg_numa, hpx_thread_affinity_arg_none };
 enum enum_hpx_sched_policy { hpx_sched_policy__NULL = -1, hpx_sched_policy_arg_default = 0, hpx_sched_policy_arg_random, hpx_sched_policy_arg_hier };
 enum enum_hpx_gas_affinity { hpx_gas_affinity__NULL = -1, hpx_gas_affinity_arg_none = 0, hpx_gas_affinity_arg_urcu, hpx_gas_affinity_arg_cuckoo };
@@ -52,6 +52,7 @@ enum enum_hpx_trace_classes { hpx_trace_classes__NULL = -1, hpx_trace_classes_ar
 enum enum_hpx_photon_comporder { hpx_photon_comporder__NULL = -1, hpx_photon_comporder_arg_default = 0, hpx_photon_comporder_arg_none, hpx_photon_comporder_arg_strict };
 enum enum_hpx_photon_backend { hpx_photon_backend__NULL = -1, hpx_photon_backend_arg_default = 0, hpx_photon_backend_arg_verbs, hpx_photon_backend_arg_ugni, hpx_photon_backend_arg_fi };
 enum enum_hpx_photon_coll { hpx_photon_coll__NULL = -1, hpx_photon_coll_arg_default = 0, hpx_photon_coll_arg_pwc, hpx_photon_coll_arg_nbc };
+enum enum_hpx_gas_numa { hpx_gas_numa__NULL = -1, hpx_gas_numa_arg_none = 0, hpx_gas_numa_arg_interleave, hpx_gas_numa_arg_local, hpx_gas_numa_arg_block };
 
 /** @brief Where the command line options are stored */
 struct hpx_options_t
@@ -69,6 +70,9 @@ struct hpx_options_t
   enum enum_hpx_boot hpx_boot_arg;	/**< @brief HPX bootstrap method to use.  */
   char * hpx_boot_orig;	/**< @brief HPX bootstrap method to use original value given at command line.  */
   const char *hpx_boot_help; /**< @brief HPX bootstrap method to use help description.  */
+  int hpx_boot_ranks_arg;	/**< @brief number of localities to start with --hpx-boot=fork.  */
+  char * hpx_boot_ranks_orig;	/**< @brief number of localities to start with --hpx-boot=fork original value given at command line.  */
+  const char *hpx_boot_ranks_help; /**< @brief number of localities to start with --hpx-boot=fork help description.  */
   enum enum_hpx_transport hpx_transport_arg;	/**< @brief type of transport to use.  */
   char * hpx_transport_orig;	/**< @brief type of transport to use original value given at command line.  */
   const char *hpx_transport_help; /**< @brief type of transport to use help description.  */
@@ -96,12 +100,37 @@ struct hpx_options_t
   int hpx_sched_stackcachelimit_arg;	/**< @brief bound on the number of stacks to cache.  */
   char * hpx_sched_stackcachelimit_orig;	/**< @brief bound on the number of stacks to cache original value given at command line.  */
   const char *hpx_sched_stackcachelimit_help; /**< @brief bound on the number of stacks to cache help description.  */
+  int hpx_sched_spinbudget_arg;	/**< @brief empty schedule iterations before an idle worker parks, -1 to never park.  */
+  char * hpx_sched_spinbudget_orig;	/**< @brief empty schedule iterations before an idle worker parks, -1 to never park original value given at command line.  */
+  const char *hpx_sched_spinbudget_help; /**< @brief empty schedule iterations before an idle worker parks, -1 to never park help description.  */
+  long hpx_sched_parkperiod_arg;	/**< @brief bound on how long a parked worker sleeps before polling again.  */
+  char * hpx_sched_parkperiod_orig;	/**< @brief bound on how long a parked worker sleeps before polling again original value given at command line.  */
+  const char *hpx_sched_parkperiod_help; /**< @brief bound on how long a parked worker sleeps before polling again help description.  */
+  int hpx_sched_wakefanout_arg;	/**< @brief number of parked workers to wake when new work is spawned.  */
+  char * hpx_sched_wakefanout_orig;	/**< @brief number of parked workers to wake when new work is spawned original value given at command line.  */
+  const char *hpx_sched_wakefanout_help; /**< @brief number of parked workers to wake when new work is spawned help description.  */
+  int hpx_sched_elastic_flag;	/**< @brief grow and shrink the number of running workers with the load (default=off).  */
+  const char *hpx_sched_elastic_help; /**< @brief grow and shrink the number of running workers with the load help description.  */
   long hpx_progress_period_arg;	/**< @brief async network progess period.  */
   char * hpx_progress_period_orig;	/**< @brief async network progess period original value given at command line.  */
   const char *hpx_progress_period_help; /**< @brief async network progess period help description.  */
+  int hpx_progress_thread_flag;	/**< @brief drive the network from a dedicated progress thread instead of the workers (default=off).  */
+  const char *hpx_progress_thread_help; /**< @brief drive the network from a dedicated progress thread instead of the workers help description.  */
+  int hpx_progress_cpu_arg;	/**< @brief cpu to bind the progress thread to (-1 to leave it unbound).  */
+  char * hpx_progress_cpu_orig;	/**< @brief cpu to bind the progress thread to (-1 to leave it unbound) original value given at command line.  */
+  const char *hpx_progress_cpu_help; /**< @brief cpu to bind the progress thread to (-1 to leave it unbound) help description.  */
+  long hpx_network_chunksize_arg;	/**< @brief split parcel-based memget and memput larger than this into pipelined chunks (0 to disable).  */
+  char * hpx_network_chunksize_orig;	/**< @brief split parcel-based memget and memput larger than this into pipelined chunks (0 to disable) original value given at command line.  */
+  const char *hpx_network_chunksize_help; /**< @brief split parcel-based memget and memput larger than this into pipelined chunks (0 to disable) help description.  */
+  int hpx_network_chunkwindow_arg;	/**< @brief number of memget or memput chunks in flight at once.  */
+  char * hpx_network_chunkwindow_orig;	/**< @brief number of memget or memput chunks in flight at once original value given at command line.  */
+  const char *hpx_network_chunkwindow_help; /**< @brief number of memget or memput chunks in flight at once help description.  */
   enum enum_hpx_gas_affinity hpx_gas_affinity_arg;	/**< @brief GAS affinity implementation.  */
   char * hpx_gas_affinity_orig;	/**< @brief GAS affinity implementation original value given at command line.  */
   const char *hpx_gas_affinity_help; /**< @brief GAS affinity implementation help description.  */
+  enum enum_hpx_gas_numa hpx_gas_numa_arg;	/**< @brief NUMA placement policy for the global heap.  */
+  char * hpx_gas_numa_orig;	/**< @brief NUMA placement policy for the global heap original value given at command line.  */
+  const char *hpx_gas_numa_help; /**< @brief NUMA placement policy for the global heap help description.  */
   int* hpx_log_at_arg;	/**< @brief filter by locality, -1 for all (default none).  */
   char ** hpx_log_at_orig;	/**< @brief filter by locality, -1 for all (default none) original value given at command line.  */
   unsigned int hpx_log_at_min; /**< @brief filter by locality, -1 for all (default none)'s minimum occurreces */
@@ -158,6 +187,23 @@ struct hpx_options_t
   long hpx_isir_recvlimit_arg;	/**< @brief ISIR network recv limit.  */
   char * hpx_isir_recvlimit_orig;	/**< @brief ISIR network recv limit original value given at command line.  */
   const char *hpx_isir_recvlimit_help; /**< @brief ISIR network recv limit help description.  */
+  int hpx_isir_threaded_flag;	/**< @brief use MPI_THREAD_MULTIPLE and let workers drive the network concurrently (default=off).  */
+  const char *hpx_isir_threaded_help; /**< @brief use MPI_THREAD_MULTIPLE and let workers drive the network concurrently help description.  */
+  long hpx_isir_lanes_arg;	/**< @brief number of independent ISIR lanes in threaded mode, ranks use the smallest value (0 for one per worker).  */
+  char * hpx_isir_lanes_orig;	/**< @brief number of independent ISIR lanes in threaded mode, ranks use the smallest value (0 for one per worker) original value given at command line.  */
+  const char *hpx_isir_lanes_help; /**< @brief number of independent ISIR lanes in threaded mode, ranks use the smallest value (0 for one per worker) help description.  */
+  long hpx_isir_eagerring_arg;	/**< @brief number of preposted ISIR eager receive buffers (0 to probe for every message).  */
+  char * hpx_isir_eagerring_orig;	/**< @brief number of preposted ISIR eager receive buffers (0 to probe for every message) original value given at command line.  */
+  const char *hpx_isir_eagerring_help; /**< @brief number of preposted ISIR eager receive buffers (0 to probe for every message) help description.  */
+  long hpx_isir_eagersize_arg;	/**< @brief largest ISIR message that is received through the eager ring.  */
+  char * hpx_isir_eagersize_orig;	/**< @brief largest ISIR message that is received through the eager ring original value given at command line.  */
+  const char *hpx_isir_eagersize_help; /**< @brief largest ISIR message that is received through the eager ring help description.  */
+  long hpx_isir_credits_arg;	/**< @brief number of queued ISIR sends to each peer per lane, lightweight threads wait for the window (0 for unlimited).  */
+  char * hpx_isir_credits_orig;	/**< @brief number of queued ISIR sends to each peer per lane, lightweight threads wait for the window (0 for unlimited) original value given at command line.  */
+  const char *hpx_isir_credits_help; /**< @brief number of queued ISIR sends to each peer per lane, lightweight threads wait for the window (0 for unlimited) help description.  */
+  long hpx_shm_ringsize_arg;	/**< @brief size of the parcel ring between each pair of localities.  */
+  char * hpx_shm_ringsize_orig;	/**< @brief size of the parcel ring between each pair of localities original value given at command line.  */
+  const char *hpx_shm_ringsize_help; /**< @brief size of the parcel ring between each pair of localities help description.  */
   long hpx_pwc_parcelbuffersize_arg;	/**< @brief set the size of p2p recv buffers for parcel sends.  */
   char * hpx_pwc_parcelbuffersize_orig;	/**< @brief set the size of p2p recv buffers for parcel sends original value given at command line.  */
   const char *hpx_pwc_parcelbuffersize_help; /**< @brief set the size of p2p recv buffers for parcel sends help description.  */
@@ -227,15 +273,31 @@ struct hpx_options_t
   const char *hpx_opt_smp_help; /**< @brief optimize for SMP execution help description.  */
   int hpx_parcel_compression_flag;	/**< @brief enable parcel compression (default=off).  */
   const char *hpx_parcel_compression_help; /**< @brief enable parcel compression help description.  */
+  long hpx_parcel_compression_minsize_arg;	/**< @brief smallest parcel that compression is tried on.  */
+  char * hpx_parcel_compression_minsize_orig;	/**< @brief smallest parcel that compression is tried on original value given at command line.  */
+  const char *hpx_parcel_compression_minsize_help; /**< @brief smallest parcel that compression is tried on help description.  */
+  int hpx_parcel_compression_ratio_arg;	/**< @brief largest compressed size, as a percentage of the original, that is worth sending.  */
+  char * hpx_parcel_compression_ratio_orig;	/**< @brief largest compressed size, as a percentage of the original, that is worth sending original value given at command line.  */
+  const char *hpx_parcel_compression_ratio_help; /**< @brief largest compressed size, as a percentage of the original, that is worth sending help description.  */
+  long hpx_parcel_cachesize_arg;	/**< @brief registered memory reserved for the per-worker parcel caches.  */
+  char * hpx_parcel_cachesize_orig;	/**< @brief registered memory reserved for the per-worker parcel caches original value given at command line.  */
+  const char *hpx_parcel_cachesize_help; /**< @brief registered memory reserved for the per-worker parcel caches help description.  */
   long hpx_coalescing_buffersize_arg;	/**< @brief set coalescing buffer size.  */
   char * hpx_coalescing_buffersize_orig;	/**< @brief set coalescing buffer size original value given at command line.  */
   const char *hpx_coalescing_buffersize_help; /**< @brief set coalescing buffer size help description.  */
+  long hpx_coalescing_bytes_arg;	/**< @brief capacity of each coalesced parcel.  */
+  char * hpx_coalescing_bytes_orig;	/**< @brief capacity of each coalesced parcel original value given at command line.  */
+  const char *hpx_coalescing_bytes_help; /**< @brief capacity of each coalesced parcel help description.  */
+  long hpx_coalescing_timeout_arg;	/**< @brief longest a parcel waits in a coalescing buffer.  */
+  char * hpx_coalescing_timeout_orig;	/**< @brief longest a parcel waits in a coalescing buffer original value given at command line.  */
+  const char *hpx_coalescing_timeout_help; /**< @brief longest a parcel waits in a coalescing buffer help description.  */
   
   unsigned int hpx_help_given ;	/**< @brief Whether hpx-help was given.  */
   unsigned int hpx_version_given ;	/**< @brief Whether hpx-version was given.  */
   unsigned int hpx_heapsize_given ;	/**< @brief Whether hpx-heapsize was given.  */
   unsigned int hpx_gas_given ;	/**< @brief Whether hpx-gas was given.  */
   unsigned int hpx_boot_given ;	/**< @brief Whether hpx-boot was given.  */
+  unsigned int hpx_boot_ranks_given ;	/**< @brief Whether hpx-boot-ranks was given.  */
   unsigned int hpx_transport_given ;	/**< @brief Whether hpx-transport was given.  */
   unsigned int hpx_network_given ;	/**< @brief Whether hpx-network was given.  */
   unsigned int hpx_configfile_given ;	/**< @brief Whether hpx-configfile was given.  */
@@ -245,8 +307,17 @@ struct hpx_options_t
   unsigned int hpx_sched_policy_given ;	/**< @brief Whether hpx-sched-policy was given.  */
   unsigned int hpx_sched_wfthreshold_given ;	/**< @brief Whether hpx-sched-wfthreshold was given.  */
   unsigned int hpx_sched_stackcachelimit_given ;	/**< @brief Whether hpx-sched-stackcachelimit was given.  */
+  unsigned int hpx_sched_spinbudget_given ;	/**< @brief Whether hpx-sched-spinbudget was given.  */
+  unsigned int hpx_sched_parkperiod_given ;	/**< @brief Whether hpx-sched-parkperiod was given.  */
+  unsigned int hpx_sched_wakefanout_given ;	/**< @brief Whether hpx-sched-wakefanout was given.  */
+  unsigned int hpx_sched_elastic_given ;	/**< @brief Whether hpx-sched-elastic was given.  */
   unsigned int hpx_progress_period_given ;	/**< @brief Whether hpx-progress-period was given.  */
+  unsigned int hpx_progress_thread_given ;	/**< @brief Whether hpx-progress-thread was given.  */
+  unsigned int hpx_progress_cpu_given ;	/**< @brief Whether hpx-progress-cpu was given.  */
+  unsigned int hpx_network_chunksize_given ;	/**< @brief Whether hpx-network-chunksize was given.  */
+  unsigned int hpx_network_chunkwindow_given ;	/**< @brief Whether hpx-network-chunkwindow was given.  */
   unsigned int hpx_gas_affinity_given ;	/**< @brief Whether hpx-gas-affinity was given.  */
+  unsigned int hpx_gas_numa_given ;	/**< @brief Whether hpx-gas-numa was given.  */
   unsigned int hpx_log_at_given ;	/**< @brief Whether hpx-log-at was given.  */
   unsigned int hpx_log_level_given ;	/**< @brief Whether hpx-log-level was given.  */
   unsigned int hpx_dbg_waitat_given ;	/**< @brief Whether hpx-dbg-waitat was given.  */
@@ -263,6 +334,12 @@ struct hpx_options_t
   unsigned int hpx_isir_testwindow_given ;	/**< @brief Whether hpx-isir-testwindow was given.  */
   unsigned int hpx_isir_sendlimit_given ;	/**< @brief Whether hpx-isir-sendlimit was given.  */
   unsigned int hpx_isir_recvlimit_given ;	/**< @brief Whether hpx-isir-recvlimit was given.  */
+  unsigned int hpx_isir_threaded_given ;	/**< @brief Whether hpx-isir-threaded was given.  */
+  unsigned int hpx_isir_lanes_given ;	/**< @brief Whether hpx-isir-lanes was given.  */
+  unsigned int hpx_isir_eagerring_given ;	/**< @brief Whether hpx-isir-eagerring was given.  */
+  unsigned int hpx_isir_eagersize_given ;	/**< @brief Whether hpx-isir-eagersize was given.  */
+  unsigned int hpx_isir_credits_given ;	/**< @brief Whether hpx-isir-credits was given.  */
+  unsigned int hpx_shm_ringsize_given ;	/**< @brief Whether hpx-shm-ringsize was given.  */
   unsigned int hpx_pwc_parcelbuffersize_given ;	/**< @brief Whether hpx-pwc-parcelbuffersize was given.  */
   unsigned int hpx_pwc_parceleagerlimit_given ;	/**< @brief Whether hpx-pwc-parceleagerlimit was given.  */
   unsigned int hpx_coll_network_given ;	/**< @brief Whether hpx-coll-network was given.  */
@@ -287,7 +364,12 @@ struct hpx_options_t
   unsigned int hpx_photon_usercq_given ;	/**< @brief Whether hpx-photon-usercq was given.  */
   unsigned int hpx_opt_smp_given ;	/**< @brief Whether hpx-opt-smp was given.  */
   unsigned int hpx_parcel_compression_given ;	/**< @brief Whether hpx-parcel-compression was given.  */
+  unsigned int hpx_parcel_compression_minsize_given ;	/**< @brief Whether hpx-parcel-compression-minsize was given.  */
+  unsigned int hpx_parcel_compression_ratio_given ;	/**< @brief Whether hpx-parcel-compression-ratio was given.  */
+  unsigned int hpx_parcel_cachesize_given ;	/**< @brief Whether hpx-parcel-cachesize was given.  */
   unsigned int hpx_coalescing_buffersize_given ;	/**< @brief Whether hpx-coalescing-buffersize was given.  */
+  unsigned int hpx_coalescing_bytes_given ;	/**< @brief Whether hpx-coalescing-bytes was given.  */
+  unsigned int hpx_coalescing_timeout_given ;	/**< @brief Whether hpx-coalescing-timeout was given.  */
 
 } ;
 
@@ -489,6 +571,7 @@ extern const char *hpx_option_parser_hpx_trace_classes_values[];  /**< @brief Po
 extern const char *hpx_option_parser_hpx_photon_comporder_values[];  /**< @brief Possible values for hpx-photon-comporder. */
 extern const char *hpx_option_parser_hpx_photon_backend_values[];  /**< @brief Possible values for hpx-photon-backend. */
 extern const char *hpx_option_parser_hpx_photon_coll_values[];  /**< @brief Possible values for hpx-photon-coll. */
+extern const char *hpx_option_parser_hpx_gas_numa_values[];  /**< @brief Possible values for hpx-gas-numa. */
 
 
 #ifdef __cplusplus
@@ -0,0 +1,125 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+/// Measure the aggregate cyclic allocation rate when every worker allocates.
+///
+/// Every worker on every locality concurrently allocates and frees cyclic
+/// arrays, so the rate depends on how well cyclic allocation scales with the
+/// number of localities and workers, rather than on a single allocator.
+
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <hpx/hpx.h>
+
+#define BENCHMARK "HPX CONCURRENT CYCLIC ALLOCATION RATE"
+
+#define HEADER "# " BENCHMARK "\n"
+#define FIELD_WIDTH 16
+
+static void _usage(FILE *f, int error) {
+  fprintf(f, "Usage: cyclic_alloc [options] [ALLOCATIONS]\n"
+          "\t-s, largest block size in bytes (65536)\n"
+          "\t-h, show help\n");
+  hpx_print_help();
+  fflush(f);
+  exit(error);
+}
+
+static int _allocator_handler(int n, size_t bsize) {
+  for (int i = 0; i < n; ++i) {
+    hpx_addr_t gva = hpx_gas_alloc_cyclic(HPX_LOCALITIES, bsize, 0);
+    if (gva == HPX_NULL) {
+      fprintf(stderr, "failed to allocate %zu-byte cyclic blocks\n", bsize);
+      return HPX_ERROR;
+    }
+    hpx_gas_free_sync(gva);
+  }
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _allocator, _allocator_handler, HPX_INT,
+                  HPX_SIZE_T);
+
+static int _allocators_handler(int n, size_t bsize) {
+  hpx_addr_t done = hpx_lco_and_new(HPX_THREADS);
+  for (int i = 0; i < HPX_THREADS; ++i) {
+    hpx_call(HPX_HERE, _allocator, done, &n, &bsize);
+  }
+  hpx_lco_wait(done);
+  hpx_lco_delete_sync(done);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _allocators, _allocators_handler, HPX_INT,
+                  HPX_SIZE_T);
+
+static int _main_handler(int n, size_t max) {
+  fprintf(stdout, HEADER);
+  fprintf(stdout, "# %d localities, %d workers, %d allocations per worker\n",
+          HPX_LOCALITIES, HPX_THREADS, n);
+  fprintf(stdout, "%-*s%*s\n", FIELD_WIDTH, "# bsize", FIELD_WIDTH,
+          "allocs/s");
+
+  for (size_t bsize = 8; bsize <= max; bsize *= 8) {
+    int total = n * HPX_THREADS * HPX_LOCALITIES;
+    hpx_time_t t = hpx_time_now();
+    if (hpx_bcast_rsync(_allocators, &n, &bsize)) {
+      hpx_abort();
+    }
+    double s = hpx_time_elapsed_ms(t) / 1e3;
+    fprintf(stdout, "%-*zu%*.0f\n", FIELD_WIDTH, bsize, FIELD_WIDTH, total / s);
+  }
+
+  hpx_exit(0, NULL);
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _main, _main_handler, HPX_INT, HPX_SIZE_T);
+
+int main(int argc, char *argv[]) {
+  int e = hpx_init(&argc, &argv);
+  if (e) {
+    fprintf(stderr, "HPX: failed to initialize.\n");
+    return e;
+  }
+
+  size_t max = 65536;
+  int opt = 0;
+  while ((opt = getopt(argc, argv, "s:h?")) != -1) {
+    switch (opt) {
+     case 's':
+       max = strtoul(optarg, NULL, 0);
+       break;
+     case 'h':
+       _usage(stdout, EXIT_SUCCESS);
+     case '?':
+     default:
+       _usage(stderr, EXIT_FAILURE);
+    }
+  }
+
+  argc -= optind;
+  argv += optind;
+
+  int n = 1000;
+  switch (argc) {
+   case 0:
+     break;
+   default:
+     _usage(stderr, EXIT_FAILURE);
+   case 1:
+     n = atoi(argv[0]);
+     break;
+  }
+
+  e = hpx_run(&_main, NULL, &n, &max);
+  hpx_finalize();
+  return e;
+}
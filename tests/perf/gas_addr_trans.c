@@ -19,12 +19,15 @@
 
 static void _usage(FILE *stream) {
   fprintf(stream, "Usage: time_gas_addr_trans [options]\n"
+          "\t-a, measure pin scaling on one hot block (use with --hpx-gas=agas)\n"
           "\t-h, this help display\n");
   hpx_print_help();
   fflush(stream);
 }
 
 static hpx_action_t _address_translation = 0;
+static hpx_action_t _pin_loop = 0;
+static hpx_action_t _hot = 0;
 static hpx_action_t _main = 0;
 
 #define BENCHMARK "HPX COST OF GAS ADDRESS TRANSLATION (ms)"
@@ -33,6 +36,7 @@ static hpx_action_t _main = 0;
 
 #define TEST_BUF_SIZE (1024*64) //64k
 #define FIELD_WIDTH 20
+#define HOT_PINS 1000000
 
 static int num[] = {
   10000,
@@ -59,6 +63,43 @@ static int _address_translation_action(void) {
   return hpx_thread_continue(NULL, 0);
 }
 
+static int _pin_loop_action(hpx_addr_t block, int n) {
+  for (int i = 0; i < n; ++i) {
+    int *data = NULL;
+    if (!hpx_gas_try_pin(block, (void **)&data)) {
+      return HPX_ERROR;
+    }
+    hpx_gas_unpin(block);
+  }
+  return HPX_SUCCESS;
+}
+
+// Every worker pins and unpins the same local block, which shows how the pin
+// path scales when a block is hot. Under AGAS this exercises the block
+// translation table rather than the PGAS address arithmetic.
+static int _hot_action(void) {
+  int n = HOT_PINS;
+  fprintf(stdout, "# HPX HOT BLOCK PIN SCALING\n");
+  fprintf(stdout, "%s%*s%*s\n", "# Pinners ", FIELD_WIDTH, "TIME (s)",
+          FIELD_WIDTH, "PINS/S");
+
+  hpx_addr_t block = hpx_gas_alloc_local(1, TEST_BUF_SIZE, 0);
+  for (int t = 1; t <= HPX_THREADS; t *= 2) {
+    hpx_addr_t done = hpx_lco_and_new(t);
+    hpx_time_t now = hpx_time_now();
+    for (int j = 0; j < t; ++j) {
+      hpx_call(HPX_HERE, _pin_loop, done, &block, &n);
+    }
+    hpx_lco_wait(done);
+    double elapsed = hpx_time_elapsed_ms(now)/1e3;
+    fprintf(stdout, "%-10d%*.7f%*.0f\n", t, FIELD_WIDTH, elapsed,
+            FIELD_WIDTH, (double)t * n / elapsed);
+    hpx_lco_delete(done, HPX_NULL);
+  }
+  hpx_gas_free(block, HPX_NULL);
+  hpx_exit(0, NULL);
+}
+
 static int _main_action(void) {
   hpx_time_t now;
   double elapsed;
@@ -118,6 +159,9 @@ int
 main(int argc, char *argv[]) {
   // register the actions
   HPX_REGISTER_ACTION(HPX_DEFAULT, 0, _address_translation, _address_translation_action);
+  HPX_REGISTER_ACTION(HPX_DEFAULT, 0, _pin_loop, _pin_loop_action, HPX_ADDR,
+                      HPX_INT);
+  HPX_REGISTER_ACTION(HPX_DEFAULT, 0, _hot, _hot_action);
   HPX_REGISTER_ACTION(HPX_DEFAULT, 0, _main, _main_action);
 
   if (hpx_init(&argc, &argv)) {
@@ -125,9 +169,13 @@ main(int argc, char *argv[]) {
     return 1;
   }
 
+  hpx_action_t *action = &_main;
   int opt = 0;
-  while ((opt = getopt(argc, argv, "h?")) != -1) {
+  while ((opt = getopt(argc, argv, "ah?")) != -1) {
     switch (opt) {
+     case 'a':
+      action = &_hot;
+      break;
      case 'h':
       _usage(stdout);
       return 0;
@@ -139,7 +187,7 @@ main(int argc, char *argv[]) {
   }
 
   // run the main action
-  int e = hpx_run(&_main, NULL);
+  int e = hpx_run(action, NULL);
   hpx_finalize();
   return e;
 }
@@ -0,0 +1,165 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+/// Measure LCO round-trip latency while the workers are saturated.
+///
+/// Every worker is kept busy with a deep queue of compute parcels that
+/// continuously respawn themselves. A driver thread then repeatedly calls an
+/// empty action that sets a future and waits for it. The driver is run once
+/// as a normal action and once as an HPX_PRIORITY action, which lets both the
+/// ping and the resumed driver bypass the queued compute work.
+
+#include <float.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <hpx/hpx.h>
+
+#define BENCHMARK "HPX COST OF LCO ROUND TRIPS UNDER LOAD"
+
+#define HEADER "# " BENCHMARK "\n"
+#define FIELD_WIDTH 12
+
+static void _usage(FILE *f, int error) {
+  fprintf(f, "Usage: lco_latency [options] [ITERATIONS]\n"
+          "\t-d, compute parcels queued per worker (64)\n"
+          "\t-w, compute parcel duration in microseconds (10)\n"
+          "\t-h, show help\n");
+  hpx_print_help();
+  fflush(f);
+  exit(error);
+}
+
+static volatile int _stop = 0;
+static int _live = 0;
+
+static int _busy_handler(int us) {
+  hpx_time_t t = hpx_time_now();
+  while (hpx_time_elapsed_us(t) < us) {
+  }
+
+  if (_stop) {
+    __atomic_fetch_sub(&_live, 1, __ATOMIC_RELEASE);
+  }
+  else {
+    hpx_call(HPX_HERE, hpx_thread_current_action(), HPX_NULL, &us);
+  }
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _busy, _busy_handler, HPX_INT);
+
+static int _ping_handler(void) {
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _ping, _ping_handler);
+static HPX_ACTION(HPX_DEFAULT, HPX_PRIORITY, _ping_priority, _ping_handler);
+
+static hpx_action_t _driver_priority;
+
+static int _driver_handler(int n) {
+  int priority = (hpx_thread_current_action() == _driver_priority);
+  hpx_action_t ping = (priority) ? _ping_priority : _ping;
+
+  double min = DBL_MAX, max = 0, sum = 0;
+  for (int i = 0; i < n; ++i) {
+    hpx_addr_t done = hpx_lco_future_new(0);
+    hpx_time_t t = hpx_time_now();
+    hpx_call(HPX_HERE, ping, done);
+    hpx_lco_wait(done);
+    double us = hpx_time_elapsed_us(t);
+    hpx_lco_delete_sync(done);
+
+    min = (us < min) ? us : min;
+    max = (us > max) ? us : max;
+    sum += us;
+  }
+
+  fprintf(stdout, "%-*s%*.3f%*.3f%*.3f\n", FIELD_WIDTH,
+          (priority) ? "priority" : "normal", FIELD_WIDTH, min, FIELD_WIDTH,
+          sum / n, FIELD_WIDTH, max);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _driver, _driver_handler, HPX_INT);
+static HPX_ACTION(HPX_DEFAULT, HPX_PRIORITY, _driver_priority, _driver_handler,
+                  HPX_INT);
+
+static int _main_handler(int n, int depth, int us) {
+  fprintf(stdout, HEADER);
+  fprintf(stdout, "# %d compute parcels of %d us per worker, %d iterations\n",
+          depth, us, n);
+
+  _stop = 0;
+  _live = depth * HPX_THREADS;
+  for (int i = 0, e = depth * HPX_THREADS; i < e; ++i) {
+    hpx_call(HPX_HERE, _busy, HPX_NULL, &us);
+  }
+
+  fprintf(stdout, "%-*s%*s%*s%*s\n", FIELD_WIDTH, "# driver", FIELD_WIDTH,
+          "min (us)", FIELD_WIDTH, "avg (us)", FIELD_WIDTH, "max (us)");
+  hpx_call_sync(HPX_HERE, _driver, NULL, 0, &n);
+  hpx_call_sync(HPX_HERE, _driver_priority, NULL, 0, &n);
+
+  // drain the compute parcels before exiting
+  _stop = 1;
+  while (__atomic_load_n(&_live, __ATOMIC_ACQUIRE)) {
+    hpx_thread_yield();
+  }
+  hpx_exit(0, NULL);
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _main, _main_handler, HPX_INT, HPX_INT,
+                  HPX_INT);
+
+int main(int argc, char *argv[]) {
+  int e = hpx_init(&argc, &argv);
+  if (e) {
+    fprintf(stderr, "HPX: failed to initialize.\n");
+    return e;
+  }
+
+  int depth = 64;
+  int us = 10;
+  int opt = 0;
+  while ((opt = getopt(argc, argv, "d:w:h?")) != -1) {
+    switch (opt) {
+     case 'd':
+       depth = atoi(optarg);
+       break;
+     case 'w':
+       us = atoi(optarg);
+       break;
+     case 'h':
+       _usage(stdout, EXIT_SUCCESS);
+     case '?':
+     default:
+       _usage(stderr, EXIT_FAILURE);
+    }
+  }
+
+  argc -= optind;
+  argv += optind;
+
+  int n = 1000;
+  switch (argc) {
+   case 0:
+     break;
+   default:
+     _usage(stderr, EXIT_FAILURE);
+   case 1:
+     n = atoi(argv[0]);
+     break;
+  }
+
+  e = hpx_run(&_main, NULL, &n, &depth, &us);
+  hpx_finalize();
+  return e;
+}
@@ -0,0 +1,142 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+/// Measure the throughput of many workers sending mail to a single worker.
+///
+/// A global block is given affinity to worker 0, and then every worker sends a
+/// stream of parcels to that block. Parcels targeting an address with affinity
+/// are routed through the target worker's mailbox, so this stresses the
+/// mailbox with many concurrent producers and a single consumer. This requires
+/// an --hpx-gas-affinity implementation other than "none", otherwise the
+/// parcels are scheduled locally and the mailbox is not exercised.
+
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <hpx/hpx.h>
+
+#define BENCHMARK "HPX MAILBOX CONTENTION"
+
+#define HEADER "# " BENCHMARK "\n"
+#define FIELD_WIDTH 20
+
+static void _usage(FILE *f, int error) {
+  fprintf(f, "Usage: mail_contention [options] [ITERATIONS]\n"
+          "\t-n, number of parcels sent by each producer (10000)\n"
+          "\t-h, show help\n");
+  hpx_print_help();
+  fflush(f);
+  exit(error);
+}
+
+typedef struct {
+  hpx_addr_t target;
+  hpx_addr_t done;
+  int n;
+} _args_t;
+
+static int _sink_handler(void) {
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_TASK, 0, _sink, _sink_handler);
+
+static int _producer(int i, void *env) {
+  const _args_t *args = env;
+  for (int j = 0; j < args->n; ++j) {
+    hpx_call(args->target, _sink, args->done);
+  }
+  return HPX_SUCCESS;
+}
+
+static int _main_handler(int iters, int n) {
+  int producers = HPX_THREADS;
+  if (producers < 2) {
+    printf("mail_contention requires at least 2 threads, skipping\n");
+    hpx_exit(0, NULL);
+  }
+
+  hpx_addr_t target = hpx_gas_alloc_local(1, sizeof(int), 0);
+  hpx_gas_set_affinity(target, 0);
+
+  fprintf(stdout, HEADER);
+  fprintf(stdout, "# %d producers, %d parcels each, %d iterations\n",
+          producers, n, iters);
+  fprintf(stdout, "%-*s%*s\n", FIELD_WIDTH, "# time (ms)", FIELD_WIDTH,
+          "parcels/us");
+
+  double total = 0;
+  for (int i = 0; i < iters; ++i) {
+    _args_t args = {
+      .target = target,
+      .done = hpx_lco_and_new(producers * n),
+      .n = n
+    };
+
+    hpx_time_t start = hpx_time_now();
+    hpx_par_for_sync(_producer, 0, producers, &args);
+    hpx_lco_wait(args.done);
+    double us = hpx_time_elapsed_us(start);
+    total += us;
+    hpx_lco_delete_sync(args.done);
+  }
+
+  double avg = total / iters;
+  fprintf(stdout, "%-*.3f%*.3f\n", FIELD_WIDTH, avg / 1e3, FIELD_WIDTH,
+          (producers * n) / avg);
+
+  hpx_gas_clear_affinity(target);
+  hpx_gas_free_sync(target);
+  hpx_exit(0, NULL);
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _main, _main_handler, HPX_INT, HPX_INT);
+
+int main(int argc, char *argv[]) {
+  int e = hpx_init(&argc, &argv);
+  if (e) {
+    fprintf(stderr, "HPX: failed to initialize.\n");
+    return e;
+  }
+
+  int n = 10000;
+  int opt = 0;
+  while ((opt = getopt(argc, argv, "n:h?")) != -1) {
+    switch (opt) {
+     case 'n':
+       n = atoi(optarg);
+       break;
+     case 'h':
+       _usage(stdout, EXIT_SUCCESS);
+     case '?':
+     default:
+       _usage(stderr, EXIT_FAILURE);
+    }
+  }
+
+  argc -= optind;
+  argv += optind;
+
+  int iters = 10;
+  switch (argc) {
+   case 0:
+     break;
+   default:
+     _usage(stderr, EXIT_FAILURE);
+   case 1:
+     iters = atoi(argv[0]);
+     break;
+  }
+
+  e = hpx_run(&_main, NULL, &iters, &n);
+  hpx_finalize();
+  return e;
+}
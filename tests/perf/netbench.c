@@ -0,0 +1,132 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+/// Measure the aggregate parcel rate when every worker is sending.
+///
+/// Every worker on every locality concurrently sends parcels to the next
+/// locality, so the rate depends on how well send injection and completion
+/// scale with the number of workers. Run it once with the default network and
+/// once with --hpx-isir-threaded to compare the funneled and threaded ISIR
+/// networks.
+
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <hpx/hpx.h>
+
+#define BENCHMARK "HPX AGGREGATE PARCEL RATE"
+
+#define HEADER "# " BENCHMARK "\n"
+#define FIELD_WIDTH 16
+
+static void _usage(FILE *f, int error) {
+  fprintf(f, "Usage: netbench [options] [PARCELS]\n"
+          "\t-s, largest payload size in bytes (32768)\n"
+          "\t-h, show help\n");
+  hpx_print_help();
+  fflush(f);
+  exit(error);
+}
+
+static int _sink_handler(void *args, size_t n) {
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, HPX_MARSHALLED, _sink, _sink_handler,
+                  HPX_POINTER, HPX_SIZE_T);
+
+static int _sender_handler(int n, size_t bytes, hpx_addr_t done) {
+  hpx_addr_t to = HPX_THERE((HPX_LOCALITY_ID + 1) % HPX_LOCALITIES);
+  char *buffer = calloc(1, bytes);
+  for (int i = 0; i < n; ++i) {
+    hpx_call(to, _sink, done, buffer, bytes);
+  }
+  free(buffer);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _sender, _sender_handler, HPX_INT,
+                  HPX_SIZE_T, HPX_ADDR);
+
+static int _senders_handler(int n, size_t bytes, hpx_addr_t done) {
+  for (int i = 0; i < HPX_THREADS; ++i) {
+    hpx_call(HPX_HERE, _sender, HPX_NULL, &n, &bytes, &done);
+  }
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _senders, _senders_handler, HPX_INT,
+                  HPX_SIZE_T, HPX_ADDR);
+
+static int _main_handler(int n, size_t max) {
+  fprintf(stdout, HEADER);
+  fprintf(stdout, "# %d localities, %d workers, %d parcels per worker\n",
+          HPX_LOCALITIES, HPX_THREADS, n);
+  fprintf(stdout, "%-*s%*s%*s\n", FIELD_WIDTH, "# bytes", FIELD_WIDTH,
+          "parcels/s", FIELD_WIDTH, "MB/s");
+
+  for (size_t bytes = 8; bytes <= max; bytes *= 8) {
+    int total = n * HPX_THREADS * HPX_LOCALITIES;
+    hpx_addr_t done = hpx_lco_and_new(total);
+    hpx_time_t t = hpx_time_now();
+    hpx_bcast(_senders, HPX_NULL, HPX_NULL, &n, &bytes, &done);
+    hpx_lco_wait(done);
+    double s = hpx_time_elapsed_ms(t) / 1e3;
+    hpx_lco_delete_sync(done);
+
+    fprintf(stdout, "%-*zu%*.0f%*.2f\n", FIELD_WIDTH, bytes, FIELD_WIDTH,
+            total / s, FIELD_WIDTH, total * bytes / s / 1e6);
+  }
+
+  hpx_exit(0, NULL);
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _main, _main_handler, HPX_INT, HPX_SIZE_T);
+
+int main(int argc, char *argv[]) {
+  int e = hpx_init(&argc, &argv);
+  if (e) {
+    fprintf(stderr, "HPX: failed to initialize.\n");
+    return e;
+  }
+
+  size_t max = 32768;
+  int opt = 0;
+  while ((opt = getopt(argc, argv, "s:h?")) != -1) {
+    switch (opt) {
+     case 's':
+       max = strtoul(optarg, NULL, 0);
+       break;
+     case 'h':
+       _usage(stdout, EXIT_SUCCESS);
+     case '?':
+     default:
+       _usage(stderr, EXIT_FAILURE);
+    }
+  }
+
+  argc -= optind;
+  argv += optind;
+
+  int n = 10000;
+  switch (argc) {
+   case 0:
+     break;
+   default:
+     _usage(stderr, EXIT_FAILURE);
+   case 1:
+     n = atoi(argv[0]);
+     break;
+  }
+
+  e = hpx_run(&_main, NULL, &n, &max);
+  hpx_finalize();
+  return e;
+}
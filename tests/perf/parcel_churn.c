@@ -0,0 +1,133 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+/// Measure the cost of parcel allocation and deletion.
+///
+/// For a range of payload sizes this measures back-to-back acquire/release
+/// pairs, and batches where a window of parcels is acquired before any of them
+/// are released. Run with --hpx-parcel-cachesize=0 to compare against the
+/// registered allocator.
+
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <hpx/hpx.h>
+
+#define BENCHMARK "HPX COST OF PARCEL ALLOCATION AND DELETION"
+
+#define HEADER "# " BENCHMARK "\n"
+#define FIELD_WIDTH 16
+
+static const size_t _sizes[] = {
+  0, 8, 64, 192, 448, 960, 4096
+};
+
+static void _usage(FILE *f, int error) {
+  fprintf(f, "Usage: parcel_churn [options] [ITERATIONS]\n"
+          "\t-w, number of parcels in each batch (1024)\n"
+          "\t-h, show help\n");
+  hpx_print_help();
+  fflush(f);
+  exit(error);
+}
+
+static double _churn(size_t size, int iters) {
+  hpx_time_t start = hpx_time_now();
+  for (int i = 0; i < iters; ++i) {
+    hpx_parcel_t *p = hpx_parcel_acquire(NULL, size);
+    hpx_parcel_release(p);
+  }
+  return hpx_time_elapsed_ns(start) / (double)iters;
+}
+
+static double _batch(size_t size, int iters, int window, hpx_parcel_t **ps) {
+  int n = (iters + window - 1) / window;
+  hpx_time_t start = hpx_time_now();
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < window; ++j) {
+      ps[j] = hpx_parcel_acquire(NULL, size);
+    }
+    for (int j = 0; j < window; ++j) {
+      hpx_parcel_release(ps[j]);
+    }
+  }
+  return hpx_time_elapsed_ns(start) / ((double)n * window);
+}
+
+static int _main_handler(int iters, int window) {
+  hpx_parcel_t **ps = calloc(window, sizeof(*ps));
+  if (!ps) {
+    fprintf(stderr, "failed to allocate the batch window\n");
+    hpx_exit(-1, NULL);
+  }
+
+  fprintf(stdout, HEADER);
+  fprintf(stdout, "# %d iterations, batches of %d\n", iters, window);
+  fprintf(stdout, "%-*s%*s%*s\n", FIELD_WIDTH, "# payload (B)", FIELD_WIDTH,
+          "churn (ns)", FIELD_WIDTH, "batch (ns)");
+
+  for (int i = 0, e = sizeof(_sizes) / sizeof(_sizes[0]); i < e; ++i) {
+    size_t size = _sizes[i];
+    // warm up
+    _batch(size, window, window, ps);
+    double churn = _churn(size, iters);
+    double batch = _batch(size, iters, window, ps);
+    fprintf(stdout, "%-*zu%*.2f%*.2f\n", FIELD_WIDTH, size, FIELD_WIDTH, churn,
+            FIELD_WIDTH, batch);
+  }
+
+  free(ps);
+  hpx_exit(0, NULL);
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _main, _main_handler, HPX_INT, HPX_INT);
+
+int main(int argc, char *argv[]) {
+  int e = hpx_init(&argc, &argv);
+  if (e) {
+    fprintf(stderr, "HPX: failed to initialize.\n");
+    return e;
+  }
+
+  int window = 1024;
+  int opt = 0;
+  while ((opt = getopt(argc, argv, "w:h?")) != -1) {
+    switch (opt) {
+     case 'w':
+       window = atoi(optarg);
+       break;
+     case 'h':
+       _usage(stdout, EXIT_SUCCESS);
+     case '?':
+     default:
+       _usage(stderr, EXIT_FAILURE);
+    }
+  }
+
+  argc -= optind;
+  argv += optind;
+
+  int iters = 1000000;
+  switch (argc) {
+   case 0:
+     break;
+   default:
+     _usage(stderr, EXIT_FAILURE);
+   case 1:
+     iters = atoi(argv[0]);
+     break;
+  }
+
+  e = hpx_run(&_main, NULL, &iters, &window);
+  hpx_finalize();
+  return e;
+}
@@ -0,0 +1,128 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+/// Measure the latency of waking an idle worker.
+///
+/// The main thread stays busy for a quiet period so that the rest of the
+/// workers run out of work and (depending on --hpx-sched-spinbudget) park. It
+/// then spawns a parcel and spins without yielding until some other worker
+/// steals and runs it. Compare a parking run with a polling run that uses
+/// --hpx-sched-spinbudget=-1.
+
+#include <float.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <hpx/hpx.h>
+
+#define BENCHMARK "HPX COST OF WAKING AN IDLE WORKER"
+
+#define HEADER "# " BENCHMARK "\n"
+#define FIELD_WIDTH 12
+
+static void _usage(FILE *f, int error) {
+  fprintf(f, "Usage: sched_wake [options] [ITERATIONS]\n"
+          "\t-q, quiet period before each wakeup in microseconds (1000)\n"
+          "\t-h, show help\n");
+  hpx_print_help();
+  fflush(f);
+  exit(error);
+}
+
+static hpx_action_t _wake = 0;
+static hpx_action_t _main = 0;
+
+static int _wake_handler(int *flag) {
+  __atomic_store_n(flag, 1, __ATOMIC_RELEASE);
+  return HPX_SUCCESS;
+}
+
+static int _main_handler(int n, int quiet) {
+  if (HPX_THREADS < 2) {
+    printf("sched_wake requires at least 2 threads, skipping\n");
+    hpx_exit(0, NULL);
+  }
+
+  fprintf(stdout, HEADER);
+  fprintf(stdout, "# quiet period %d us, %d iterations\n", quiet, n);
+
+  double min = DBL_MAX, max = 0, sum = 0;
+  for (int i = 0; i < n; ++i) {
+    // stay busy so that the other workers go idle
+    hpx_time_t t = hpx_time_now();
+    while (hpx_time_elapsed_us(t) < quiet) {
+    }
+
+    int flag = 0;
+    int *addr = &flag;
+    t = hpx_time_now();
+    hpx_call(HPX_HERE, _wake, HPX_NULL, &addr);
+    while (!__atomic_load_n(&flag, __ATOMIC_ACQUIRE)) {
+    }
+    double us = hpx_time_elapsed_us(t);
+
+    min = (us < min) ? us : min;
+    max = (us > max) ? us : max;
+    sum += us;
+  }
+
+  fprintf(stdout, "%-*s%*s%*s\n", FIELD_WIDTH, "# min (us)", FIELD_WIDTH,
+          "avg (us)", FIELD_WIDTH, "max (us)");
+  fprintf(stdout, "%-*.3f%*.3f%*.3f\n", FIELD_WIDTH, min, FIELD_WIDTH, sum / n,
+          FIELD_WIDTH, max);
+  hpx_exit(0, NULL);
+}
+
+int main(int argc, char *argv[]) {
+  HPX_REGISTER_ACTION(HPX_DEFAULT, 0, _wake, _wake_handler, HPX_POINTER);
+  HPX_REGISTER_ACTION(HPX_DEFAULT, 0, _main, _main_handler, HPX_INT, HPX_INT);
+
+  int e = hpx_init(&argc, &argv);
+  if (e) {
+    fprintf(stderr, "HPX: failed to initialize.\n");
+    return e;
+  }
+
+  int quiet = 1000;
+  int opt = 0;
+  while ((opt = getopt(argc, argv, "q:h?")) != -1) {
+    switch (opt) {
+     case 'q':
+       quiet = atoi(optarg);
+       break;
+     case 'h':
+       _usage(stdout, EXIT_SUCCESS);
+     case '?':
+     default:
+       _usage(stderr, EXIT_FAILURE);
+    }
+  }
+
+  argc -= optind;
+  argv += optind;
+
+  int n = 1000;
+  switch (argc) {
+   case 0:
+     break;
+   default:
+     _usage(stderr, EXIT_FAILURE);
+   case 1:
+     n = atoi(argv[0]);
+     break;
+  }
+
+  e = hpx_run(&_main, NULL, &n, &quiet);
+  hpx_finalize();
+  return e;
+}
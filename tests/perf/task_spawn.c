@@ -0,0 +1,116 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+/// Measure the throughput of fine-grained local spawns.
+///
+/// Each iteration spawns a batch of empty leaf actions that set an and LCO, and
+/// waits for the batch to complete. The same leaf is registered both as an
+/// HPX_DEFAULT action, which runs as a lightweight thread with its own stack,
+/// and as an HPX_TASK action, which can run to completion on the worker's
+/// system stack.
+
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <hpx/hpx.h>
+
+#define BENCHMARK "HPX COST OF SPAWNING LEAF ACTIONS"
+
+#define HEADER "# " BENCHMARK "\n"
+#define FIELD_WIDTH 20
+
+static void _usage(FILE *f, int error) {
+  fprintf(f, "Usage: task_spawn [options] [ITERATIONS]\n"
+          "\t-n, number of spawns per iteration (10000)\n"
+          "\t-h, show help\n");
+  hpx_print_help();
+  fflush(f);
+  exit(error);
+}
+
+static int _leaf_handler(void) {
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _thread, _leaf_handler);
+static HPX_ACTION(HPX_TASK, 0, _task, _leaf_handler);
+
+static double _run(hpx_action_t leaf, int iters, int n) {
+  hpx_time_t start = hpx_time_now();
+  for (int i = 0; i < iters; ++i) {
+    hpx_addr_t done = hpx_lco_and_new(n);
+    for (int j = 0; j < n; ++j) {
+      hpx_call(HPX_HERE, leaf, done);
+    }
+    hpx_lco_wait(done);
+    hpx_lco_delete(done, HPX_NULL);
+  }
+  return hpx_time_elapsed_us(start) / ((double)iters * n);
+}
+
+static int _main_handler(int iters, int n) {
+  fprintf(stdout, HEADER);
+  fprintf(stdout, "# %d iterations of %d spawns\n", iters, n);
+  fprintf(stdout, "%-*s%*s\n", FIELD_WIDTH, "# type", FIELD_WIDTH,
+          "per spawn (us)");
+
+  // warm up the stack cache and the parcel allocator
+  _run(_thread, 1, n);
+
+  fprintf(stdout, "%-*s%*.4f\n", FIELD_WIDTH, "HPX_DEFAULT", FIELD_WIDTH,
+          _run(_thread, iters, n));
+  fprintf(stdout, "%-*s%*.4f\n", FIELD_WIDTH, "HPX_TASK", FIELD_WIDTH,
+          _run(_task, iters, n));
+  hpx_exit(0, NULL);
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _main, _main_handler, HPX_INT, HPX_INT);
+
+int main(int argc, char *argv[]) {
+  int e = hpx_init(&argc, &argv);
+  if (e) {
+    fprintf(stderr, "HPX: failed to initialize.\n");
+    return e;
+  }
+
+  int n = 10000;
+  int opt = 0;
+  while ((opt = getopt(argc, argv, "n:h?")) != -1) {
+    switch (opt) {
+     case 'n':
+       n = atoi(optarg);
+       break;
+     case 'h':
+       _usage(stdout, EXIT_SUCCESS);
+     case '?':
+     default:
+       _usage(stderr, EXIT_FAILURE);
+    }
+  }
+
+  argc -= optind;
+  argv += optind;
+
+  int iters = 100;
+  switch (argc) {
+   case 0:
+     break;
+   default:
+     _usage(stderr, EXIT_FAILURE);
+   case 1:
+     iters = atoi(argv[0]);
+     break;
+  }
+
+  e = hpx_run(&_main, NULL, &iters, &n);
+  hpx_finalize();
+  return e;
+}
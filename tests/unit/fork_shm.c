@@ -0,0 +1,113 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+/// Run two forked localities over the default network, which is the SHM
+/// network for the fork bootstrap. The rings are small so that large parcels
+/// and memget and memput take the rendezvous (or fragmented) paths.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <hpx/hpx.h>
+#include "tests.h"
+
+/// The largest transfer, which spans many ring fragments.
+enum { MAX_BYTES = 1 << 20 };
+
+static void _fill(unsigned char *buffer, size_t n, unsigned seed) {
+  for (size_t i = 0; i < n; ++i) {
+    buffer[i] = (unsigned char)rand_r(&seed);
+  }
+}
+
+static void _verify(const unsigned char *buffer, size_t n, unsigned seed) {
+  for (size_t i = 0; i < n; ++i) {
+    if (buffer[i] != (unsigned char)rand_r(&seed)) {
+      fprintf(stderr, "data corruption at offset %zu of %zu\n", i, n);
+      exit(EXIT_FAILURE);
+    }
+  }
+}
+
+static int _echo_handler(void *args, size_t n) {
+  return hpx_thread_continue(args, n);
+}
+static HPX_ACTION(HPX_DEFAULT, HPX_MARSHALLED, _echo, _echo_handler,
+                  HPX_POINTER, HPX_SIZE_T);
+
+static int _test_parcels_handler(void) {
+  test_assert(HPX_LOCALITIES == 2);
+  int peer = (HPX_LOCALITY_ID + 1) % HPX_LOCALITIES;
+  unsigned char *send = malloc(MAX_BYTES);
+  unsigned char *recv = malloc(MAX_BYTES);
+  for (size_t n = 1; n <= MAX_BYTES; n *= 4) {
+    printf("echoing %zu bytes through %d\n", n, peer);
+    _fill(send, n, (unsigned)n);
+    memset(recv, 0, n);
+    CHECK( hpx_call_sync(HPX_THERE(peer), _echo, recv, n, send, n) );
+    _verify(recv, n, (unsigned)n);
+  }
+  free(send);
+  free(recv);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _test_parcels, _test_parcels_handler);
+
+static int _test_memget_memput_handler(void) {
+  int peer = (HPX_LOCALITY_ID + 1) % HPX_LOCALITIES;
+  hpx_addr_t data = hpx_gas_alloc_local_at_sync(1, MAX_BYTES, 0,
+                                                HPX_THERE(peer));
+  test_assert(data != HPX_NULL);
+
+  unsigned char *buffer = malloc(MAX_BYTES);
+  _fill(buffer, MAX_BYTES, 42);
+  CHECK( hpx_gas_memput_rsync(data, buffer, MAX_BYTES) );
+  memset(buffer, 0, MAX_BYTES);
+  CHECK( hpx_gas_memget_sync(buffer, data, MAX_BYTES) );
+  _verify(buffer, MAX_BYTES, 42);
+
+  free(buffer);
+  hpx_gas_free_sync(data);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _test_memget_memput,
+                  _test_memget_memput_handler);
+
+static int _main_handler(void) {
+  ADD_TEST(_test_parcels, 0);
+  ADD_TEST(_test_parcels, 1);
+  ADD_TEST(_test_memget_memput, 0);
+  hpx_exit(0, NULL);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _main, _main_handler);
+
+int main(int argc, char *argv[]) {
+  // Insert the bootstrap options after the program name.
+  char *args[argc + 4];
+  args[0] = argv[0];
+  args[1] = "--hpx-boot=fork";
+  args[2] = "--hpx-boot-ranks=2";
+  args[3] = "--hpx-shm-ringsize=65536";
+  memcpy(&args[4], &argv[1], argc * sizeof(*argv));
+  int n = argc + 3;
+  char **v = args;
+
+  if (hpx_init(&n, &v)) {
+    fprintf(stderr, "failed to initialize HPX.\n");
+    return 1;
+  }
+  int e = hpx_run(&_main, NULL);
+  hpx_finalize();
+  return e;
+}
@@ -0,0 +1,68 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#include <hpx/hpx.h>
+#include <libhpx/libhpx.h>
+#include "tests.h"
+
+/// The number of normal threads queued ahead of the priority thread.
+enum { QUEUED = 64 };
+
+static volatile int _next = 0;
+static volatile int _priority = -1;
+
+static int _normal_handler(void) {
+  __sync_fetch_and_add(&_next, 1);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _normal, _normal_handler);
+
+static int _urgent_handler(void) {
+  _priority = __sync_fetch_and_add(&_next, 1);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, HPX_PRIORITY, _urgent, _urgent_handler);
+
+static int _test_priority_handler(void) {
+  // Run on a single worker so that the order in which the queued threads run
+  // is deterministic.
+  int n = hpx_get_num_threads();
+  hpx_set_num_active_threads(1);
+  while (hpx_get_num_active_threads() != 1 || HPX_THREAD_ID != 0) {
+    hpx_thread_yield();
+  }
+
+  // The spawns are queued behind us, because the queue is shorter than the
+  // work-first threshold.
+  test_assert(QUEUED < libhpx_get_config()->sched_wfthreshold);
+  _next = 0;
+  _priority = -1;
+  hpx_addr_t and = hpx_lco_and_new(QUEUED + 1);
+  for (int i = 0; i < QUEUED; ++i) {
+    CHECK( hpx_call(HPX_HERE, _normal, and) );
+  }
+  CHECK( hpx_call(HPX_HERE, _urgent, and) );
+  CHECK( hpx_lco_wait(and) );
+  hpx_lco_delete_sync(and);
+
+  printf("priority thread ran %d of %d\n", _priority, QUEUED + 1);
+  test_assert(_priority == 0);
+
+  hpx_set_num_active_threads(n);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _test_priority, _test_priority_handler);
+
+TEST_MAIN({
+  ADD_TEST(_test_priority, 0);
+});
@@ -0,0 +1,103 @@
+// =============================================================================
+//  High Performance ParalleX Library (libhpx)
+//
+//  Copyright (c) 2013-2017, Trustees of Indiana University,
+//  All rights reserved.
+//
+//  This software may be modified and distributed under the terms of the BSD
+//  license.  See the COPYING file for details.
+//
+//  This software was created at the Indiana University Center for Research in
+//  Extreme Scale Technologies (CREST).
+// =============================================================================
+
+#include <hpx/hpx.h>
+#include <libhpx/libhpx.h>
+#include "tests.h"
+
+/// The number of lightweight threads that keep the workers busy.
+enum { LOAD = 4096 };
+
+static volatile int _done = 0;
+
+/// Yield until the requested number of worker threads are running.
+static void _wait_for_active(int n) {
+  while (hpx_get_num_active_threads() != n) {
+    hpx_thread_yield();
+  }
+}
+
+static int _work_handler(void) {
+  volatile unsigned x = 0;
+  for (int i = 0; i < 8; ++i) {
+    for (int j = 0; j < 1000; ++j) {
+      x += j;
+    }
+    hpx_thread_yield();
+  }
+  __sync_fetch_and_add(&_done, 1);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _work, _work_handler);
+
+static int _test_clamp_handler(void) {
+  int n = hpx_get_num_threads();
+  test_assert(0 < n);
+  test_assert(hpx_get_num_active_threads() <= n);
+  test_assert(hpx_set_num_active_threads(0) == 1);
+  test_assert(hpx_set_num_active_threads(-5) == 1);
+  test_assert(hpx_set_num_active_threads(n + 10) == n);
+  if (!libhpx_get_config()->sched_elastic) {
+    _wait_for_active(n);
+  }
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _test_clamp, _test_clamp_handler);
+
+static int _test_shrink_regrow_handler(void) {
+  // The elastic policy treats the limit as an upper bound, so we can't wait
+  // for an exact number of running workers.
+  if (libhpx_get_config()->sched_elastic) {
+    printf("skipping the shrink and regrow test with --hpx-sched-elastic\n");
+    return HPX_SUCCESS;
+  }
+
+  int n = hpx_get_num_threads();
+  _done = 0;
+
+  hpx_addr_t and = hpx_lco_and_new(LOAD);
+  for (int i = 0; i < LOAD; ++i) {
+    CHECK( hpx_call(HPX_HERE, _work, and) );
+  }
+
+  // Shrink to one worker while the load is running, and make sure that the
+  // stopped workers' threads migrate to the one that is left.
+  printf("shrinking from %d to 1 active threads\n", n);
+  test_assert(hpx_set_num_active_threads(1) == 1);
+  _wait_for_active(1);
+  while (HPX_THREAD_ID != 0) {
+    hpx_thread_yield();
+  }
+
+  // Then regrow in two steps.
+  int half = (n + 1) / 2;
+  printf("growing to %d active threads\n", half);
+  test_assert(hpx_set_num_active_threads(half) == half);
+  _wait_for_active(half);
+
+  printf("growing to %d active threads\n", n);
+  test_assert(hpx_set_num_active_threads(n) == n);
+  _wait_for_active(n);
+
+  CHECK( hpx_lco_wait(and) );
+  hpx_lco_delete_sync(and);
+  test_assert(_done == LOAD);
+  return HPX_SUCCESS;
+}
+static HPX_ACTION(HPX_DEFAULT, 0, _test_shrink_regrow,
+                  _test_shrink_regrow_handler);
+
+TEST_MAIN({
+  ADD_TEST(_test_clamp, 0);
+  ADD_TEST(_test_shrink_regrow, 0);
+});